@@ -0,0 +1,32 @@
+#include "AllocationCounter.h"
+
+#include <cstdlib>
+#include <new>
+#include <atomic>
+
+// Worlds of the server are stepped on several threads at once
+static std::atomic<unsigned long> s_allocations(0);
+
+unsigned long AllocationCount()
+{
+    return s_allocations;
+}
+
+void* operator new(std::size_t size)
+{
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size ? size : 1);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
@@ -0,0 +1,13 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+/*
+ *  Counts heap allocations of the headless runner, so the steps of the game
+ *  can be checked to not allocate once the pools and buffers of the managers
+ *  are warmed up.
+ */
+
+/** \brief Gives number of calls to operator new since the start */
+unsigned long AllocationCount();
+
+#endif // ALLOCATIONCOUNTER_H
@@ -0,0 +1,122 @@
+#include "ContactBenchmark.h"
+#include "Utility/Contact.h"
+#include "Constants/WindowConstants.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static volatile unsigned int g_sink;
+
+// One point of a corner inside of the object, as Enemy::Touch() was
+static bool Inside(unsigned int x, unsigned int y, unsigned int w, unsigned int h, unsigned int px, unsigned int py)
+{
+    return px >= x && px <= x + w && py >= y && py <= y + h;
+}
+
+static unsigned int LoopCorners(const Contact::Box& box, const unsigned int* x, const unsigned int* y,
+                                unsigned int w, unsigned int h, unsigned int n, uint32_t*)
+{
+    unsigned int hits = 0;
+    for (unsigned int i = 0; i < n; ++i)
+        if (Inside(x[i], y[i], w, h, box.left, box.top) || Inside(x[i], y[i], w, h, box.right, box.top) ||
+            Inside(x[i], y[i], w, h, box.left, box.bottom) || Inside(x[i], y[i], w, h, box.right, box.bottom))
+            ++hits;
+    return hits;
+}
+
+static unsigned int LoopPoints(const Contact::Box& box, const unsigned int* x, const unsigned int* y,
+                               unsigned int, unsigned int, unsigned int n, uint32_t*)
+{
+    unsigned int hits = 0;
+    for (unsigned int i = 0; i < n; ++i)
+        if (x[i] >= box.left && y[i] >= box.top && x[i] <= box.right && y[i] <= box.bottom)
+            ++hits;
+    return hits;
+}
+
+static unsigned int KernelCorners(const Contact::Box& box, const unsigned int* x, const unsigned int* y,
+                                  unsigned int w, unsigned int h, unsigned int n, uint32_t* mask)
+{
+    return Contact::Corners(box, x, y, w, h, n, mask);
+}
+
+static unsigned int ScalarCorners(const Contact::Box& box, const unsigned int* x, const unsigned int* y,
+                                  unsigned int w, unsigned int h, unsigned int n, uint32_t* mask)
+{
+    return Contact::CornersScalar(box, x, y, w, h, n, mask);
+}
+
+static unsigned int KernelPoints(const Contact::Box& box, const unsigned int* x, const unsigned int* y,
+                                 unsigned int, unsigned int, unsigned int n, uint32_t* mask)
+{
+    return Contact::Points(box, x, y, n, mask);
+}
+
+static unsigned int ScalarPoints(const Contact::Box& box, const unsigned int* x, const unsigned int* y,
+                                 unsigned int, unsigned int, unsigned int n, uint32_t* mask)
+{
+    return Contact::PointsScalar(box, x, y, n, mask);
+}
+
+typedef unsigned int (*Test)(const Contact::Box&, const unsigned int*, const unsigned int*,
+                             unsigned int, unsigned int, unsigned int, uint32_t*);
+
+// Gives millions of objects tested per second
+static double Measure(Test test, const std::vector<Contact::Box>& boxes, const std::vector<unsigned int>& x,
+                      const std::vector<unsigned int>& y, unsigned int w, unsigned int h, unsigned int n,
+                      std::vector<uint32_t>& mask)
+{
+    // Every measurement tests about 50 million objects
+    unsigned long repeats = 50000000ul / n;
+    unsigned int sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long r = 0; r < repeats; ++r)
+        sink += test(boxes[r % boxes.size()], x.data(), y.data(), w, h, n, mask.data());
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    g_sink = sink;
+    return repeats * n / seconds / 1e6;
+}
+
+void RunContactBenchmark()
+{
+    const unsigned int tile = MAP_TILE_SIZE;
+    const unsigned int size = tile * 3/4;
+    const unsigned int counts[] = {10, 100, 1000, 10000};
+
+    // Objects and boxes are spread over a map of 31x13 tiles
+    srand(1);
+    std::vector<Contact::Box> boxes(64);
+    for (auto i = boxes.begin(); i != boxes.end(); ++i)
+    {
+        i->left = rand() % (31*tile);
+        i->top = rand() % (13*tile);
+        i->right = i->left + size;
+        i->bottom = i->top + size;
+    }
+
+    printf("contact tests with %s, millions of objects per second\n", Contact::GetPath());
+    printf("%8s %12s %12s %12s %12s %12s %12s\n", "objects", "corner loop", "scalar", "vector",
+           "point loop", "scalar", "vector");
+    for (unsigned int c = 0; c < sizeof(counts)/sizeof(counts[0]); ++c)
+    {
+        unsigned int n = counts[c];
+        std::vector<unsigned int> x(n);
+        std::vector<unsigned int> y(n);
+        std::vector<uint32_t> mask(Contact::MaskWords(n));
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            x[i] = rand() % (31*tile);
+            y[i] = rand() % (13*tile);
+        }
+
+        printf("%8u %12.0f %12.0f %12.0f %12.0f %12.0f %12.0f\n", n,
+               Measure(LoopCorners, boxes, x, y, size, size, n, mask),
+               Measure(ScalarCorners, boxes, x, y, size, size, n, mask),
+               Measure(KernelCorners, boxes, x, y, size, size, n, mask),
+               Measure(LoopPoints, boxes, x, y, 0, 0, n, mask),
+               Measure(ScalarPoints, boxes, x, y, 0, 0, n, mask),
+               Measure(KernelPoints, boxes, x, y, 0, 0, n, mask));
+    }
+}
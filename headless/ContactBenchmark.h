@@ -0,0 +1,11 @@
+#ifndef CONTACTBENCHMARK_H
+#define CONTACTBENCHMARK_H
+
+/*
+ *  Measures how many objects per second Contact tests against one box, next
+ *  to the scalar loop of one test per object the entities used before.
+ */
+
+void RunContactBenchmark();
+
+#endif // CONTACTBENCHMARK_H
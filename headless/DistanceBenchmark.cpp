@@ -0,0 +1,102 @@
+#include "DistanceBenchmark.h"
+#include "Manager/Map.h"
+#include "Manager/PickUpManager.h"
+#include "Utility/DistanceField.h"
+#include "Utility/Relay.h"
+#include "Constants/WindowConstants.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+static const unsigned int ARENA_SIZE = 200;
+static const unsigned int ARENA_GOALS = 4;
+static const unsigned int ARENA_WALLS_PER_UPDATE = 1; // dozens of walls per second at 100 updates per second
+static const unsigned int ARENA_UPDATES = 2000;
+static const char* ARENA_PATH = "bench-distance-arena.txt";
+
+// Indestructible border and pillars on even tiles, every other tile is a
+// destructible wall with some chance
+static void WriteArena(std::vector<unsigned int>& walls)
+{
+    std::ofstream fs(ARENA_PATH);
+    fs << ARENA_SIZE << " " << ARENA_SIZE << "\n";
+    for (unsigned int i = 0; i < ARENA_SIZE; ++i)
+    {
+        for (unsigned int j = 0; j < ARENA_SIZE; ++j)
+        {
+            int id = 0;
+            if (i == 0 || j == 0 || i == ARENA_SIZE - 1 || j == ARENA_SIZE - 1 || (i % 2 == 0 && j % 2 == 0))
+                id = 2;
+            else if (rand() % 100 < 20)
+            {
+                id = 1;
+                walls.push_back(i*ARENA_SIZE + j);
+            }
+            fs << id << " ";
+        }
+        fs << "\n";
+    }
+}
+
+void RunDistanceBenchmark()
+{
+    srand(1);
+    std::vector<unsigned int> walls;
+    WriteArena(walls);
+
+    Relay relay;
+    Map map(ARENA_PATH, nullptr, MAP_TILE_SIZE, &relay, Random(1));
+    PickUpManager pickups(nullptr, MAP_TILE_SIZE, ARENA_SIZE*ARENA_SIZE, &relay);
+    relay.SetMap(&map);
+    relay.SetPickUpManager(&pickups);
+    remove(ARENA_PATH);
+
+    std::vector<unsigned int> goals;
+    while (goals.size() < ARENA_GOALS)
+    {
+        unsigned int tile = rand() % (ARENA_SIZE*ARENA_SIZE);
+        if (map.Walkable(tile / ARENA_SIZE, tile % ARENA_SIZE))
+            goals.push_back(tile);
+    }
+    std::sort(goals.begin(), goals.end());
+
+    DistanceField repaired(ARENA_SIZE, ARENA_SIZE);
+    DistanceField searched(ARENA_SIZE, ARENA_SIZE);
+    repaired.Update(map, goals);
+
+    double repair_seconds = 0;
+    double search_seconds = 0;
+    unsigned long mismatches = 0;
+    for (unsigned int update = 0; update < ARENA_UPDATES && !walls.empty(); ++update)
+    {
+        for (unsigned int k = 0; k < ARENA_WALLS_PER_UPDATE && !walls.empty(); ++k)
+        {
+            unsigned int w = rand() % walls.size();
+            map.DestroyWall(walls[w] / ARENA_SIZE, walls[w] % ARENA_SIZE, 100);
+            walls[w] = walls.back();
+            walls.pop_back();
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        repaired.Update(map, goals);
+        auto middle = std::chrono::steady_clock::now();
+        searched.Search(map, goals);
+        auto end = std::chrono::steady_clock::now();
+        repair_seconds += std::chrono::duration<double>(middle - start).count();
+        search_seconds += std::chrono::duration<double>(end - middle).count();
+
+        for (unsigned int i = 0; i < ARENA_SIZE; ++i)
+            for (unsigned int j = 0; j < ARENA_SIZE; ++j)
+                mismatches += repaired.GetDistance(i, j) != searched.GetDistance(i, j);
+    }
+
+    printf("distance field on a %ux%u arena, %u walls destroyed per update, %u updates\n",
+           ARENA_SIZE, ARENA_SIZE, ARENA_WALLS_PER_UPDATE, ARENA_UPDATES);
+    printf("repair: %8.2f us per update\n", repair_seconds * 1e6 / ARENA_UPDATES);
+    printf("search: %8.2f us per update\n", search_seconds * 1e6 / ARENA_UPDATES);
+    printf("%lu distances differ from the full search\n", mismatches);
+}
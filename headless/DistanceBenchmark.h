@@ -0,0 +1,11 @@
+#ifndef DISTANCEBENCHMARK_H
+#define DISTANCEBENCHMARK_H
+
+/*
+ *  Measures how long DistanceField takes to follow walls being destroyed on a
+ *  large arena, repairing the field next to searching the whole map again.
+ */
+
+void RunDistanceBenchmark();
+
+#endif // DISTANCEBENCHMARK_H
@@ -0,0 +1,131 @@
+#include "EnemyBenchmark.h"
+#include "AllocationCounter.h"
+#include "Manager/Map.h"
+#include "Manager/ExplosionManager.h"
+#include "Manager/BombManager.h"
+#include "Manager/PlayerManager.h"
+#include "Manager/EnemyManager.h"
+#include "Manager/PickUpManager.h"
+#include "System/SystemTimer.h"
+#include "Utility/Relay.h"
+#include "Utility/StateBuffer.h"
+#include "Utility/ThreadPool.h"
+#include "Constants/WindowConstants.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+
+static const unsigned int HORDE_ARENA_SIZE = 128;
+static const unsigned int HORDE_ENEMIES = 8000;
+static const unsigned int HORDE_STEPS = 2000;
+static const char* HORDE_MAP_PATH = "bench-enemies-arena.txt";
+static const char* HORDE_PLAYER_PATH = "bench-enemies-players.txt";
+static const char* HORDE_ENEMY_PATH = "bench-enemies-horde.txt";
+
+// Indestructible border and pillars on even tiles, all kinds of enemies on
+// the free tiles away from the players in the middle
+static void WriteHorde()
+{
+    std::ofstream map(HORDE_MAP_PATH);
+    map << HORDE_ARENA_SIZE << " " << HORDE_ARENA_SIZE << "\n";
+    for (unsigned int i = 0; i < HORDE_ARENA_SIZE; ++i)
+    {
+        for (unsigned int j = 0; j < HORDE_ARENA_SIZE; ++j)
+        {
+            bool wall = i == 0 || j == 0 || i == HORDE_ARENA_SIZE - 1 || j == HORDE_ARENA_SIZE - 1 || (i % 2 == 0 && j % 2 == 0);
+            map << (wall ? 2 : 0) << " ";
+        }
+        map << "\n";
+    }
+
+    unsigned int middle = HORDE_ARENA_SIZE / 2 + 1;
+    std::ofstream players(HORDE_PLAYER_PATH);
+    players << "2\n0 " << middle << " " << middle << "\n1 " << middle + 2 << " " << middle << "\n";
+
+    std::ofstream enemies(HORDE_ENEMY_PATH);
+    enemies << HORDE_ENEMIES << "\n";
+    srand(1);
+    for (unsigned int k = 0; k < HORDE_ENEMIES; ++k)
+    {
+        unsigned int x, y;
+        do
+        {
+            x = 1 + rand() % (HORDE_ARENA_SIZE - 2);
+            y = 1 + rand() % (HORDE_ARENA_SIZE - 2);
+        } while ((x % 2 == 0 && y % 2 == 0) || (x + 4 > middle && x < middle + 6 && y + 4 > middle && y < middle + 4));
+        enemies << 1 + k % 3 << " " << x << " " << y << "\n";
+    }
+}
+
+// Steps only the enemies of a fresh horde, gives the seconds taken and the
+// checksum of the enemies after the last step
+static double MeasureHorde(ThreadPool* pool, uint32_t& checksum, unsigned long& allocations)
+{
+    SystemTimer timer;
+    Relay relay;
+    relay.SetSystemTimer(&timer);
+    relay.SetThreadPool(pool);
+    Map map(HORDE_MAP_PATH, nullptr, MAP_TILE_SIZE, &relay, Random(1));
+    relay.SetMap(&map);
+    ExplosionManager explosions(nullptr, MAP_TILE_SIZE, &relay);
+    BombManager bombs(nullptr, MAP_TILE_SIZE, &relay);
+    PlayerManager players(HORDE_PLAYER_PATH, nullptr, MAP_TILE_SIZE, &relay, 2);
+    EnemyManager enemies(HORDE_ENEMY_PATH, nullptr, MAP_TILE_SIZE, &relay, Random(1));
+    PickUpManager pickups(nullptr, MAP_TILE_SIZE, HORDE_ARENA_SIZE*HORDE_ARENA_SIZE, &relay);
+    relay.SetExplosionManager(&explosions);
+    relay.SetBombManager(&bombs);
+    relay.SetPlayerManager(&players);
+    relay.SetEnemyManager(&enemies);
+    relay.SetPickUpManager(&pickups);
+
+    // The first step makes the memory of the update
+    timer.Step();
+    enemies.Update();
+
+    unsigned long allocated = AllocationCount();
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int step = 1; step < HORDE_STEPS; ++step)
+    {
+        timer.Step();
+        enemies.Update();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    allocations = AllocationCount() - allocated;
+
+    StateBuffer state;
+    enemies.SaveState(state);
+    checksum = state.Checksum();
+    return seconds;
+}
+
+void RunEnemyBenchmark(unsigned int threads)
+{
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+    if (threads == 0)
+        threads = 1;
+
+    WriteHorde();
+    printf("%u enemies on a %ux%u arena with 2 players, %u steps\n",
+           HORDE_ENEMIES, HORDE_ARENA_SIZE, HORDE_ARENA_SIZE, HORDE_STEPS);
+
+    uint32_t serial_checksum = 0;
+    unsigned long allocations = 0;
+    double serial = MeasureHorde(nullptr, serial_checksum, allocations);
+    printf("serial:     %8.2f us per step, %lu heap allocations\n", serial * 1e6 / HORDE_STEPS, allocations);
+
+    ThreadPool pool(threads);
+    uint32_t pooled_checksum = 0;
+    double pooled = MeasureHorde(&pool, pooled_checksum, allocations);
+    printf("%2u threads: %8.2f us per step, %.2fx, %lu heap allocations\n",
+           pool.GetThreads(), pooled * 1e6 / HORDE_STEPS, pooled > 0 ? serial / pooled : 0.0, allocations);
+    printf("enemies %s after the serial and the threaded update\n",
+           serial_checksum == pooled_checksum ? "are the same" : "DIFFER");
+
+    remove(HORDE_MAP_PATH);
+    remove(HORDE_PLAYER_PATH);
+    remove(HORDE_ENEMY_PATH);
+}
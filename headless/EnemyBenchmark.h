@@ -0,0 +1,12 @@
+#ifndef ENEMYBENCHMARK_H
+#define ENEMYBENCHMARK_H
+
+/*
+ *  Walks a horde of enemies over a large arena with two players and
+ *  measures how long their update takes on one thread and on the given
+ *  number of threads, checking that both end in the same state.
+ */
+
+void RunEnemyBenchmark(unsigned int threads);
+
+#endif // ENEMYBENCHMARK_H
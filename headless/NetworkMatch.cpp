@@ -0,0 +1,124 @@
+#include "NetworkMatch.h"
+#include "Network/RollbackSession.h"
+#include "Network/UdpSocket.h"
+#include "Simulation/World.h"
+#include "Simulation/ScriptedInput.h"
+#include "System/SystemTimer.h"
+#include "Utility/Random.h"
+#include "Utility/StateBuffer.h"
+#include "Constants/WindowConstants.h"
+#include "Constants/SimulationConstants.h"
+#include "Constants/NetworkConstants.h"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+static const unsigned int MATCH_HOLD = 20; // steps the random buttons are held
+static const double MATCH_CONNECT_SECONDS = 10;
+static const double MATCH_LINGER_SECONDS = 1; // packets still answered after the end
+
+// Up, down, left, right or nothing, and a bomb now and then, drawn
+// differently for the two players
+static uint8_t Buttons(unsigned int player, long step)
+{
+    Random random(step / MATCH_HOLD, 2 + player);
+    unsigned int direction = random.Below(5);
+    uint8_t buttons = direction < 4 ? 1 << direction : 0;
+    if (random.Below(3) == 0 && step % MATCH_HOLD == 0)
+        buttons |= 1 << 4;
+    return buttons;
+}
+
+int RunNetworkMatch(const NetworkOptions& options, unsigned long max_steps)
+{
+    UdpSocket socket;
+    if (!socket.Open(options.local_port, options.peer_host, options.peer_port))
+    {
+        printf("Could not open port %u towards %s:%u\n", options.local_port,
+               options.peer_host.c_str(), options.peer_port);
+        return -1;
+    }
+    socket.SetLatency(options.latency, options.jitter, options.loss, options.seed * 2 + options.local_player);
+
+    SystemTimer* system_timer = SystemTimer::Instance();
+    system_timer->SetSteps(0);
+    ScriptedInput input;
+    World world(nullptr, MAP_TILE_SIZE, 2, options.level, &input, options.seed);
+    RollbackSession session(&world, &input, options.local_player, options.level, &socket);
+
+    const std::chrono::duration<double> step_length(SIMULATION_STEP_LENGTH / 1000.0);
+    auto start = std::chrono::steady_clock::now();
+    auto last = start;
+    std::chrono::duration<double> accumulator(0);
+    double slowest_frame = 0;
+    unsigned long frames = 0;
+
+    while (true)
+    {
+        auto now = std::chrono::steady_clock::now();
+        accumulator += now - last;
+        last = now;
+        if (accumulator > step_length * SIMULATION_MAX_STEPS_PER_FRAME)
+            accumulator = step_length * SIMULATION_MAX_STEPS_PER_FRAME;
+
+        // The steps of one frame, rollbacks included, are timed together
+        bool stepped = false;
+        while (accumulator >= step_length)
+        {
+            accumulator -= step_length;
+            if ((unsigned long)session.GetStep() < max_steps)
+            {
+                system_timer->Step();
+                session.Advance(Buttons(options.local_player, session.GetStep()));
+            }
+            else
+                session.Poll();
+            stepped = true;
+        }
+        if (stepped && session.Connected())
+        {
+            double frame_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - now).count();
+            if (frame_time > slowest_frame)
+                slowest_frame = frame_time;
+            ++frames;
+        }
+
+        if (session.Confirmed() && ((unsigned long)session.GetStep() >= max_steps ||
+                                    world.PlayersDead() || world.LevelCompleted()))
+            break;
+        if (!session.Connected() &&
+            std::chrono::duration<double>(now - start).count() > MATCH_CONNECT_SECONDS)
+        {
+            printf("No packets from %s:%u\n", options.peer_host.c_str(), options.peer_port);
+            return -1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    session.Finish();
+    auto end = std::chrono::steady_clock::now();
+    while (std::chrono::duration<double>(std::chrono::steady_clock::now() - end).count() < MATCH_LINGER_SECONDS)
+    {
+        session.Poll();
+        std::this_thread::sleep_for(std::chrono::milliseconds(SIMULATION_STEP_LENGTH));
+    }
+
+    StateBuffer state;
+    world.SaveState(state);
+
+    printf("player %u of level %u from seed %llu, %ld steps in %lu frames\n", options.local_player,
+           options.level, (unsigned long long)options.seed, session.GetStep(), frames);
+    printf("latency %u ms, jitter %u ms, loss %u%% per direction, input delay %u ms\n",
+           options.latency, options.jitter, options.loss, NETWORK_INPUT_DELAY * SIMULATION_STEP_LENGTH);
+    printf("%lu rollbacks played %lu steps again (%.1f per rollback, at most %u)\n",
+           session.GetRollbacks(), session.GetRolledBackSteps(),
+           session.GetRollbacks() > 0 ? (double)session.GetRolledBackSteps() / session.GetRollbacks() : 0.0,
+           session.GetLongestRollback());
+    printf("%lu steps skipped waiting for the peer, slowest frame took %.1f us\n",
+           session.GetSkippedSteps(), slowest_frame * 1e6);
+    printf("%lu of %lu checksums compared with the peer differed\n",
+           session.GetDesyncs(), session.GetComparedChecksums());
+    printf("state after step %ld has checksum %08x\n", session.GetStep(), state.Checksum());
+    return session.GetDesyncs() > 0 ? 1 : 0;
+}
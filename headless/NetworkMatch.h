@@ -0,0 +1,16 @@
+#ifndef NETWORKMATCH_H
+#define NETWORKMATCH_H
+
+#include "Network/NetworkOptions.h"
+
+/*
+ *  Plays a two player level against a peer process over UDP in real time,
+ *  with random buttons for the local player, and reports how often and how
+ *  far the game was rolled back, how long the slowest frame took and whether
+ *  the checksums of the two games ever differed. Two processes on one
+ *  machine, each with a --latency, play as over a slow network.
+ */
+
+int RunNetworkMatch(const NetworkOptions& options, unsigned long max_steps);
+
+#endif // NETWORKMATCH_H
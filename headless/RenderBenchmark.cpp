@@ -0,0 +1,111 @@
+#include "RenderBenchmark.h"
+#include "AllocationCounter.h"
+#include "Simulation/World.h"
+#include "Simulation/ScriptedInput.h"
+#include "Display/RenderSnapshot.h"
+#include "Display/SpriteBatch.h"
+#include "Display/Camera.h"
+#include "Utility/Random.h"
+#include "Constants/WindowConstants.h"
+#include "Constants/SimulationConstants.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+static const unsigned long RENDER_STEPS = 20000;
+static const unsigned int RENDER_HOLD = 20; // steps the random buttons are held
+
+// Up, down, left, right or nothing and a bomb now and then for the first player
+static void Press(KeyboardInput* input, const std::vector<SDL_Keycode>& keys, unsigned long step)
+{
+    Random random(step / RENDER_HOLD, 2);
+    unsigned int direction = random.Below(5);
+    bool bomb = random.Below(3) == 0 && step % RENDER_HOLD == 0;
+    for (unsigned int k = 0; k < 5 && k < keys.size(); ++k)
+    {
+        bool on = k == direction || (k == 4 && bomb);
+        if (!on && input->IsKeyOn(keys[k]))
+            input->TurnKeyOff(keys[k]);
+        else if (on && !input->IsKeyOn(keys[k]))
+            input->TurnKeyOn(keys[k]);
+    }
+}
+
+void RunRenderBenchmark(unsigned int level)
+{
+    ScriptedInput input;
+    SystemTimer timer;
+    RenderSnapshot snapshot;
+    RenderSnapshot whole; // without a view, as every sprite was drawn before
+    SpriteBatch batch;
+
+    double take_seconds = 0;
+    double build_seconds = 0;
+    unsigned long frames = 0;
+    unsigned long sprites = 0;
+    unsigned long all_sprites = 0;
+    unsigned long calls = 0;
+    unsigned long tiles = 0;
+    unsigned long layer_tiles = 0;
+    unsigned long allocations = 0;
+    unsigned int worlds = 0;
+
+    unsigned long total = 0;
+    while (total < RENDER_STEPS)
+    {
+        timer.SetSteps(0);
+        World* world = new World(nullptr, MAP_TILE_SIZE, 1, level, &input, worlds + 1, &timer);
+        ++worlds;
+        std::vector<SDL_Keycode> keys;
+        world->GetInputKeys(keys);
+        unsigned long layer_revision = 0; // as if the drawing thread took every snapshot
+        Camera camera(WINDOW_WIDTH, WINDOW_HEIGHT);
+
+        for (unsigned long step = 0; total < RENDER_STEPS && !world->PlayersDead() && !world->LevelCompleted(); ++step)
+        {
+            Press(&input, keys, step);
+            timer.Step();
+            world->Update();
+            ++total;
+
+            // Memory is made by the first world, later ones reuse it
+            unsigned long allocated = AllocationCount();
+            auto start = std::chrono::steady_clock::now();
+            snapshot.Clear(step * SIMULATION_STEP_LENGTH, layer_revision);
+            camera.Follow(world->GetRelay());
+            snapshot.SetView(camera.GetView(), camera.GetFromX(), camera.GetFromY());
+            world->Draw(snapshot);
+            layer_revision = snapshot.GetLayer().revision;
+            auto middle = std::chrono::steady_clock::now();
+            batch.Build(snapshot, step * SIMULATION_STEP_LENGTH + SIMULATION_STEP_LENGTH / 2);
+            auto end = std::chrono::steady_clock::now();
+            take_seconds += std::chrono::duration<double>(middle - start).count();
+            build_seconds += std::chrono::duration<double>(end - middle).count();
+            if (worlds > 1)
+                allocations += AllocationCount() - allocated;
+
+            whole.Clear(0, layer_revision);
+            world->Draw(whole);
+
+            ++frames;
+            sprites += batch.GetSprites();
+            all_sprites += whole.GetSprites().size() + whole.GetOverlay().size();
+            // The first snapshot of a world holds every tile
+            if (step > 0)
+                tiles += snapshot.GetTiles().size();
+            layer_tiles = snapshot.GetLayer().width * snapshot.GetLayer().height;
+            calls += batch.GetCalls();
+        }
+
+        delete world;
+    }
+
+    printf("level %u, %lu frames in %u worlds\n", level, frames, worlds);
+    printf("before: %7.1f SDL_RenderCopy calls per frame, %lu tiles and %.1f sprites of the whole World\n",
+           frames ? layer_tiles + (double)all_sprites / frames : 0.0, layer_tiles, frames ? (double)all_sprites / frames : 0.0);
+    printf("after:  %7.3f tiles drawn into the map layer and 1 copy of it, %.1f sprites in the view in %.1f SDL_RenderGeometry calls per frame\n",
+           frames ? (double)tiles / frames : 0.0, frames ? (double)sprites / frames : 0.0, frames ? (double)calls / frames : 0.0);
+    printf("snapshot: %.2f us, vertices: %.2f us per frame, %lu heap allocations after the first world\n",
+           frames ? take_seconds * 1e6 / frames : 0.0, frames ? build_seconds * 1e6 / frames : 0.0, allocations);
+}
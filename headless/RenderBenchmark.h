@@ -0,0 +1,17 @@
+#ifndef RENDERBENCHMARK_H
+#define RENDERBENCHMARK_H
+
+/*
+ *  Plays a level with random buttons, adds the World to a RenderSnapshot
+ *  after every step as the simulation thread of the game does and builds the
+ *  vertices of a SpriteBatch from it as the drawing thread does, with the
+ *  map kept in a layer of its own and the view following the players. Reports how many SDL_RenderCopy calls a
+ *  frame took when every tile and sprite was copied on its own, how many
+ *  tiles are drawn into the map layer and how many geometry calls the
+ *  sprites take now, and how long taking and building take. The calls
+ *  themselves need a renderer, so they are not timed here.
+ */
+
+void RunRenderBenchmark(unsigned int level);
+
+#endif // RENDERBENCHMARK_H
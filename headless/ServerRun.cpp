@@ -0,0 +1,376 @@
+#include "ServerRun.h"
+#include "AllocationCounter.h"
+#include "Server/MatchServer.h"
+#include "Network/SnapshotDelta.h"
+#include "Network/UdpSocket.h"
+#include "Utility/ThreadPool.h"
+#include "Utility/Random.h"
+#include "Utility/StateBuffer.h"
+#include "Constants/SimulationConstants.h"
+#include "Constants/NetworkConstants.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+static const unsigned int SERVER_HOLD = 20; // steps the random buttons are held
+static const unsigned long SERVER_REPORT_STEPS = 500; // steps between two reports of the server
+static const unsigned long BENCH_WARMUP_STEPS = 100;
+static const unsigned long BENCH_STEPS = 1000;
+static const double CLIENT_CONNECT_SECONDS = 10;
+
+// Up, down, left, right or nothing, and a bomb now and then, drawn
+// differently for every seat
+static uint8_t Buttons(unsigned long seat, long step)
+{
+    Random random(step / SERVER_HOLD, 2 + seat);
+    unsigned int direction = random.Below(5);
+    uint8_t buttons = direction < 4 ? 1 << direction : 0;
+    if (random.Below(3) == 0 && step % SERVER_HOLD == 0)
+        buttons |= 1 << 4;
+    return buttons;
+}
+
+int RunServer(unsigned short port, unsigned int matches, unsigned int threads,
+              unsigned int level, uint64_t seed, unsigned long max_steps)
+{
+    UdpSocket socket;
+    if (!socket.Open(port))
+    {
+        printf("Could not open port %u\n", port);
+        return -1;
+    }
+    ThreadPool pool(threads);
+    MatchServer server(matches, level, seed, &pool, &socket);
+    printf("hosting %u matches of level %u on port %u with %u threads\n",
+           server.GetMatches(), level, port, pool.GetThreads());
+
+    const std::chrono::duration<double> step_length(SIMULATION_STEP_LENGTH / 1000.0);
+    auto last = std::chrono::steady_clock::now();
+    std::chrono::duration<double> accumulator(0);
+    double busy = 0;
+    double slowest_step = 0;
+    unsigned long running = 0;
+
+    for (unsigned long step = 0; step < max_steps; )
+    {
+        auto now = std::chrono::steady_clock::now();
+        accumulator += now - last;
+        last = now;
+        if (accumulator > step_length * SIMULATION_MAX_STEPS_PER_FRAME)
+            accumulator = step_length * SIMULATION_MAX_STEPS_PER_FRAME;
+
+        while (accumulator >= step_length && step < max_steps)
+        {
+            accumulator -= step_length;
+            auto step_start = std::chrono::steady_clock::now();
+            server.Step();
+            double step_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - step_start).count();
+            busy += step_time;
+            if (step_time > slowest_step)
+                slowest_step = step_time;
+            running += server.GetRunning();
+            ++step;
+
+            if (step % SERVER_REPORT_STEPS == 0)
+            {
+                printf("step %lu: %.1f matches running, %u clients, %u spectators, %lu packets in,"
+                       " %lu out, %lu snapshots of %.1f bytes, %lu too large to send,"
+                       " busy %.1f%% of the time, slowest step %.2f ms\n",
+                       step, (double)running / SERVER_REPORT_STEPS, server.GetClients(), server.GetSpectators(),
+                       server.GetReceived(), server.GetSent(), server.GetViews(),
+                       server.GetViews() > 0 ? (double)server.GetViewBytes() / server.GetViews() : 0.0,
+                       server.GetDroppedViews(),
+                       busy * 100 / (SERVER_REPORT_STEPS * step_length.count()), slowest_step * 1e3);
+                busy = 0;
+                slowest_step = 0;
+                running = 0;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    printf("%lu match steps, %lu matches made again after they ended\n",
+           server.GetMatchSteps(), server.GetRestarts());
+    return 0;
+}
+
+int RunServerClient(const NetworkOptions& options, unsigned int match, unsigned long max_steps)
+{
+    UdpSocket socket;
+    if (!socket.Open(options.local_port, options.peer_host, options.peer_port))
+    {
+        printf("Could not open a port towards %s:%u\n", options.peer_host.c_str(), options.peer_port);
+        return -1;
+    }
+    socket.SetLatency(options.latency, options.jitter, options.loss, options.seed * 2 + options.local_player);
+
+    StateBuffer packet(NETWORK_PACKET_SIZE);
+    std::vector<uint8_t> received(NETWORK_PACKET_SIZE);
+    unsigned long states = 0;
+    uint32_t server_step = 0;
+    uint64_t match_seed = 0;
+    uint16_t x = 0, y = 0;
+    uint8_t lives = 0;
+
+    const std::chrono::duration<double> step_length(SIMULATION_STEP_LENGTH / 1000.0);
+    auto start = std::chrono::steady_clock::now();
+    auto last = start;
+    std::chrono::duration<double> accumulator(0);
+
+    for (unsigned long step = 0; step < max_steps; )
+    {
+        auto now = std::chrono::steady_clock::now();
+        accumulator += now - last;
+        last = now;
+        while (accumulator >= step_length && step < max_steps)
+        {
+            accumulator -= step_length;
+            packet.Clear();
+            packet.Write(SERVER_CLIENT_MAGIC);
+            packet.Write((uint16_t)match);
+            packet.Write((uint8_t)options.local_player);
+            packet.Write(Buttons(match * SERVER_MATCH_PLAYERS + options.local_player, step));
+            socket.Send(packet.GetData(), packet.GetSize());
+            ++step;
+        }
+
+        int size;
+        while ((size = socket.Receive(received.data(), received.size())) > 0)
+        {
+            packet.Assign(received.data(), size);
+            uint32_t magic, step;
+            uint16_t number;
+            uint64_t seed;
+            uint8_t players;
+            packet.Read(magic);
+            packet.Read(number);
+            packet.Read(seed);
+            packet.Read(step);
+            packet.Read(players);
+            if (packet.Failed() || magic != SERVER_STATE_MAGIC || number != match ||
+                players <= options.local_player)
+                continue;
+            for (unsigned int player = 0; player <= options.local_player; ++player)
+            {
+                uint8_t alive;
+                packet.Read(x);
+                packet.Read(y);
+                packet.Read(lives);
+                packet.Read(alive);
+            }
+            if (packet.Failed())
+                continue;
+            ++states;
+            server_step = step;
+            match_seed = seed;
+        }
+
+        if (states == 0 && std::chrono::duration<double>(now - start).count() > CLIENT_CONNECT_SECONDS)
+        {
+            printf("No states from %s:%u\n", options.peer_host.c_str(), options.peer_port);
+            return -1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    printf("player %u of match %u sent %lu steps of buttons and got %lu states\n",
+           options.local_player, match, max_steps, states);
+    printf("last state: step %u of the match from seed %llu, player at %u,%u with %u lives\n",
+           server_step, (unsigned long long)match_seed, x, y, lives);
+    return 0;
+}
+
+int RunServerSpectator(const NetworkOptions& options, unsigned int match, unsigned long max_steps)
+{
+    UdpSocket socket;
+    if (!socket.Open(options.local_port, options.peer_host, options.peer_port))
+    {
+        printf("Could not open a port towards %s:%u\n", options.peer_host.c_str(), options.peer_port);
+        return -1;
+    }
+    socket.SetLatency(options.latency, options.jitter, options.loss, options.seed * 2 + 1);
+
+    StateBuffer packet(NETWORK_PACKET_SIZE);
+    std::vector<uint8_t> received(NETWORK_PACKET_SIZE);
+    std::vector<uint8_t> assembled(SERVER_VIEW_PARTS * SERVER_VIEW_PART_SIZE);
+    std::size_t assembled_size = 0;
+    uint64_t assembled_parts = 0; // bit of every part received
+    uint32_t assembled_base = SERVER_NO_BASE, assembled_step = 0;
+    unsigned int assembled_count = 0;
+    std::vector<WorldSnapshot> snapshots(SERVER_SNAPSHOTS);
+    WorldSnapshot snapshot;
+    BitWriter full(NETWORK_PACKET_SIZE);
+    const WorldSnapshot* last = nullptr;
+    unsigned long views = 0, deltas = 0, broken = 0, bytes = 0, full_bytes = 0;
+
+    const std::chrono::duration<double> step_length(SIMULATION_STEP_LENGTH / 1000.0);
+    auto start = std::chrono::steady_clock::now();
+    auto last_time = start;
+    std::chrono::duration<double> accumulator(0);
+
+    for (unsigned long step = 0; step < max_steps; )
+    {
+        auto now = std::chrono::steady_clock::now();
+        accumulator += now - last_time;
+        last_time = now;
+        bool acknowledge = false;
+        while (accumulator >= step_length && step < max_steps)
+        {
+            accumulator -= step_length;
+            // Acknowledged now and then even with nothing new, which also joins
+            acknowledge |= step % SERVER_STATE_INTERVAL == 0;
+            ++step;
+        }
+
+        int size;
+        while ((size = socket.Receive(received.data(), received.size())) > 0)
+        {
+            BitReader header(received.data(), size);
+            uint32_t magic = header.Read(32);
+            uint32_t number = header.Read(16);
+            uint32_t base_step = header.Read(32);
+            uint32_t view_step = header.Read(32);
+            unsigned int part = header.Read(8);
+            unsigned int parts = header.Read(8);
+            if (header.Failed() || magic != SERVER_VIEW_MAGIC || number != match ||
+                part >= parts || parts > SERVER_VIEW_PARTS ||
+                (part + 1 < parts && size != (int)NETWORK_PACKET_SIZE))
+                continue;
+
+            // A part of another snapshot starts putting that one together
+            if (base_step != assembled_base || view_step != assembled_step || parts != assembled_count)
+            {
+                assembled_base = base_step;
+                assembled_step = view_step;
+                assembled_count = parts;
+                assembled_parts = 0;
+            }
+            std::copy(received.begin() + SERVER_VIEW_HEADER, received.begin() + size,
+                      assembled.begin() + part * SERVER_VIEW_PART_SIZE);
+            if (part + 1 == parts)
+                assembled_size = part * SERVER_VIEW_PART_SIZE + size - SERVER_VIEW_HEADER;
+            assembled_parts |= (uint64_t)1 << part;
+            if (assembled_parts != ((uint64_t)-1 >> (64 - parts)))
+                continue;
+            assembled_parts = 0;
+            assembled_count = 0;
+            BitReader in(assembled.data(), assembled_size);
+
+            const WorldSnapshot* base = nullptr;
+            if (base_step != SERVER_NO_BASE)
+            {
+                const WorldSnapshot& kept = snapshots[base_step / SERVER_STATE_INTERVAL % SERVER_SNAPSHOTS];
+                if (kept.step == base_step)
+                    base = &kept;
+            }
+
+            // Read aside first, as the base may sit in the slot of the new one
+            if (!SnapshotDelta::Read(base, in, snapshot))
+            {
+                ++broken;
+                continue;
+            }
+            WorldSnapshot& kept = snapshots[snapshot.step / SERVER_STATE_INTERVAL % SERVER_SNAPSHOTS];
+            kept = snapshot;
+            if (last == nullptr || kept.seed != last->seed || kept.step > last->step)
+                last = &kept;
+
+            full.Clear();
+            SnapshotDelta::Write(nullptr, kept, full);
+            ++views;
+            deltas += base != nullptr;
+            bytes += assembled_size + parts * SERVER_VIEW_HEADER;
+            full_bytes += full.GetSize() + SERVER_VIEW_HEADER;
+            acknowledge = true;
+        }
+
+        if (acknowledge)
+        {
+            packet.Clear();
+            packet.Write(SERVER_WATCH_MAGIC);
+            packet.Write((uint16_t)match);
+            packet.Write(last != nullptr ? last->seed : (uint64_t)0);
+            packet.Write(last != nullptr ? last->step : SERVER_NO_BASE);
+            socket.Send(packet.GetData(), packet.GetSize());
+        }
+
+        if (views == 0 && std::chrono::duration<double>(now - start).count() > CLIENT_CONNECT_SECONDS)
+        {
+            printf("No snapshots from %s:%u\n", options.peer_host.c_str(), options.peer_port);
+            return -1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    printf("watched match %u: %lu snapshots, %lu of them deltas, %lu broken\n", match, views, deltas, broken);
+    printf("%.1f bytes per snapshot, %.1f in full (%.1f%%), %.0f bytes/s\n",
+           views > 0 ? (double)bytes / views : 0.0, views > 0 ? (double)full_bytes / views : 0.0,
+           full_bytes > 0 ? bytes * 100.0 / full_bytes : 0.0,
+           bytes * 1000.0 / (max_steps * SIMULATION_STEP_LENGTH));
+    if (last != nullptr)
+        printf("last snapshot: step %u from seed %llu, %zu enemies, %zu bombs, %zu opened tiles\n",
+               last->step, (unsigned long long)last->seed, last->enemies.size(), last->bombs.size(),
+               last->opened.size());
+    return broken > 0 ? 1 : 0;
+}
+
+// Steps all matches with random buttons and gives the match steps per second
+static double MeasureServer(unsigned int level, unsigned int matches, unsigned int threads,
+                            unsigned long& allocations, unsigned long& restarts)
+{
+    ThreadPool pool(threads);
+    MatchServer server(matches, level, 1, &pool, nullptr);
+
+    unsigned long step = 0;
+    auto play = [&](unsigned long steps)
+    {
+        for (unsigned long end = step + steps; step < end; ++step)
+        {
+            for (unsigned int match = 0; match < matches; ++match)
+                for (unsigned int player = 0; player < SERVER_MATCH_PLAYERS; ++player)
+                    server.SetButtons(match, player, Buttons(match * SERVER_MATCH_PLAYERS + player, step));
+            server.Step();
+        }
+    };
+
+    play(BENCH_WARMUP_STEPS);
+    unsigned long steps_before = server.GetMatchSteps();
+    unsigned long restarts_before = server.GetRestarts();
+    unsigned long allocations_before = AllocationCount();
+    auto start = std::chrono::steady_clock::now();
+    play(BENCH_STEPS);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    allocations = AllocationCount() - allocations_before;
+    restarts = server.GetRestarts() - restarts_before;
+    return (server.GetMatchSteps() - steps_before) / seconds;
+}
+
+void RunServerBenchmark(unsigned int level, unsigned int matches, unsigned int threads)
+{
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+    if (threads == 0)
+        threads = 1;
+
+    const double real_time_steps = 1000.0 / SIMULATION_STEP_LENGTH;
+    printf("%u matches of level %u, %lu steps each, %u cores\n",
+           matches, level, BENCH_STEPS, std::thread::hardware_concurrency());
+
+    double single = 0;
+    for (unsigned int t = 1; ; t = threads)
+    {
+        unsigned long allocations, restarts;
+        double steps_per_second = MeasureServer(level, matches, t, allocations, restarts);
+        if (t == 1)
+            single = steps_per_second;
+        printf("%2u threads: %.0f match steps/s, %.1f matches per thread in real time,"
+               " %.2fx of one thread, %lu allocations (%lu matches made again)\n",
+               t, steps_per_second, steps_per_second / t / real_time_steps,
+               single > 0 ? steps_per_second / single : 0.0, allocations, restarts);
+        if (t == threads)
+            break;
+    }
+}
@@ -0,0 +1,35 @@
+#ifndef SERVERRUN_H
+#define SERVERRUN_H
+
+#include "Network/NetworkOptions.h"
+#include <cstdint>
+
+/*
+ *  Runs a MatchServer hosting many two player matches on a UDP port in real
+ *  time, printing every few seconds how many matches ran and how much of
+ *  each 10 ms step the server was busy. Threads 0 means one per core.
+ */
+int RunServer(unsigned short port, unsigned int matches, unsigned int threads,
+              unsigned int level, uint64_t seed, unsigned long max_steps);
+
+/*
+ *  Plays one seat of a match on a MatchServer with random buttons, sending
+ *  them every step, and reports how many states came back.
+ */
+int RunServerClient(const NetworkOptions& options, unsigned int match, unsigned long max_steps);
+
+/*
+ *  Watches a match on a MatchServer, acknowledging every snapshot, and
+ *  reports how many bytes the snapshots took next to writing them in full.
+ *  Snapshots split over several packets are put together again first.
+ */
+int RunServerSpectator(const NetworkOptions& options, unsigned int match, unsigned long max_steps);
+
+/*
+ *  Steps many matches with random buttons as fast as possible, on one thread
+ *  and on the given number of threads, and reports how many matches one core
+ *  keeps running in real time.
+ */
+void RunServerBenchmark(unsigned int level, unsigned int matches, unsigned int threads);
+
+#endif // SERVERRUN_H
@@ -0,0 +1,192 @@
+#include "SnapshotBenchmark.h"
+#include "AllocationCounter.h"
+#include "Simulation/World.h"
+#include "Simulation/ScriptedInput.h"
+#include "Simulation/WorldSnapshot.h"
+#include "Network/SnapshotDelta.h"
+#include "Utility/BitStream.h"
+#include "Utility/Random.h"
+#include "Constants/WindowConstants.h"
+#include "Constants/SimulationConstants.h"
+#include "Constants/NetworkConstants.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+static const unsigned long SNAPSHOT_STEPS = 20000;
+static const unsigned int SNAPSHOT_LAG = 5; // snapshots between the base and the new one, 100 ms
+static const unsigned int SNAPSHOT_HOLD = 20; // steps the random buttons are held
+static const unsigned int LARGE_MAP_SIZE = 300; // tiles need more than 16 bits
+static const unsigned int LARGE_MAP_ENEMIES = 8000;
+static const unsigned int LARGE_MAP_MARKERS = 500;
+
+// Up, down, left, right or nothing and a bomb now and then for both players
+static void Press(KeyboardInput* input, const std::vector<SDL_Keycode>& keys, unsigned long step)
+{
+    for (unsigned int player = 0; player * 5 + 5 <= keys.size(); ++player)
+    {
+        Random random(step / SNAPSHOT_HOLD, 2 + player);
+        unsigned int direction = random.Below(5);
+        bool bomb = random.Below(3) == 0 && step % SNAPSHOT_HOLD == 0;
+        for (unsigned int k = 0; k < 5; ++k)
+        {
+            bool on = k == direction || (k == 4 && bomb);
+            if (!on && input->IsKeyOn(keys[player * 5 + k]))
+                input->TurnKeyOff(keys[player * 5 + k]);
+        }
+        if (direction < 4 && !input->IsKeyOn(keys[player * 5 + direction]))
+            input->TurnKeyOn(keys[player * 5 + direction]);
+        if (bomb && !input->IsKeyOn(keys[player * 5 + 4]))
+            input->TurnKeyOn(keys[player * 5 + 4]);
+    }
+}
+
+// A made up snapshot of a map larger than 256x256 with a horde of enemies,
+// packed in full and against itself after some changes
+static unsigned int CheckLargeMap(std::size_t& full_size)
+{
+    Random random(1, 1);
+    WorldSnapshot base;
+    base.seed = 1;
+    base.step = 100;
+    base.width = LARGE_MAP_SIZE;
+    base.height = LARGE_MAP_SIZE;
+    base.tile_size = MAP_TILE_SIZE;
+    const unsigned int tiles = LARGE_MAP_SIZE * LARGE_MAP_SIZE;
+    const unsigned int pixels = LARGE_MAP_SIZE * MAP_TILE_SIZE;
+    for (unsigned int i = 0; i < LARGE_MAP_MARKERS; ++i)
+        base.opened.push_back(random.Below(tiles));
+    for (unsigned int i = 0; i < 2; ++i)
+        base.players.push_back({(uint16_t)random.Below(pixels), (uint16_t)random.Below(pixels), (uint8_t)i, 3});
+    for (unsigned int i = 0; i < LARGE_MAP_ENEMIES; ++i)
+        base.enemies.push_back({(uint16_t)random.Below(pixels), (uint16_t)random.Below(pixels), (uint8_t)random.Below(3), 0});
+    for (unsigned int i = 0; i < LARGE_MAP_MARKERS; ++i)
+    {
+        base.bombs.push_back({random.Below(tiles), (uint8_t)random.Below(2)});
+        base.explosions.push_back({random.Below(tiles), (uint8_t)random.Below(256)});
+        base.pickups.push_back({random.Below(tiles), (uint8_t)random.Below(8)});
+    }
+    std::sort(base.bombs.begin(), base.bombs.end());
+    std::sort(base.explosions.begin(), base.explosions.end());
+    std::sort(base.pickups.begin(), base.pickups.end());
+
+    WorldSnapshot snapshot = base;
+    snapshot.step += SERVER_STATE_INTERVAL;
+    snapshot.opened.push_back(tiles - 1);
+    for (unsigned int i = 0; i < LARGE_MAP_ENEMIES; i += 3)
+        snapshot.enemies[i].x += 1;
+    snapshot.bombs.erase(snapshot.bombs.begin());
+    snapshot.bombs.push_back({tiles - 1, 1});
+    std::sort(snapshot.bombs.begin(), snapshot.bombs.end());
+
+    unsigned int mismatches = 0;
+    WorldSnapshot decoded;
+    BitWriter out(NETWORK_PACKET_SIZE);
+    SnapshotDelta::Write(nullptr, base, out);
+    full_size = out.GetSize();
+    BitReader full(out.GetData(), out.GetSize());
+    if (!SnapshotDelta::Read(nullptr, full, decoded) || !(decoded == base))
+        ++mismatches;
+
+    out.Clear();
+    SnapshotDelta::Write(&base, snapshot, out);
+    BitReader delta(out.GetData(), out.GetSize());
+    if (!SnapshotDelta::Read(&base, delta, decoded) || !(decoded == snapshot))
+        ++mismatches;
+    return mismatches;
+}
+
+void RunSnapshotBenchmark(unsigned int level)
+{
+    ScriptedInput input;
+    SystemTimer timer;
+    std::vector<WorldSnapshot> snapshots(SNAPSHOT_LAG + 1);
+    WorldSnapshot decoded;
+    BitWriter delta(NETWORK_PACKET_SIZE);
+    BitWriter full(NETWORK_PACKET_SIZE);
+
+    double take_seconds = 0;
+    double pack_seconds = 0;
+    unsigned long packed = 0;
+    unsigned long delta_bytes = 0;
+    unsigned long full_bytes = 0;
+    std::size_t largest_delta = 0;
+    std::size_t largest_full = 0;
+    unsigned long mismatches = 0;
+    unsigned long allocations = 0;
+    unsigned int worlds = 0;
+
+    unsigned long total = 0;
+    while (total < SNAPSHOT_STEPS)
+    {
+        timer.SetSteps(0);
+        World* world = new World(nullptr, MAP_TILE_SIZE, 2, level, &input, worlds + 1, &timer);
+        ++worlds;
+        std::vector<SDL_Keycode> keys;
+        world->GetInputKeys(keys);
+
+        unsigned long taken = 0;
+        for (unsigned long step = 0; total < SNAPSHOT_STEPS && !world->PlayersDead() && !world->LevelCompleted(); ++step)
+        {
+            Press(&input, keys, step);
+            timer.Step();
+            world->Update();
+            ++total;
+            if (timer.GetSteps() % SERVER_STATE_INTERVAL != 0)
+                continue;
+
+            // Memory is made by the first world, later ones reuse it
+            unsigned long allocated = AllocationCount();
+            WorldSnapshot& snapshot = snapshots[taken % snapshots.size()];
+            auto start = std::chrono::steady_clock::now();
+            world->TakeSnapshot(snapshot);
+            take_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            const WorldSnapshot* base = taken >= SNAPSHOT_LAG ? &snapshots[(taken - SNAPSHOT_LAG) % snapshots.size()] : nullptr;
+            start = std::chrono::steady_clock::now();
+            delta.Clear();
+            SnapshotDelta::Write(base, snapshot, delta);
+            pack_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (worlds > 1)
+                allocations += AllocationCount() - allocated;
+            ++taken;
+
+            full.Clear();
+            SnapshotDelta::Write(nullptr, snapshot, full);
+            ++packed;
+            delta_bytes += delta.GetSize();
+            full_bytes += full.GetSize();
+            if (delta.GetSize() > largest_delta)
+                largest_delta = delta.GetSize();
+            if (full.GetSize() > largest_full)
+                largest_full = full.GetSize();
+
+            BitReader in(delta.GetData(), delta.GetSize());
+            if (!SnapshotDelta::Read(base, in, decoded) || !(decoded == snapshot))
+                ++mismatches;
+        }
+
+        delete world;
+    }
+
+    double snapshots_per_second = 1000.0 / (SIMULATION_STEP_LENGTH * SERVER_STATE_INTERVAL);
+    printf("level %u with 2 players, a snapshot every %u steps, %lu snapshots in %u worlds\n",
+           level, SERVER_STATE_INTERVAL, packed, worlds);
+    printf("full:  %7.1f bytes per snapshot, largest %zu, %.0f bytes/s per spectator\n",
+           packed ? (double)full_bytes / packed : 0.0, largest_full,
+           packed ? full_bytes * snapshots_per_second / packed : 0.0);
+    printf("delta: %7.1f bytes per snapshot against one %u ms older, largest %zu, %.0f bytes/s (%.1f%%)\n",
+           packed ? (double)delta_bytes / packed : 0.0, SNAPSHOT_LAG * SERVER_STATE_INTERVAL * SIMULATION_STEP_LENGTH,
+           largest_delta, packed ? delta_bytes * snapshots_per_second / packed : 0.0,
+           full_bytes ? delta_bytes * 100.0 / full_bytes : 0.0);
+    printf("take:  %7.2f us, pack: %.2f us per snapshot, %lu heap allocations after the first world\n",
+           packed ? take_seconds * 1e6 / packed : 0.0, packed ? pack_seconds * 1e6 / packed : 0.0, allocations);
+    printf("%lu of %lu snapshots read back differently\n", mismatches, packed);
+
+    std::size_t large_size = 0;
+    unsigned int large_mismatches = CheckLargeMap(large_size);
+    printf("%u of 2 snapshots of a %ux%u map with %u enemies read back differently, %zu bytes in full\n",
+           large_mismatches, LARGE_MAP_SIZE, LARGE_MAP_SIZE, LARGE_MAP_ENEMIES, large_size);
+}
@@ -0,0 +1,13 @@
+#ifndef SNAPSHOTBENCHMARK_H
+#define SNAPSHOTBENCHMARK_H
+
+/*
+ *  Plays a two player level with random buttons, takes a snapshot of it as a
+ *  server would for its spectators and measures how many bytes the snapshots
+ *  take packed against one acknowledged a while before, next to packing
+ *  them in full, and checks that every packed snapshot reads back the same.
+ */
+
+void RunSnapshotBenchmark(unsigned int level);
+
+#endif // SNAPSHOTBENCHMARK_H
@@ -0,0 +1,125 @@
+#include "StateBenchmark.h"
+#include "AllocationCounter.h"
+#include "Simulation/World.h"
+#include "Simulation/ScriptedInput.h"
+#include "System/SystemTimer.h"
+#include "Utility/Random.h"
+#include "Utility/StateBuffer.h"
+#include "Constants/WindowConstants.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+static const unsigned long STATE_STEPS = 20000;
+static const unsigned int STATE_CHECK_EVERY = 50; // steps between two checks of a loaded state
+static const unsigned int STATE_CHECK_LENGTH = 30; // steps played from the loaded state
+static const unsigned int STATE_HOLD = 20; // steps the random buttons are held
+
+// Buttons only depend on the step, so steps played again get the same ones
+// Keys are up, down, left, right and bomb of the first player
+static void Press(KeyboardInput* input, const std::vector<SDL_Keycode>& keys, unsigned long step)
+{
+    Random random(step / STATE_HOLD, 1);
+    unsigned int direction = random.Below(5);
+    bool bomb = random.Below(3) == 0 && step % STATE_HOLD == 0;
+    for (unsigned int k = 0; k < 5; ++k)
+        if (input->IsKeyOn(keys[k]))
+            input->TurnKeyOff(keys[k]);
+    if (direction < 4)
+        input->TurnKeyOn(keys[direction]);
+    if (bomb)
+        input->TurnKeyOn(keys[4]);
+}
+
+static void Step(World* world, KeyboardInput* input, const std::vector<SDL_Keycode>& keys, unsigned long step)
+{
+    Press(input, keys, step);
+    SystemTimer::Instance()->Step();
+    world->Update();
+}
+
+static bool Same(const StateBuffer& a, const StateBuffer& b)
+{
+    return a.GetSize() == b.GetSize() && memcmp(a.GetData(), b.GetData(), a.GetSize()) == 0;
+}
+
+void RunStateBenchmark(unsigned int level)
+{
+    ScriptedInput input;
+    StateBuffer saved(1 << 16);
+    StateBuffer ahead(1 << 16);
+    StateBuffer again(1 << 16);
+
+    double save_seconds = 0;
+    double load_seconds = 0;
+    unsigned long saves = 0;
+    unsigned long loads = 0;
+    unsigned long checks = 0;
+    unsigned long mismatches = 0;
+    unsigned long allocations = 0;
+    unsigned int worlds = 0;
+    std::size_t largest = 0;
+
+    unsigned long total = 0;
+    while (total < STATE_STEPS)
+    {
+        World* world = new World(nullptr, MAP_TILE_SIZE, 1, level, &input, worlds + 1);
+        ++worlds;
+        std::vector<SDL_Keycode> keys;
+        world->GetInputKeys(keys);
+
+        unsigned long step = 0;
+        while (total < STATE_STEPS && !world->PlayersDead() && !world->LevelCompleted())
+        {
+            // Every step is saved, as rollback would do
+            unsigned long allocated = AllocationCount();
+            auto start = std::chrono::steady_clock::now();
+            world->SaveState(saved);
+            save_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            allocations += AllocationCount() - allocated;
+            ++saves;
+            if (saved.GetSize() > largest)
+                largest = saved.GetSize();
+
+            if (step % STATE_CHECK_EVERY == 0)
+            {
+                for (unsigned int k = 0; k < STATE_CHECK_LENGTH; ++k)
+                    Step(world, &input, keys, step + k);
+                world->SaveState(ahead);
+
+                allocated = AllocationCount();
+                start = std::chrono::steady_clock::now();
+                world->LoadState(saved);
+                load_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                allocations += AllocationCount() - allocated;
+                ++loads;
+
+                for (unsigned int k = 0; k < STATE_CHECK_LENGTH; ++k)
+                    Step(world, &input, keys, step + k);
+                world->SaveState(again);
+
+                ++checks;
+                if (!Same(ahead, again))
+                    ++mismatches;
+                step += STATE_CHECK_LENGTH;
+                total += STATE_CHECK_LENGTH;
+            }
+            else
+            {
+                Step(world, &input, keys, step);
+                ++step;
+                ++total;
+            }
+        }
+
+        delete world;
+    }
+
+    printf("state of level %u saved every step, %lu steps in %u worlds\n", level, total, worlds);
+    printf("save: %8.2f us per state, largest state %zu bytes\n", saves ? save_seconds * 1e6 / saves : 0.0, largest);
+    printf("load: %8.2f us per state\n", loads ? load_seconds * 1e6 / loads : 0.0);
+    printf("%lu heap allocations while saving and loading\n", allocations);
+    printf("%lu of %lu loaded states played on differently\n", mismatches, checks);
+}
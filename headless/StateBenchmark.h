@@ -0,0 +1,12 @@
+#ifndef STATEBENCHMARK_H
+#define STATEBENCHMARK_H
+
+/*
+ *  Measures how long saving and loading the state of a World takes while a
+ *  level is played by random buttons, and checks that a loaded state plays
+ *  on exactly as the saved one did.
+ */
+
+void RunStateBenchmark(unsigned int level);
+
+#endif // STATEBENCHMARK_H
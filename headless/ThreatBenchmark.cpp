@@ -0,0 +1,131 @@
+#include "ThreatBenchmark.h"
+#include "Manager/Map.h"
+#include "Destroyer/Destroyer.h"
+#include "Destroyer/ThreatMap.h"
+#include "Entity/Bomb.h"
+#include "System/SystemTimer.h"
+#include "Utility/ObjectPool.h"
+#include "Utility/Relay.h"
+#include "Constants/PlayerConstants.h"
+#include "Constants/PoolConstants.h"
+#include "Constants/WindowConstants.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+static const unsigned int ARENA_SIZE = 41;
+static const unsigned int ARENA_ROUNDS = 2000;
+static const char* ARENA_PATH = "bench-threats-arena.txt";
+
+// Indestructible border and pillars on even tiles, every other tile is a
+// destructible wall with some chance. Tiles 1,2 and 3,2 on both sides of the
+// pillar 2,2 are kept empty for the check behind a wall.
+static void WriteArena()
+{
+    std::ofstream fs(ARENA_PATH);
+    fs << ARENA_SIZE << " " << ARENA_SIZE << "\n";
+    for (unsigned int i = 0; i < ARENA_SIZE; ++i)
+    {
+        for (unsigned int j = 0; j < ARENA_SIZE; ++j)
+        {
+            int id = 0;
+            if (i == 0 || j == 0 || i == ARENA_SIZE - 1 || j == ARENA_SIZE - 1 || (i % 2 == 0 && j % 2 == 0))
+                id = 2;
+            else if (j == 2 && (i == 1 || i == 3))
+                id = 0;
+            else if (rand() % 100 < 30)
+                id = 1;
+            fs << id << " ";
+        }
+        fs << "\n";
+    }
+}
+
+// Tiles whose time does not follow from the blast circles of the bombs: a
+// tile in a circle must go off no later than its bomb, and a tile with a time
+// must be in some circle
+static unsigned long CountMismatches(const ThreatMap& threats, const ObjectPool<Bomb>& bombs)
+{
+    const unsigned int tile = MAP_TILE_SIZE;
+    unsigned long mismatches = 0;
+    for (unsigned int i = 0; i < ARENA_SIZE; ++i)
+    {
+        for (unsigned int j = 0; j < ARENA_SIZE; ++j)
+        {
+            unsigned long time = threats.GetTime(i, j);
+            bool inside = false;
+            bool late = false;
+            for (auto b = bombs.begin(); b != bombs.end(); ++b)
+            {
+                if (Destroyer::Reaches(j*tile, i*tile, tile, tile, (*b)->GetX(), (*b)->GetY(), tile, (*b)->GetIntensity()))
+                {
+                    inside = true;
+                    late = late || time > (*b)->GetDetonationTime();
+                }
+            }
+            mismatches += late || (!inside && time != ThreatMap::NEVER);
+        }
+    }
+    return mismatches;
+}
+
+void RunThreatBenchmark()
+{
+    const unsigned int tile = MAP_TILE_SIZE;
+    srand(1);
+    WriteArena();
+
+    Relay relay;
+    Map map(ARENA_PATH, nullptr, tile, &relay, Random(1));
+    relay.SetMap(&map);
+    remove(ARENA_PATH);
+
+    SystemTimer timer;
+    ObjectPool<Bomb> bombs(POOL_BOMB_CAPACITY);
+    ThreatMap threats(ARENA_SIZE, ARENA_SIZE, tile, POOL_BOMB_CAPACITY);
+
+    double add_seconds = 0;
+    double refresh_seconds = 0;
+    unsigned long mismatches = 0;
+    for (unsigned int round = 0; round < ARENA_ROUNDS; ++round)
+    {
+        threats.Clear();
+        bombs.Clear();
+        auto start = std::chrono::steady_clock::now();
+        while (bombs.GetSize() < POOL_BOMB_CAPACITY)
+        {
+            unsigned int i = rand() % ARENA_SIZE;
+            unsigned int j = rand() % ARENA_SIZE;
+            if (!map.Walkable(i, j))
+                continue;
+            double intensity = PLAYER_MIN_BOMB_INTENSITY +
+                               (PLAYER_MAX_BOMB_INTENSITY - PLAYER_MIN_BOMB_INTENSITY) * (rand() % 100) / 100;
+            Bomb* bomb = bombs.Make(1000 + rand() % 4000, nullptr, &timer, j*tile + rand() % tile, i*tile + rand() % tile,
+                                    tile, 0, intensity);
+            threats.Add(bomb, &map);
+        }
+        auto middle = std::chrono::steady_clock::now();
+        threats.Refresh(&map);
+        auto end = std::chrono::steady_clock::now();
+        add_seconds += std::chrono::duration<double>(middle - start).count();
+        refresh_seconds += std::chrono::duration<double>(end - middle).count();
+
+        mismatches += CountMismatches(threats, bombs);
+    }
+
+    // At the bottom of tile 1,2 the blast circle takes in the centre of tile
+    // 3,2 behind the pillar, which is where a player there would be killed
+    threats.Clear();
+    bombs.Clear();
+    threats.Add(bombs.Make(1000, nullptr, &timer, 2*tile + tile/2, 2*tile - 1, tile, 0, PLAYER_MAX_BOMB_INTENSITY), &map);
+    bool behind = threats.GetTime(3, 2) != ThreatMap::NEVER;
+
+    printf("threat map on a %ux%u arena, %u bombs placed per round, %u rounds\n",
+           ARENA_SIZE, ARENA_SIZE, POOL_BOMB_CAPACITY, ARENA_ROUNDS);
+    printf("add:     %8.2f us per bomb\n", add_seconds * 1e6 / ARENA_ROUNDS / POOL_BOMB_CAPACITY);
+    printf("refresh: %8.2f us per round\n", refresh_seconds * 1e6 / ARENA_ROUNDS);
+    printf("%lu tile times differ from the blast circles\n", mismatches);
+    printf("tile behind a pillar inside the blast circle is %s\n", behind ? "threatened" : "NOT threatened");
+}
@@ -0,0 +1,12 @@
+#ifndef THREATBENCHMARK_H
+#define THREATBENCHMARK_H
+
+/*
+ *  Measures how long ThreatMap takes to place bombs and work out their reach
+ *  again on a walled arena, and checks its times against the blast circle
+ *  which kills players and enemies, walls or not.
+ */
+
+void RunThreatBenchmark();
+
+#endif // THREATBENCHMARK_H
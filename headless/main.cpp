@@ -0,0 +1,321 @@
+#include "Simulation/World.h"
+#include "Simulation/ScriptedInput.h"
+#include "Simulation/InputRecording.h"
+#include "AllocationCounter.h"
+#include "ContactBenchmark.h"
+#include "DistanceBenchmark.h"
+#include "ThreatBenchmark.h"
+#include "StateBenchmark.h"
+#include "SnapshotBenchmark.h"
+#include "EnemyBenchmark.h"
+#include "RenderBenchmark.h"
+#include "NetworkMatch.h"
+#include "ServerRun.h"
+#include "Network/NetworkOptions.h"
+#include "System/SystemTimer.h"
+#include "Utility/ThreadPool.h"
+#include "Utility/StateBuffer.h"
+#include "Constants/WindowConstants.h"
+#include "Constants/SimulationConstants.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+/*
+ *  Runs levels of the game without a window or renderer as fast as possible.
+ *  Every round makes a new World of the given level, feeds it the buttons of
+ *  the script (if any) and steps it until the players are all dead, the level
+ *  is completed or the step limit is reached. Heap allocations made while
+ *  stepping are counted and reported. Round r is made from seed N + r (1 + r
+ *  by default), so the same arguments always give the same results. With
+ *  --record the buttons of the first round are written to a file which
+ *  --replay plays again in place of the level, players, seed and script,
+ *  reporting the slowest step and whether the game went apart from the
+ *  recorded one: the level ending early or a state checksum of the World
+ *  differing from the one recorded after the same step. With --bench-contact
+ *  only the contact tests are measured instead, with --bench-distance only the distance field to the players,
+ *  with --bench-threats only the threat map of the bombs and
+ *  with --bench-state only saving and loading the state of the World and
+ *  with --bench-snapshot only packing snapshots of it for spectators and
+ *  with --bench-render only batching the sprites of it for drawing.
+ *  With --net-port and --net-peer the level is played by two players against
+ *  a peer process over UDP instead, see NetworkMatch.h. With --server many
+ *  matches are hosted for clients on a UDP port, which --client plays one
+ *  seat of and --watch watches, and --bench-server measures how many matches
+ *  one core runs in real time, see ServerRun.h. Levels are played with their
+ *  enemies updated on --threads threads, which --bench-enemies measures on a
+ *  horde of enemies. The benchmarks run after all options are read, so
+ *  options may be given before or after them.
+ */
+
+// Checksum of everything World::SaveState() writes, as kept in recordings
+static uint32_t StateChecksum(const World* world, StateBuffer& state)
+{
+    world->SaveState(state);
+    return state.Checksum();
+}
+
+static void PrintUsage(const char* name)
+{
+    printf("Usage: %s [--level N] [--players N] [--rounds N] [--steps N]"
+           " [--script FILE] [--seed N] [--threads N]\n"
+           "       %s [--record FILE]\n"
+           "       %s --replay FILE [--rounds N]\n"
+           "       %s --bench-contact\n"
+           "       %s --bench-distance\n"
+           "       %s --bench-threats\n"
+           "       %s [--level N] --bench-state\n"
+           "       %s [--level N] --bench-snapshot\n"
+           "       %s [--level N] --bench-render\n"
+           "       %s [--level N] [--seed N] [--steps N] --net-port N --net-peer HOST:PORT\n"
+           "          --net-player 0|1 [--latency MS] [--jitter MS] [--loss PERCENT]\n"
+           "       %s [--level N] [--seed N] [--steps N] --server PORT [--matches N] [--threads N]\n"
+           "       %s [--steps N] --client --net-peer HOST:PORT --match N --net-player 0|1\n"
+           "       %s [--steps N] --watch --net-peer HOST:PORT --match N\n"
+           "       %s [--level N] [--matches N] [--threads N] --bench-server\n"
+           "       %s [--threads N] --bench-enemies\n",
+           name, name, name, name, name, name, name, name, name, name, name, name, name, name, name);
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned int level = 1;
+    unsigned int players = 1;
+    unsigned int rounds = 1;
+    unsigned long max_steps = 18000;
+    std::string script;
+    uint64_t seed = 1;
+    std::string record_path;
+    std::string replay_path;
+    NetworkOptions network;
+    unsigned short server_port = 0;
+    unsigned int matches = 64;
+    unsigned int threads = 0;
+    bool client = false;
+    bool watch = false;
+    unsigned int match = 0;
+    std::string bench; // run after all options are read, so they apply to it
+
+    for (int i = 1; i < argc; ++i)
+    {
+        bool has_value = i + 1 < argc;
+        if (!strcmp(argv[i], "--level") && has_value)
+            level = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--players") && has_value)
+            players = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--rounds") && has_value)
+            rounds = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--steps") && has_value)
+            max_steps = strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--script") && has_value)
+            script = argv[++i];
+        else if (!strcmp(argv[i], "--seed") && has_value)
+            seed = strtoull(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--record") && has_value)
+            record_path = argv[++i];
+        else if (!strcmp(argv[i], "--replay") && has_value)
+            replay_path = argv[++i];
+        else if (!strcmp(argv[i], "--bench-contact"))
+            bench = argv[i];
+        else if (!strcmp(argv[i], "--bench-distance"))
+            bench = argv[i];
+        else if (!strcmp(argv[i], "--bench-threats"))
+            bench = argv[i];
+        else if (!strcmp(argv[i], "--bench-state"))
+            bench = argv[i];
+        else if (!strcmp(argv[i], "--server") && has_value)
+            server_port = (unsigned short)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--matches") && has_value)
+            matches = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--threads") && has_value)
+            threads = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--client"))
+            client = true;
+        else if (!strcmp(argv[i], "--watch"))
+            watch = true;
+        else if (!strcmp(argv[i], "--match") && has_value)
+            match = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--bench-snapshot"))
+            bench = argv[i];
+        else if (!strcmp(argv[i], "--bench-render"))
+            bench = argv[i];
+        else if (!strcmp(argv[i], "--bench-server"))
+            bench = argv[i];
+        else if (!strcmp(argv[i], "--bench-enemies"))
+            bench = argv[i];
+        else if (network.ParseArgument(argc, argv, i))
+            continue;
+        else
+        {
+            PrintUsage(argv[0]);
+            return -1;
+        }
+    }
+
+    if (bench == "--bench-contact")
+        RunContactBenchmark();
+    else if (bench == "--bench-distance")
+        RunDistanceBenchmark();
+    else if (bench == "--bench-threats")
+        RunThreatBenchmark();
+    else if (bench == "--bench-state")
+        RunStateBenchmark(level);
+    else if (bench == "--bench-snapshot")
+        RunSnapshotBenchmark(level);
+    else if (bench == "--bench-render")
+        RunRenderBenchmark(level);
+    else if (bench == "--bench-server")
+        RunServerBenchmark(level, matches, threads);
+    else if (bench == "--bench-enemies")
+        RunEnemyBenchmark(threads);
+    if (!bench.empty())
+        return 0;
+
+    if (server_port != 0)
+        return RunServer(server_port, matches, threads, level, seed, max_steps);
+    if (watch)
+        return RunServerSpectator(network, match, max_steps);
+    if (client)
+        return RunServerClient(network, match, max_steps);
+    if (network.Enabled())
+    {
+        network.level = level;
+        network.seed = seed;
+        return RunNetworkMatch(network, max_steps);
+    }
+
+    InputRecording replay;
+    if (!replay_path.empty())
+    {
+        if (!replay.Load(replay_path))
+        {
+            printf("Could not read recording %s\n", replay_path.c_str());
+            return -1;
+        }
+        level = replay.GetLevel();
+        players = replay.GetPlayers();
+        seed = replay.GetSeed();
+        max_steps = replay.GetSteps();
+        script.clear();
+    }
+
+    SystemTimer* system_timer = SystemTimer::Instance();
+    ThreadPool pool(threads);
+
+    unsigned int completed = 0;
+    unsigned int failed = 0;
+    unsigned long total_steps = 0;
+    unsigned long step_allocations = 0;
+    unsigned int desyncs = 0;
+    double slowest_step = 0;
+    unsigned long slowest_step_number = 0;
+    StateBuffer state;
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned int round = 0; round < rounds; ++round)
+    {
+        // Recorded games start at game time 0, which is part of the checksums
+        if (!replay_path.empty())
+            system_timer->SetSteps(0);
+        ScriptedInput* input = script.empty() ? new ScriptedInput() : new ScriptedInput(script);
+        World* world = new World(nullptr, MAP_TILE_SIZE, players, level, input,
+                                 replay_path.empty() ? seed + round : seed);
+        world->SetThreadPool(&pool);
+
+        InputRecording* recording = nullptr;
+        if (!record_path.empty() && round == 0)
+        {
+            std::vector<SDL_Keycode> keys;
+            world->GetInputKeys(keys);
+            recording = new InputRecording(level, players, world->GetSeed(), keys);
+        }
+
+        unsigned long step = 0;
+        unsigned long matched = 0; // last step whose checksum was the recorded one
+        unsigned long apart = 0; // first step whose checksum was not
+        while (step < max_steps && !world->PlayersDead() && !world->LevelCompleted())
+        {
+            if (replay_path.empty())
+                input->Apply(step);
+            else
+                replay.Play(step, input);
+            if (recording != nullptr)
+                recording->Record(input);
+            system_timer->Step();
+            unsigned long allocations = AllocationCount();
+            if (replay_path.empty())
+                world->Update();
+            else
+            {
+                // Steps are timed one by one so spikes can be found
+                auto step_start = std::chrono::steady_clock::now();
+                world->Update();
+                double step_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - step_start).count();
+                if (step_time > slowest_step)
+                {
+                    slowest_step = step_time;
+                    slowest_step_number = step;
+                }
+            }
+            step_allocations += AllocationCount() - allocations;
+            ++step;
+
+            uint32_t recorded;
+            if (recording != nullptr && InputRecording::ChecksumDue(step))
+                recording->AddChecksum(step, StateChecksum(world, state));
+            if (!replay_path.empty() && apart == 0 && replay.GetChecksum(step, recorded))
+            {
+                if (StateChecksum(world, state) == recorded)
+                    matched = step;
+                else
+                    apart = step;
+            }
+        }
+
+        if (!replay_path.empty() && apart != 0)
+        {
+            printf("round %u went apart from the recording between steps %lu and %lu\n", round, matched, apart);
+            ++desyncs;
+        }
+        else if (!replay_path.empty() && step < replay.GetSteps())
+        {
+            printf("round %u ended after step %lu of the %lu recorded steps\n", round, step, replay.GetSteps());
+            ++desyncs;
+        }
+        if (recording != nullptr)
+        {
+            recording->AddChecksum(step, StateChecksum(world, state));
+            if (!recording->Save(record_path))
+                printf("Could not write recording %s\n", record_path.c_str());
+            delete recording;
+        }
+
+        if (world->LevelCompleted())
+            ++completed;
+        else if (world->PlayersDead())
+            ++failed;
+        total_steps += step;
+
+        delete world;
+        delete input;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("level %u, %u rounds from seed %llu: %u completed, %u failed, %u timed out\n",
+           level, rounds, (unsigned long long)seed, completed, failed, rounds - completed - failed);
+    printf("%lu steps in %.3f s (%.0f steps/s, %.1f rounds/s, %.0fx real time)\n", total_steps, seconds,
+           seconds > 0 ? total_steps / seconds : 0.0, seconds > 0 ? rounds / seconds : 0.0,
+           seconds > 0 ? total_steps * SIMULATION_STEP_LENGTH / (seconds * 1000) : 0.0);
+    printf("%lu heap allocations during steps (%.4f per step)\n", step_allocations,
+           total_steps > 0 ? (double)step_allocations / total_steps : 0.0);
+    if (!replay_path.empty())
+    {
+        printf("slowest step %lu took %.1f us\n", slowest_step_number, slowest_step * 1e6);
+        printf("%u of %u rounds went apart from the %lu recorded steps\n", desyncs, rounds, replay.GetSteps());
+    }
+
+    return 0;
+}
@@ -0,0 +1,11 @@
+#ifndef ENEMYCONSTANTS_H_INCLUDED
+#define ENEMYCONSTANTS_H_INCLUDED
+
+static const unsigned int ENEMY_THREE_CHASE_DISTANCE = 4; // walking distance in tiles from which a player is chased
+static const unsigned long ENEMY_THREAT_HORIZON = 1500; // milliseconds before an explosion in which its tiles are avoided
+static const unsigned int ENEMY_PARALLEL_CHUNK = 256; // enemies updated by one job, a multiple of 32 so touch masks are not shared
+static const unsigned int ENEMY_PARALLEL_MIN = 1024; // fewer enemies are updated on the calling thread only
+static const unsigned int ENEMY_GRID_BUCKETS_MIN = 256; // buckets of the grid of enemies, grown with the map up to
+static const unsigned int ENEMY_GRID_BUCKETS_MAX = 4096; // so a query of the view looks at a small part of a large map
+
+#endif // ENEMYCONSTANTS_H_INCLUDED
@@ -0,0 +1,31 @@
+#ifndef NETWORKCONSTANTS_H_INCLUDED
+#define NETWORKCONSTANTS_H_INCLUDED
+
+#include <cstdint>
+
+static const unsigned int NETWORK_INPUT_DELAY = 2; // steps between reading the buttons and using them
+static const unsigned int NETWORK_MAX_ROLLBACK = 16; // steps played on predicted buttons before waiting for the peer
+static const unsigned int NETWORK_HISTORY = 64; // steps of buttons and states kept, power of two
+static const unsigned int NETWORK_MAX_INPUTS = 64; // buttons of at most this many steps in one packet
+static const unsigned int NETWORK_PACKET_SIZE = 1200; // bytes of the largest packet, below the usual MTU
+static const unsigned int NETWORK_SYNC_INTERVAL = 20; // steps between two checks whether to wait for the peer
+static const unsigned int NETWORK_CHECKSUM_INTERVAL = 50; // steps between two compared state checksums
+static const unsigned int NETWORK_CHECKSUMS = 8; // own checksums kept for comparing
+static const unsigned int NETWORK_FINISH_PACKETS = 5; // packets sent after the level ends
+static const unsigned int NETWORK_SHIM_PACKETS = 256; // packets held back by the latency shim
+
+static const unsigned int SERVER_MATCH_PLAYERS = 2; // players of every match hosted by a server
+static const unsigned int SERVER_STATE_INTERVAL = 2; // steps between two states sent to the clients
+static const unsigned int SERVER_CLIENT_TIMEOUT = 500; // steps without packets after which a seat is freed
+static const uint32_t SERVER_CLIENT_MAGIC = 0x534E4D42; // "BMNS", starts the buttons a client sends
+static const uint32_t SERVER_STATE_MAGIC = 0x544E4D42; // "BMNT", starts the state a server sends
+static const uint32_t SERVER_WATCH_MAGIC = 0x574E4D42; // "BMNW", starts the snapshot a spectator acknowledges
+static const uint32_t SERVER_VIEW_MAGIC = 0x564E4D42; // "BMNV", starts the snapshot a server sends a spectator
+static const unsigned int SERVER_VIEW_HEADER = 16; // bytes of magic, match, base step, step, part and parts before a part of a snapshot
+static const unsigned int SERVER_VIEW_PART_SIZE = NETWORK_PACKET_SIZE - SERVER_VIEW_HEADER; // bytes of a snapshot in one packet
+static const unsigned int SERVER_VIEW_PARTS = 64; // packets a snapshot is split into at most, about 75 kB, larger ones are not sent
+static const uint32_t SERVER_NO_BASE = 0xFFFFFFFF; // step of the base of a snapshot written in full
+static const unsigned int SERVER_SNAPSHOTS = 32; // snapshots kept per watched match for deltas
+static const unsigned int SERVER_MAX_SPECTATORS = 256; // spectators of one match
+
+#endif // NETWORKCONSTANTS_H_INCLUDED
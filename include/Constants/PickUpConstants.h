@@ -35,4 +35,8 @@ static const unsigned int VALUE_PICKUP_DAMAGE_DECREASE = 25;
 
 static const unsigned int NUMBER_OF_PICKUPS = 8;
 
+static const unsigned int PICKUP_GRID_BUCKETS_MIN = 256; // buckets of the grid of pickups, grown with the map up to
+static const unsigned int PICKUP_GRID_BUCKETS_MAX = 4096; // so a query looks at a small part of a large map
+static const unsigned int PICKUP_TOUCH_CANDIDATES = 16; // room for pickups near one player before it allocates
+
 #endif // PICKUPCONSTANTS_H_INCLUDED
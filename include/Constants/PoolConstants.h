@@ -0,0 +1,7 @@
+#ifndef POOLCONSTANTS_H_INCLUDED
+#define POOLCONSTANTS_H_INCLUDED
+
+static const unsigned int POOL_BOMB_CAPACITY = 64; // bombs on the map at the same time
+static const unsigned int POOL_EXPLOSION_CAPACITY = 128; // explosions being animated at the same time
+
+#endif // POOLCONSTANTS_H_INCLUDED
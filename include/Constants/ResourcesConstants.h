@@ -24,4 +24,6 @@ static const std::string RESOURCES_LEVEL_PLAYER     = "player";
 static const std::string RESOURCES_LEVEL_PLAYER_EXT = ".txt";
 static const unsigned int RESOURCES_LEVEL_COUNT     = 10;
 
+static const std::string RESOURCES_RECORDING_PATH   = "last-recording.txt"; // buttons of the last level played
+
 #endif // RESOURCESCONSTANTS_H_INCLUDED
@@ -0,0 +1,13 @@
+#ifndef SIMULATIONCONSTANTS_H_INCLUDED
+#define SIMULATIONCONSTANTS_H_INCLUDED
+
+static const unsigned int SIMULATION_STEP_LENGTH = 10; // milliseconds of game time in one step
+static const unsigned int SIMULATION_MAX_STEPS_PER_FRAME = 25; // steps are dropped after a longer hitch
+static const unsigned long RECORDING_CHECKSUM_INTERVAL = 50; // steps between two state checksums of a recording
+
+// Ids of the random streams derived from the seed of the World
+static const unsigned long RANDOM_STREAM_MAP_TILES = 1; // looks of the map tiles
+static const unsigned long RANDOM_STREAM_PICKUPS = 2; // pickups left by destroyed walls
+static const unsigned long RANDOM_STREAM_ENEMIES = 256; // plus the number of the enemy in the level file
+
+#endif // SIMULATIONCONSTANTS_H_INCLUDED
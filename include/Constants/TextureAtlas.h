@@ -0,0 +1,154 @@
+#ifndef TEXTUREATLAS_H_INCLUDED
+#define TEXTUREATLAS_H_INCLUDED
+
+/* Generated by tools/AtlasGenerator.cpp from resources/atlas.txt,
+   edit the manifest and run make -f Makefile.headless atlas */
+
+#include <SDL2/SDL.h>
+
+/* Sprites of the game texture */
+enum AtlasSprite : unsigned char
+{
+    ATLAS_PLAYER_ONE = 0,
+    ATLAS_PLAYER_TWO = 1,
+    ATLAS_ENEMY_ONE = 2,
+    ATLAS_ENEMY_TWO = 3,
+    ATLAS_ENEMY_THREE = 4,
+    ATLAS_BOMB = 5,
+    ATLAS_EXPLOSION = 6,
+    ATLAS_MAP_EMPTY = 7,
+    ATLAS_MAP_INDESTRUCTIBLE = 8,
+    ATLAS_MAP_DESTRUCTIBLE = 9,
+    ATLAS_PICKUP = 10,
+    ATLAS_LIVES = 11,
+    ATLAS_SPRITE_COUNT = 12
+};
+
+static const unsigned int ATLAS_PLAYER_ONE_DIRECTIONS = 4;
+static const unsigned int ATLAS_PLAYER_ONE_PHASES = 3;
+static const unsigned int ATLAS_PLAYER_TWO_DIRECTIONS = 4;
+static const unsigned int ATLAS_PLAYER_TWO_PHASES = 3;
+static const unsigned int ATLAS_ENEMY_ONE_DIRECTIONS = 1;
+static const unsigned int ATLAS_ENEMY_ONE_PHASES = 3;
+static const unsigned int ATLAS_ENEMY_TWO_DIRECTIONS = 1;
+static const unsigned int ATLAS_ENEMY_TWO_PHASES = 3;
+static const unsigned int ATLAS_ENEMY_THREE_DIRECTIONS = 1;
+static const unsigned int ATLAS_ENEMY_THREE_PHASES = 7;
+static const unsigned int ATLAS_BOMB_DIRECTIONS = 1;
+static const unsigned int ATLAS_BOMB_PHASES = 3;
+static const unsigned int ATLAS_EXPLOSION_DIRECTIONS = 1;
+static const unsigned int ATLAS_EXPLOSION_PHASES = 74;
+static const unsigned int ATLAS_MAP_EMPTY_DIRECTIONS = 4;
+static const unsigned int ATLAS_MAP_EMPTY_PHASES = 1;
+static const unsigned int ATLAS_MAP_INDESTRUCTIBLE_DIRECTIONS = 4;
+static const unsigned int ATLAS_MAP_INDESTRUCTIBLE_PHASES = 1;
+static const unsigned int ATLAS_MAP_DESTRUCTIBLE_DIRECTIONS = 4;
+static const unsigned int ATLAS_MAP_DESTRUCTIBLE_PHASES = 4;
+static const unsigned int ATLAS_PICKUP_DIRECTIONS = 8;
+static const unsigned int ATLAS_PICKUP_PHASES = 1;
+static const unsigned int ATLAS_LIVES_DIRECTIONS = 1;
+static const unsigned int ATLAS_LIVES_PHASES = 10;
+
+/* Where the frames of a sprite start in ATLAS_FRAMES */
+struct AtlasSpriteInfo
+{
+    unsigned short first;
+    unsigned char directions;
+    unsigned char phases;
+};
+
+static constexpr AtlasSpriteInfo ATLAS_SPRITES[ATLAS_SPRITE_COUNT] =
+{
+    {0, 4, 3}, // player_one
+    {12, 4, 3}, // player_two
+    {24, 1, 3}, // enemy_one
+    {27, 1, 3}, // enemy_two
+    {30, 1, 7}, // enemy_three
+    {37, 1, 3}, // bomb
+    {40, 1, 74}, // explosion
+    {114, 4, 1}, // map_empty
+    {118, 4, 1}, // map_indestructible
+    {122, 4, 4}, // map_destructible
+    {138, 8, 1}, // pickup
+    {146, 1, 10}, // lives
+};
+
+/* Source rectangles of all frames, phases of a direction follow each other */
+static constexpr SDL_Rect ATLAS_FRAMES[156] =
+{
+    // player_one
+    {147, 4, 18, 32}, {171, 4, 18, 32}, {195, 4, 18, 32},
+    {219, 4, 18, 32}, {243, 4, 18, 32}, {267, 4, 18, 32},
+    {75, 4, 18, 32}, {99, 4, 18, 32}, {123, 4, 18, 32},
+    {3, 4, 18, 32}, {27, 4, 18, 32}, {51, 4, 18, 32},
+    // player_two
+    {715, 4, 18, 32}, {739, 4, 18, 32}, {763, 4, 18, 32},
+    {787, 4, 18, 32}, {811, 4, 18, 32}, {835, 4, 18, 32},
+    {643, 4, 18, 32}, {667, 4, 18, 32}, {691, 4, 18, 32},
+    {571, 4, 18, 32}, {595, 4, 18, 32}, {619, 4, 18, 32},
+    // enemy_one
+    {1, 183, 20, 25}, {26, 183, 20, 25}, {51, 183, 20, 25},
+    // enemy_two
+    {0, 159, 24, 26}, {24, 159, 24, 26}, {48, 159, 24, 26},
+    // enemy_three
+    {0, 256, 24, 25}, {24, 256, 24, 25}, {48, 256, 24, 25}, {72, 256, 24, 25}, {96, 256, 24, 25}, {120, 256, 24, 25},
+    {144, 256, 24, 25},
+    // bomb
+    {352, 1, 23, 23}, {328, 1, 23, 23}, {304, 1, 23, 23},
+    // explosion
+    {0, 286, 100, 100}, {100, 286, 100, 100}, {200, 286, 100, 100}, {300, 286, 100, 100}, {400, 286, 100, 100}, {500, 286, 100, 100},
+    {600, 286, 100, 100}, {700, 286, 100, 100}, {800, 286, 100, 100}, {0, 386, 100, 100}, {100, 386, 100, 100}, {200, 386, 100, 100},
+    {300, 386, 100, 100}, {400, 386, 100, 100}, {500, 386, 100, 100}, {600, 386, 100, 100}, {700, 386, 100, 100}, {800, 386, 100, 100},
+    {0, 486, 100, 100}, {100, 486, 100, 100}, {200, 486, 100, 100}, {300, 486, 100, 100}, {400, 486, 100, 100}, {500, 486, 100, 100},
+    {600, 486, 100, 100}, {700, 486, 100, 100}, {800, 486, 100, 100}, {0, 586, 100, 100}, {100, 586, 100, 100}, {200, 586, 100, 100},
+    {300, 586, 100, 100}, {400, 586, 100, 100}, {500, 586, 100, 100}, {600, 586, 100, 100}, {700, 586, 100, 100}, {800, 586, 100, 100},
+    {0, 686, 100, 100}, {100, 686, 100, 100}, {200, 686, 100, 100}, {300, 686, 100, 100}, {400, 686, 100, 100}, {500, 686, 100, 100},
+    {600, 686, 100, 100}, {700, 686, 100, 100}, {800, 686, 100, 100}, {0, 786, 100, 100}, {100, 786, 100, 100}, {200, 786, 100, 100},
+    {300, 786, 100, 100}, {400, 786, 100, 100}, {500, 786, 100, 100}, {600, 786, 100, 100}, {700, 786, 100, 100}, {800, 786, 100, 100},
+    {0, 886, 100, 100}, {100, 886, 100, 100}, {200, 886, 100, 100}, {300, 886, 100, 100}, {400, 886, 100, 100}, {500, 886, 100, 100},
+    {600, 886, 100, 100}, {700, 886, 100, 100}, {800, 886, 100, 100}, {0, 986, 100, 100}, {100, 986, 100, 100}, {200, 986, 100, 100},
+    {300, 986, 100, 100}, {400, 986, 100, 100}, {500, 986, 100, 100}, {600, 986, 100, 100}, {700, 986, 100, 100}, {800, 986, 100, 100},
+    {0, 1086, 100, 100}, {100, 1086, 100, 100},
+    // map_empty
+    {900, 256, 64, 64},
+    {1028, 256, 64, 64},
+    {1156, 256, 64, 64},
+    {1284, 256, 64, 64},
+    // map_indestructible
+    {900, 384, 64, 64},
+    {1028, 384, 64, 64},
+    {1156, 384, 64, 64},
+    {1284, 384, 64, 64},
+    // map_destructible
+    {900, 0, 64, 64}, {900, 64, 64, 64}, {900, 128, 64, 64}, {900, 192, 64, 64},
+    {1028, 0, 64, 64}, {1028, 64, 64, 64}, {1028, 128, 64, 64}, {1028, 192, 64, 64},
+    {1156, 0, 64, 64}, {1156, 64, 64, 64}, {1156, 128, 64, 64}, {1156, 192, 64, 64},
+    {1284, 0, 64, 64}, {1284, 64, 64, 64}, {1284, 128, 64, 64}, {1284, 192, 64, 64},
+    // pickup
+    {920, 454, 190, 190},
+    {96, 77, 24, 24},
+    {48, 77, 24, 24},
+    {0, 77, 24, 24},
+    {192, 77, 24, 24},
+    {120, 77, 24, 24},
+    {72, 77, 24, 24},
+    {24, 77, 24, 24},
+    // lives
+    {200, 175, 12, 15}, {212, 175, 12, 15}, {224, 175, 12, 15}, {236, 175, 12, 15}, {248, 175, 12, 15}, {260, 175, 12, 15},
+    {272, 175, 12, 15}, {284, 175, 12, 15}, {296, 175, 12, 15}, {308, 175, 12, 15},
+};
+
+/**
+ *  \brief Gives the source rectangle of a frame of a sprite.
+ *
+ *  \param sprite sprite from the manifest
+ *  \param direction direction of the sprite, below its _DIRECTIONS
+ *  \param phase animation phase, below its _PHASES
+ *  \return the rectangle in the game texture
+ */
+static constexpr const SDL_Rect& AtlasFrame(AtlasSprite sprite, unsigned int direction, unsigned int phase)
+{
+    return ATLAS_FRAMES[ATLAS_SPRITES[sprite].first + direction*ATLAS_SPRITES[sprite].phases + phase];
+}
+
+#endif // TEXTUREATLAS_H_INCLUDED
@@ -1,14 +1,7 @@
 #ifndef TEXTUREBOMBCONSTANTS_H_INCLUDED
 #define TEXTUREBOMBCONSTANTS_H_INCLUDED
 
-/* Bomb Textures */
-static const unsigned int TEXTURE_BOMB_H = 23;
-static const unsigned int TEXTURE_BOMB_W = 23;
-static const unsigned int TEXTURE_BOMB_X = 352;
-static const unsigned int TEXTURE_BOMB_Y = 1;
-static const unsigned int TEXTURE_BOMB_COUNT = 3;
-static const unsigned int TEXTURE_BOMB_OFFSET_X = -24;
-static const unsigned int TEXTURE_BOMB_OFFSET_Y = 0;
+/* Bomb Textures, frames are in TextureAtlas.h */
 static const double BOMB_SIZE_RELATIVE_TO_TILE_SIZE = 0.625;
 
 #endif // TEXTUREBOMBCONSTANTS_H_INCLUDED
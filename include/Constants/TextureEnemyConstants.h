@@ -1,40 +1,18 @@
 #ifndef TEXTUREENEMYCONSTANTS_H_INCLUDED
 #define TEXTUREENEMYCONSTANTS_H_INCLUDED
 
+/* Sizes of the enemies, frames are in TextureAtlas.h */
+
 /* EnemyOne Textures */
 static const unsigned int TEXTURE_ENEMY_ONE_SIZE_W = 17;
 static const unsigned int TEXTURE_ENEMY_ONE_SIZE_H = 23;
-static const unsigned int TEXTURE_ENEMY_ONE_SOURCE_W = 20;
-static const unsigned int TEXTURE_ENEMY_ONE_SOURCE_H = 25;
-static const unsigned int TEXTURE_ENEMY_ONE_X = 1;
-static const unsigned int TEXTURE_ENEMY_ONE_Y = 183;
-static const unsigned int TEXTURE_ENEMY_ONE_SOURCE_CONST = 5;
-static const unsigned int TEXTURE_ENEMY_ONE_TEXTURE_OFFSET =
-        TEXTURE_ENEMY_ONE_SOURCE_CONST + TEXTURE_ENEMY_ONE_SOURCE_W;
-static const unsigned int TEXTURE_ENEMY_ONE_COUNT = 3;
 
 /* EnemyTwo Textures */
 static const unsigned int TEXTURE_ENEMY_TWO_SIZE_W = 17;
 static const unsigned int TEXTURE_ENEMY_TWO_SIZE_H = 23;
-static const unsigned int TEXTURE_ENEMY_TWO_SOURCE_W = 24;
-static const unsigned int TEXTURE_ENEMY_TWO_SOURCE_H = 26;
-static const unsigned int TEXTURE_ENEMY_TWO_X = 0;
-static const unsigned int TEXTURE_ENEMY_TWO_Y = 159;
-static const unsigned int TEXTURE_ENEMY_TWO_SOURCE_CONST = 0;
-static const unsigned int TEXTURE_ENEMY_TWO_TEXTURE_OFFSET =
-        TEXTURE_ENEMY_TWO_SOURCE_CONST + TEXTURE_ENEMY_TWO_SOURCE_W;
-static const unsigned int TEXTURE_ENEMY_TWO_COUNT = 3;
 
 /* EnemyThree Textures */
 static const unsigned int TEXTURE_ENEMY_THREE_SIZE_W = 17;
 static const unsigned int TEXTURE_ENEMY_THREE_SIZE_H = 23;
-static const unsigned int TEXTURE_ENEMY_THREE_SOURCE_W = 24;
-static const unsigned int TEXTURE_ENEMY_THREE_SOURCE_H = 25;
-static const unsigned int TEXTURE_ENEMY_THREE_X = 0;
-static const unsigned int TEXTURE_ENEMY_THREE_Y = 256;
-static const unsigned int TEXTURE_ENEMY_THREE_SOURCE_CONST = 0;
-static const unsigned int TEXTURE_ENEMY_THREE_TEXTURE_OFFSET =
-        TEXTURE_ENEMY_THREE_SOURCE_CONST + TEXTURE_ENEMY_THREE_SOURCE_W;
-static const unsigned int TEXTURE_ENEMY_THREE_COUNT = 7;
 
 #endif // TEXTUREENEMYCONSTANTS_H_INCLUDED
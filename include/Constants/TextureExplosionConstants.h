@@ -1,17 +1,7 @@
 #ifndef TEXTUREEXPLOSIONCONSTANTS_H_INCLUDED
 #define TEXTUREEXPLOSIONCONSTANTS_H_INCLUDED
 
-/* Explosion */
-static const unsigned int TEXTURE_EXPLOSION_H = 100;
-static const unsigned int TEXTURE_EXPLOSION_W = 100;
-static const unsigned int TEXTURE_EXPLOSION_X = 0;
-static const unsigned int TEXTURE_EXPLOSION_Y = 286;
-static const unsigned int TEXTURE_EXPLOSION_COUNT = 74;
-static const unsigned int TEXTURE_EXPLOSION_OFFSET_X = 100;
-static const unsigned int TEXTURE_EXPLOSION_OFFSET_Y = 0;
-static const unsigned int TEXTURE_EXPLOSION_LINE_COUNT = 9;
-static const unsigned int TEXTURE_EXPLOSION_LINE_OFFSET_X = 0;
-static const unsigned int TEXTURE_EXPLOSION_LINE_OFFSET_Y = 100;
+/* Explosion, frames are in TextureAtlas.h */
 static const unsigned int EXPLOSION_ANIMATION_LENGTH = 1000;
 
 #endif // TEXTUREEXPLOSIONCONSTANTS_H_INCLUDED
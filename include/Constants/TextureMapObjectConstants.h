@@ -1,33 +0,0 @@
-#ifndef TEXTUREMAPOBJECTCONSTANTS_H_INCLUDED
-#define TEXTUREMAPOBJECTCONSTANTS_H_INCLUDED
-
-/* Map Textures */
-/* MapObject::EMPTY */
-static const unsigned int TEXTURE_MAP_EMPTY_H = 64;
-static const unsigned int TEXTURE_MAP_EMPTY_W = 64;
-static const unsigned int TEXTURE_MAP_EMPTY_X = 900;
-static const unsigned int TEXTURE_MAP_EMPTY_Y = 256;
-static const unsigned int TEXTURE_MAP_EMPTY_KIND_COUNT = 4;
-static const unsigned int TEXTURE_MAP_EMPTY_KIND_OFFSET_X = 128;
-static const unsigned int TEXTURE_MAP_EMPTY_KIND_OFFSET_Y = 0;
-/* MapObject::INDESTRUCTIBLE_WALL */
-static const unsigned int TEXTURE_MAP_INDESTRUCTIBLE_H = 64;
-static const unsigned int TEXTURE_MAP_INDESTRUCTIBLE_W = 64;
-static const unsigned int TEXTURE_MAP_INDESTRUCTIBLE_X = 900;
-static const unsigned int TEXTURE_MAP_INDESTRUCTIBLE_Y = 384;
-static const unsigned int TEXTURE_MAP_INDESTRUCTIBLE_KIND_COUNT = 4;
-static const unsigned int TEXTURE_MAP_INDESTRUCTIBLE_KIND_OFFSET_X = 128;
-static const unsigned int TEXTURE_MAP_INDESTRUCTIBLE_KIND_OFFSET_Y = 0;
-/* MapObject::DESTRUCTIBLE_WALL */
-static const unsigned int TEXTURE_MAP_DESTRUCTIBLE_H = 64;
-static const unsigned int TEXTURE_MAP_DESTRUCTIBLE_W = 64;
-static const unsigned int TEXTURE_MAP_DESTRUCTIBLE_X = 900;
-static const unsigned int TEXTURE_MAP_DESTRUCTIBLE_Y = 0;
-static const unsigned int TEXTURE_MAP_DESTRUCTIBLE_KIND_COUNT = 4;
-static const unsigned int TEXTURE_MAP_DESTRUCTIBLE_KIND_OFFSET_X = 128;
-static const unsigned int TEXTURE_MAP_DESTRUCTIBLE_KIND_OFFSET_Y = 0;
-static const unsigned int TEXTURE_MAP_DESTRUCTIBLE_INTEGRITY_COUNT = 4;
-static const unsigned int TEXTURE_MAP_DESTRUCTIBLE_INTEGRITY_OFFSET_X = 0;
-static const unsigned int TEXTURE_MAP_DESTRUCTIBLE_INTEGRITY_OFFSET_Y = 64;
-
-#endif // TEXTUREMAPOBJECTCONSTANTS_H_INCLUDED
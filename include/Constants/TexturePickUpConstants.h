@@ -1,53 +0,0 @@
-#ifndef TEXTUREPICKUPCONSTANTS_H_INCLUDED
-#define TEXTUREPICKUPCONSTANTS_H_INCLUDED
-
-/* PickUp Textures */
-/* EXIT pickup */
-static const unsigned int TEXTURE_PICKUP_EXIT_H = 190; //24
-static const unsigned int TEXTURE_PICKUP_EXIT_W = 190; //24
-static const unsigned int TEXTURE_PICKUP_EXIT_X = 920; //0
-static const unsigned int TEXTURE_PICKUP_EXIT_Y = 454; //101
-
-/* SPEED pickup */
-static const unsigned int TEXTURE_PICKUP_SPEED_H = 24;
-static const unsigned int TEXTURE_PICKUP_SPEED_W = 24;
-static const unsigned int TEXTURE_PICKUP_SPEED_X = 96;
-static const unsigned int TEXTURE_PICKUP_SPEED_Y = 77;
-
-/* EXIT pickup */
-static const unsigned int TEXTURE_PICKUP_BOMB_H = 24;
-static const unsigned int TEXTURE_PICKUP_BOMB_W = 24;
-static const unsigned int TEXTURE_PICKUP_BOMB_X = 48;
-static const unsigned int TEXTURE_PICKUP_BOMB_Y = 77;
-
-/* DAMAGE pickup */
-static const unsigned int TEXTURE_PICKUP_DAMAGE_H = 24;
-static const unsigned int TEXTURE_PICKUP_DAMAGE_W = 24;
-static const unsigned int TEXTURE_PICKUP_DAMAGE_X = 0;
-static const unsigned int TEXTURE_PICKUP_DAMAGE_Y = 77;
-
-/* LIFE pickup */
-static const unsigned int TEXTURE_PICKUP_LIFE_H = 24;
-static const unsigned int TEXTURE_PICKUP_LIFE_W = 24;
-static const unsigned int TEXTURE_PICKUP_LIFE_X = 192;
-static const unsigned int TEXTURE_PICKUP_LIFE_Y = 77;
-
-/* SPEED_DECREASE pickup */
-static const unsigned int TEXTURE_PICKUP_SPEED_DECREASE_H = 24;
-static const unsigned int TEXTURE_PICKUP_SPEED_DECREASE_W = 24;
-static const unsigned int TEXTURE_PICKUP_SPEED_DECREASE_X = 120;
-static const unsigned int TEXTURE_PICKUP_SPEED_DECREASE_Y = 77;
-
-/* BOMB_DECREASE pickup */
-static const unsigned int TEXTURE_PICKUP_BOMB_DECREASE_H = 24;
-static const unsigned int TEXTURE_PICKUP_BOMB_DECREASE_W = 24;
-static const unsigned int TEXTURE_PICKUP_BOMB_DECREASE_X = 72;
-static const unsigned int TEXTURE_PICKUP_BOMB_DECREASE_Y = 77;
-
-/* DAMAGE_DECREASE pickup */
-static const unsigned int TEXTURE_PICKUP_DAMAGE_DECREASE_H = 24;
-static const unsigned int TEXTURE_PICKUP_DAMAGE_DECREASE_W = 24;
-static const unsigned int TEXTURE_PICKUP_DAMAGE_DECREASE_X = 24;
-static const unsigned int TEXTURE_PICKUP_DAMAGE_DECREASE_Y = 77;
-
-#endif // TEXTUREPICKUPCONSTANTS_H_INCLUDED
@@ -1,10 +0,0 @@
-#ifndef TEXTURESCORECONSTANTS_H_INCLUDED
-#define TEXTURESCORECONSTANTS_H_INCLUDED
-
-/* Numb Textures */
-static const unsigned int TEXTURE_NUMB_SOURCE_W = 12;
-static const unsigned int TEXTURE_NUMB_SOURCE_H = 15;
-static const unsigned int TEXTURE_NUMB_X = 200;
-static const unsigned int TEXTURE_NUMB_Y = 175;
-
-#endif // TEXTURESCORECONSTANTS_H_INCLUDED
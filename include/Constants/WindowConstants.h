@@ -9,4 +9,7 @@ static const unsigned int MAP_COLUMN_COUNT = 25;
 //static const unsigned int WINDOW_HEIGHT = MAP_TILE_SIZE * MAP_ROW_COUNT;
 static const unsigned int WINDOW_WIDTH = 1100;
 static const unsigned int WINDOW_HEIGHT = 660;
+
+// Sprites this far outside the view are still drawn, they may move into it
+static const unsigned int VIEW_MARGIN = MAP_TILE_SIZE;
 #endif // WINDOWCONSTANTS_H_INCLUDED
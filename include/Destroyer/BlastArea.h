@@ -0,0 +1,24 @@
+#ifndef BLASTAREA_H
+#define BLASTAREA_H
+
+/**
+ *  \file BlastArea.h
+ *
+ *  Defines struct BlastArea which describes the area hit by one exploding
+ *  bomb
+ *
+ */
+
+/** \struct BlastArea
+ *  \brief Area hit by the explosion of one bomb.
+ *  \details Bombs that go off in the same tick are collected into a list of
+ *           these, so the managers can resolve all of them in one pass.
+ */
+struct BlastArea
+{
+    unsigned int    x;          /**< x coordinate of the center of the bomb */
+    unsigned int    y;          /**< y coordinate of the center of the bomb */
+    double          intensity;  /**< intensity of the bomb */
+};
+
+#endif // BLASTAREA_H
@@ -4,42 +4,48 @@
 /**
  *  \file Destroyer.h
  *
- *  Defines class EnemyDestroyer which is used to calculate the effects of
- *  Bomb's explosion on an Enemy or Player.
+ *  Defines class Destroyer which is used to calculate the effects of
+ *  Bomb's explosion on an enemy or Player.
  *
  */
 
-#include "Entity/Enemy.h"
 #include "Entity/Player.h"
 
 /** \class Destroyer
  *  \brief class for killing enemies and players
  *  \details This class is used to calculate the effects of Bomb's explosion on
- *           an Enemy or Player and decreases their health if necessary.
+ *           an enemy or Player and decreases their health if necessary.
  */
 class Destroyer
 {
     public:
 
-        /** \brief Calculates the effect of a Bomb on an Enemy
+        /** \brief Tells if a Bomb reaches a rectangle
          *
          * According to given parameters which represent center point of bomb's
-         * explosion and intensity determines whether it should damage the Enemy
-         * \param enemy pointer to Enemy for which the effect is calculated
+         * explosion and intensity determines whether the explosion reaches the
+         * center of the rectangle, which is how enemies are killed.
+         * \param x top left x coordinate of the rectangle
+         * \param y top left y coordinate of the rectangle
+         * \param w width of the rectangle
+         * \param h height of the rectangle
          * \param start_x x coordinate of explosion's point of origin
          * \param start_y y coordinate of explosion's point of origin
          * \param tile_size represents the size of one tile of the map in
          *        pixels
          * \param intensity real value which represents the intensity of the
          *        bomb's explosion
-         * \return void
+         * \return true if the explosion reaches the rectangle
          *
          */
-        static void DestroyEnemy(Enemy* enemy,
-                                 unsigned int start_x,
-                                 unsigned int start_y,
-                                 unsigned int tile_size,
-                                 double intensity);
+        static bool Reaches(unsigned int x,
+                            unsigned int y,
+                            unsigned int w,
+                            unsigned int h,
+                            unsigned int start_x,
+                            unsigned int start_y,
+                            unsigned int tile_size,
+                            double intensity);
 
         /** \brief Calculates the effect of a Bomb on a Player
          *
@@ -0,0 +1,128 @@
+#ifndef THREATMAP_H
+#define THREATMAP_H
+
+/**
+ *  \file ThreatMap.h
+ *
+ *  Defines class ThreatMap which tells for every tile of the map when the
+ *  bombs on the map will reach it
+ *
+ */
+
+#include "Destroyer/WallDestroyer.h"
+#include "Entity/Bomb.h"
+#include <vector>
+
+/** \class ThreatMap
+ *  \brief Class which keeps the time of the earliest explosion for every tile
+ *         of the map.
+ *  \details A tile is threatened by a bomb when its centre is inside the blast
+ *           circle of Destroyer::Reaches(), the same test which kills players
+ *           and enemies, so walls do not shelter anything. Which bombs set
+ *           each other off is worked out by WallDestroyer::Spread() with the
+ *           walls of the map as they are now, as in BombManager::Update(). A
+ *           bomb whose tile is reached by another bomb goes off together with
+ *           it, so the time of every bomb is the earliest of its own fuse and
+ *           the times of the bombs reaching it. Times are game times as given by SystemTimer,
+ *           so nothing has to be done while time passes: the tiles are only
+ *           written again when a bomb is placed or bombs explode, and then
+ *           only the tiles the bombs reach.
+ */
+class ThreatMap
+{
+    public:
+        static const unsigned long NEVER = (unsigned long)-1; /**< time of tiles no bomb reaches */
+
+        /**
+         *  \brief Constructor for ThreatMap
+         *
+         *  Makes a map with no bombs on it.
+         *  \param height height of the map in tiles
+         *  \param width width of the map in tiles
+         *  \param tile_size size of one tile in pixels
+         *  \param capacity largest number of bombs on the map at once
+         */
+        ThreatMap(unsigned int height, unsigned int width, unsigned int tile_size, unsigned int capacity);
+
+        /**
+         *  \brief Adds a newly placed bomb
+         *
+         *  \param bomb the bomb, must stay alive until Remove() is called
+         *  \param map map over which the bomb will explode
+         *  \return void
+         */
+        void Add(const Bomb* bomb, const Map* map);
+        /**
+         *  \brief Removes an exploded bomb
+         *
+         *  The times of the tiles are not changed until Refresh() is called.
+         *  \param bomb the bomb given to Add()
+         *  \return void
+         */
+        void Remove(const Bomb* bomb);
+        /**
+         *  \brief Works out the reach of all bombs again
+         *
+         *  Called once bombs are removed, as their explosions may have
+         *  destroyed walls which stopped the remaining bombs.
+         *  \param map map over which the bombs will explode
+         *  \return void
+         */
+        void Refresh(const Map* map);
+        /**
+         *  \brief Removes all bombs
+         *
+         *  \return void
+         */
+        void Clear();
+
+        /** \brief Gives game time at which the tile is reached by an explosion, NEVER if no bomb reaches it */
+        unsigned long GetTime(unsigned int i, unsigned int j) const
+        {
+            return i < m_height && j < m_width ? m_time[i*m_width + j] : NEVER;
+        }
+        /**
+         *  \brief Gives time left until the tile is reached by an explosion
+         *
+         *  \param i row of the tile
+         *  \param j column of the tile
+         *  \param now current game time
+         *  \return milliseconds left, 0 if the time has come and NEVER if no
+         *          bomb reaches the tile
+         */
+        unsigned long TimeUntilLethal(unsigned int i, unsigned int j, unsigned long now) const
+        {
+            unsigned long time = GetTime(i, j);
+            return time == NEVER ? NEVER : (time > now ? time - now : 0);
+        }
+
+    protected:
+
+    private:
+        /** \brief One bomb and the tiles its explosion reaches */
+        struct Entry
+        {
+            const Bomb*                 bomb;
+            unsigned int                tile; /**< tile of the bomb */
+            unsigned long               time; /**< time the bomb goes off, with chains */
+            bool                        done; /**< time is final while resolving */
+            std::vector<unsigned int>   reach; /**< tiles whose centre is inside the blast */
+            std::vector<unsigned int>   spread; /**< tiles the explosion spreads to, stopped by walls */
+        };
+
+        /** \brief Works out the tiles the explosion of the entry reaches and spreads to */
+        void Spread(Entry& entry, const Map* map);
+        /** \brief Works out the times of the bombs and writes them to the tiles */
+        void Resolve();
+
+        unsigned int                m_height;
+        unsigned int                m_width;
+        unsigned int                m_tile_size;
+        std::vector<unsigned long>  m_time;
+        std::vector<Entry>          m_entries; /**< first m_count are used, the rest keep their memory */
+        unsigned int                m_count;
+        std::vector<unsigned int>   m_written; /**< tiles with a time, cleared before writing again */
+        WallDestroyer               m_wall_destroyer;
+};
+
+#endif // THREATMAP_H
@@ -9,73 +9,124 @@
  */
 
 #include "Manager/Map.h"
+#include <vector>
+
+/** \brief Largest reach in tiles for which offset tables are shared */
+static const int WALL_DESTROYER_TABLE_REACH = 8;
 
 /** \class WallDestroyer
  *  \brief class for destroying walls on the map
  *  \details This class is used to calculate the effects of bomb explosions and
  *           makes changes to the map in the game.
- *           Contains an algorithm for traversing the map and making required
- *           changes.
+ *           The explosion spreads from the tile of the bomb along the four
+ *           axes and into the four quadrants between them, always moving away
+ *           from the bomb, through empty tiles whose center is within its
+ *           radius. Walls it reaches are damaged and stop it. Tiles are taken
+ *           from a table of offsets ordered so that every tile comes after the
+ *           tiles the explosion could reach it from, so the whole blast is
+ *           worked out in one pass in which every tile is looked at once.
  */
 class WallDestroyer
 {
     public:
+        /** \brief Position of a tile on the map */
+        struct Position
+        {
+            int row;
+            int col;
+        };
+
         /**
          *  \brief Constructor for WallDestroyer
          *
-         *  Makes an object of class WallDestroyer according to given attributes
+         *  Makes an object of class WallDestroyer according to given attributes.
+         *  The object can be used for any number of explosions, the memory it
+         *  needs is kept between them.
+         *  \param tile_size pixel size of one tile on the map
+         */
+        WallDestroyer(unsigned int tile_size);
+
+        /**
+         *  \brief Applies an explosion to the map
+         *
          *  \param level pointer to object Map to which it will make changes
          *  \param start_x x coordinate of explosion
          *  \param start_y y coordinate of explosion
-         *  \param tile_size pixel size of one tile on the map
          *  \param intensity real value of explosion's size and effect it will
          *         make (1.0 is radius of one tile size of the map)
          *  \param damage value in percent that the bomb will do to a wall
+         *  \return reference to the list of tiles reached by the explosion,
+         *          same as GetAffectedTiles()
          */
-        WallDestroyer(Map* level,
-                      unsigned int start_x,
-                      unsigned int start_y,
-                      unsigned int tile_size,
-                      double intensity,
-                      unsigned int damage);
+        const std::vector<Position>& Explode(Map* level,
+                                             unsigned int start_x,
+                                             unsigned int start_y,
+                                             double intensity,
+                                             unsigned int damage);
+        /**
+         *  \brief Works out where an explosion would spread without changing
+         *         the map
+         *
+         *  \param level pointer to object Map over which the explosion spreads
+         *  \param start_x x coordinate of explosion
+         *  \param start_y y coordinate of explosion
+         *  \param intensity real value of explosion's size (1.0 is radius of
+         *         one tile size of the map)
+         *  \return reference to the list of tiles the explosion would reach,
+         *          same as GetAffectedTiles()
+         */
+        const std::vector<Position>& Spread(const Map* level,
+                                            unsigned int start_x,
+                                            unsigned int start_y,
+                                            double intensity);
+        /**
+         *  \brief Gives all tiles reached by the last explosion
+         *
+         *  Contains the tile of the bomb first, then every empty tile the
+         *  explosion spread over and every destructible wall it reached, each
+         *  once.
+         *  \return reference to the list of tiles
+         */
+        const std::vector<Position>& GetAffectedTiles() const { return m_affected; }
 
     protected:
 
+        /** \brief One entry of the offset table */
+        struct Offset
+        {
+            int     row;        /**< row offset from the tile of the bomb */
+            int     col;        /**< column offset from the tile of the bomb */
+            int     cell;       /**< index of the tile in the window around the bomb */
+            int     from[3];    /**< window cells it can be reached from, -1 if unused */
+        };
+
         /**
-         *  \brief Spreads the explosion to given tile of the map
+         *  \brief Gives the offset table for explosions reaching given number
+         *         of tiles
          *
-         *  Calculates whether the explosion will reach the adjacent tiles of
-         *  the given tile in the given direction
-         *  \param row id of row from which the explosion will spread
-         *  \param col id of column from which the explosion will spread
-         *  \param direction_row vertical direction of explosion (down=1, up=-1)
-         *  \param direction_col horizontal direction of explosion (right=1,
-         *         left=-1)
-         *  \return void
+         *  Tables up to WALL_DESTROYER_TABLE_REACH are made once and shared,
+         *  larger ones are made into the given storage.
+         *  \param reach largest row or column offset in the table
+         *  \param storage table used when no shared one exists
+         *  \return reference to the offset table
          */
-        void Spread(int row, int col, int direction_row, int direction_col) const;
+        static const std::vector<Offset>& OffsetTable(int reach, std::vector<Offset>& storage);
         /**
-         *  \brief Calculates the damage of explosion on given tile
+         *  \brief Makes the offset table for given reach
          *
-         *  Calculates the damage the explosion should do to the given tile and
-         *  applies the changes to the tile. Should only be called on MapObject
-         *  of type MapObject::DESTRUCTIBLE_WALL
-         *  \param row id of row for which the damage will be calculated
-         *  \param col id of column for which the damage will be calculated
+         *  \param reach largest row or column offset in the table
+         *  \param table vector which will be filled with the offsets
          *  \return void
          */
-        void Destroy(int row, int col) const;
+        static void MakeOffsetTable(int reach, std::vector<Offset>& table);
         /**
-         *  \brief Calculates the distance to center of given tile from the
-         *         point of origin of explosion
+         *  \brief Tells if the explosion reaches the center of given tile
          *
-         *  Calculates the distance from the center of the tile given by the
-         *  parameters to the point of origin of explosion.
-         *  \param row id of row for which the distance will be calculated
-         *  \param col id of column for which the distance will be calculated
-         *  \return void
+         *  \param row id of row of the tile
+         *  \param col id of column of the tile
+         *  \return true if the center of the tile is within the radius
          */
-        double DistanceToCenter(int row, int col) const;
+        bool InReach(int row, int col) const;
         /**
          *  \brief Return squared value of given integer value
          *
@@ -83,31 +134,16 @@ class WallDestroyer
          *  \param x number which will be squared
          *  \return values that is squared
          */
-        int Square(int x) const { return x*x; }
-        /**
-         *  \brief Checks whether the explosion should spread to the given tile
-         *         and if it does then spreads it.
-         *
-         *  First it determines whether the explosion reaches the given tile and
-         *  then based on the type of the tile calls either Spread() or
-         *  Destroy() with the same parameters it received.
-         *  \param new_row id of row for which the conditions will be calculated
-         *  \param new_col id of column for which the conditions will be
-         *         calculated
-         *  \param direction_row vertical direction of explosion (down=1, up=-1)
-         *  \param direction_col horizontal direction of explosion (right=1,
-         *         left=-1)
-         *  \return void
-         */
-        void CheckAndCall(int new_row, int new_col, int direction_row, int direction_col) const;
+        static int Square(int x) { return x*x; }
 
     private:
-        Map*            m_level;
-        unsigned int    m_start_x;
-        unsigned int    m_start_y;
-        unsigned int    m_tile_size;
-        double          m_intensity;
-        unsigned int    m_damage;
+        int                     m_tile_size;
+        int                     m_start_x;
+        int                     m_start_y;
+        double                  m_reach_squared; /**< squared radius in pixels */
+        std::vector<Position>   m_affected;
+        std::vector<bool>       m_open; /**< tiles of the window the explosion spreads through */
+        std::vector<Offset>     m_storage; /**< table for reaches without a shared one */
 
 };
 
@@ -0,0 +1,71 @@
+#ifndef CAMERA_H
+#define CAMERA_H
+
+/**
+ *  \file Camera.h
+ *
+ *  Defines class Camera which picks the part of the World that is shown on
+ *  the screen
+ *
+ */
+
+#include <SDL2/SDL.h>
+#include "Utility/Relay.h"
+
+/** \class Camera
+ *  \brief Class which moves a view of fixed size over the World
+ *  \details The view is centered on a target, either the players still in
+ *           the game or any point such as the one a spectator looks at, and
+ *           kept inside the map. A map smaller than the view is centered in
+ *           it instead. The Camera remembers where the view was before the
+ *           last move, so the view can be drawn between both places like
+ *           every other moving sprite.
+ *           A Camera is used by the thread taking the RenderSnapshots.
+ */
+class Camera
+{
+    public:
+        /**
+         *  \brief Constructor for Camera
+         *
+         *  \param width width of the view in pixels
+         *  \param height height of the view in pixels
+         */
+        Camera(unsigned int width, unsigned int height);
+
+        /**
+         *  \brief Centers the view on the players of a World
+         *
+         *  Looks at the middle of the players who are alive and have not
+         *  completed the level. If there are none the view stays where it
+         *  is.
+         *  \param relay Relay of the World
+         *  \return void
+         */
+        void Follow(Relay* relay);
+        /**
+         *  \brief Centers the view on a point of the World
+         *
+         *  \param x x coordinate of the point in pixels
+         *  \param y y coordinate of the point in pixels
+         *  \param world_width width of the World in pixels
+         *  \param world_height height of the World in pixels
+         *  \return void
+         */
+        void LookAt(int x, int y, unsigned int world_width, unsigned int world_height);
+
+        const SDL_Rect& GetView() const { return m_view; } /**< \brief Gives the view in the World */
+        int GetFromX() const { return m_from_x; } /**< \brief Gives x of the view before the last move */
+        int GetFromY() const { return m_from_y; } /**< \brief Gives y of the view before the last move */
+
+    private:
+        /** \brief Gives coordinate of the view along one axis, kept inside the World */
+        static int Place(int center, int view, int world);
+
+        SDL_Rect        m_view;
+        int             m_from_x;
+        int             m_from_y;
+        bool            m_placed; /**< false until the first move, which is not drawn as one */
+};
+
+#endif // CAMERA_H
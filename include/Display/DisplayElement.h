@@ -10,6 +10,7 @@
  */
 
 #include <SDL2/SDL.h>
+#include "Display/RenderSnapshot.h"
 //#include "Utility/Relay.h"
 
 /** \class DisplayElement
@@ -60,13 +61,13 @@ class DisplayElement
          *  \brief Draws the DisplayElement
          *
          *  Abstract method. This method should be redefined so that the
-         *  DisplayElement draws all its elements.
-         *  \param renderer represents the SDL_Renderer on which the object
-         *         will draw its elements.
+         *  DisplayElement adds all its elements to the snapshot, which is
+         *  drawn later, possibly by another thread.
+         *  \param snapshot snapshot to which the elements are added
          *
          *  \return void
          */
-        virtual void Draw(SDL_Renderer* renderer) const = 0;
+        virtual void Draw(RenderSnapshot& snapshot) const = 0;
 
     protected:
         SDL_Texture*    m_texture;
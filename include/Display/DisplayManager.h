@@ -31,14 +31,19 @@ class DisplayManager
          *
          *  Constructor is used for initializing base elements of DisplayManager
          *  as well as making special ExitDisplay for signaling when the program
-         *  should end and the first proper Display, the WelcomeDisplay.
+         *  should end and the first proper Display, the WelcomeDisplay unless
+         *  another one is given. The program ends when the first Display is
+         *  left.
+         *  \param first first Display to show instead of the WelcomeDisplay,
+         *         it is initialized and deleted by the DisplayManager
          *
          */
         DisplayManager(SDL_Texture* texture,
                        SDL_Renderer* renderer,
                        bool* running,
                        unsigned int window_width,
-                       unsigned int window_height);
+                       unsigned int window_height,
+                       Display* first = nullptr);
         /**
          *  \brief Destructor for DisplayManager
          *
@@ -11,9 +11,23 @@
  */
 
 #include "Display/Display.h"
-#include "Display/DisplayElement.h"
-#include "Utility/Relay.h"
+#include "Simulation/World.h"
+#include "Simulation/InputRecording.h"
+#include "Simulation/ScriptedInput.h"
+#include "Network/RollbackSession.h"
+#include "Network/NetworkOptions.h"
+#include "Network/UdpSocket.h"
+#include "Display/RenderSnapshot.h"
+#include "Display/SpriteBatch.h"
+#include "Display/MapLayer.h"
+#include "Display/Camera.h"
+#include "System/SystemTimer.h"
+#include "Utility/TripleBuffer.h"
+#include "Utility/StateBuffer.h"
+#include <thread>
+#include <atomic>
 #include <vector>
+#include <cstdint>
 
 /** \class GameDisplay
  *
@@ -23,11 +37,17 @@
  *          objects of the game such as manager classes which are
  *          specializations of DisplayElement class as well as Relay which is
  *          used for communicating between managers as well as being used by
- *          GameDisplay for reading current state of the game. GameDisplay has
- *          Update() and Draw() methods which periodically update all managers
- *          and draw them. Also keeps track whether this Display should be
- *          changed because of a specific user input such as quiting or pausing
- *          the game.
+ *          GameDisplay for reading current state of the game.
+ *          The World is stepped on a simulation thread of its own, with its
+ *          own SystemTimer, at the rate of SIMULATION_STEP_LENGTH no matter
+ *          how long drawing takes. After its steps the thread adds the World
+ *          to a RenderSnapshot and publishes it through a TripleBuffer, from
+ *          which Draw() takes the newest one, so neither thread ever waits
+ *          for the other. Update() runs on the main thread: it hands the
+ *          buttons held to the simulation thread and keeps track whether
+ *          this Display should be changed because the level ended or of a
+ *          specific user input such as quiting or pausing the game. The
+ *          thread only runs while the Display is shown.
  *
  */
  class GameDisplay : public Display
@@ -36,7 +56,7 @@
         /**
          *  \brief Constructor for GameDisplay
          *
-         *  Makes the PauseDisplay with the given parameters
+         *  Makes the World of the given level which holds all manager classes
          *  \param texture pointer to SDL_Texture from which the various game
          *         assets will be drawn and will be passed on to DisplayElement
          *         objects within GameDisplay
@@ -47,48 +67,71 @@
          *  \param players_number number of players that will be in the game
          *  \param current_level number of the level that is currently being
          *         played
-         *  \param number_of_screen_elements number of object of DisplayElement
-         *         that the GameDisplay will have (used only for reserving the
-         *         number elements and does not strictly limit the GameDisplay
-         *         for using more or less)
          */
         GameDisplay(SDL_Texture* texture,
                     SDL_Renderer* renderer,
                     unsigned int window_width,
                     unsigned int window_height,
                     unsigned int players_number,
-                    unsigned int current_level,
-                    unsigned int number_of_screen_elements = 6);
+                    unsigned int current_level);
         /**
-         *  \brief Destructor for GameDisplay
+         *  \brief Constructor for GameDisplay which replays a recording
          *
-         *  Destroys all DisplayElements that it was keeping track of as well
-         *  as Relay used for communicating between objects
+         *  Makes the World of the recorded level with the recorded seed and
+         *  plays the recorded buttons into it instead of the user's. The
+         *  Display is left when the recording ends.
+         *  \param texture pointer to SDL_Texture from which the various game
+         *         assets will be drawn
+         *  \param renderer represents the SDL_Renderer on which the Display
+         *         will be drawn on.
+         *  \param window_width width of the program's window in pixels
+         *  \param window_height height of the program's window in pixels
+         *  \param replay recording to play, must stay alive as long as the
+         *         GameDisplay
+         */
+        GameDisplay(SDL_Texture* texture,
+                    SDL_Renderer* renderer,
+                    unsigned int window_width,
+                    unsigned int window_height,
+                    InputRecording* replay);
+        /**
+         *  \brief Constructor for GameDisplay which plays against a peer
          *
+         *  Makes the World of the given level with two players and the given
+         *  seed, one of them steered on this device and the other by the
+         *  peer over the network through a RollbackSession. The Display is
+         *  left when the level ends.
+         *  \param texture pointer to SDL_Texture from which the various game
+         *         assets will be drawn
+         *  \param renderer represents the SDL_Renderer on which the Display
+         *         will be drawn on.
+         *  \param window_width width of the program's window in pixels
+         *  \param window_height height of the program's window in pixels
+         *  \param network level, seed and player of the game
+         *  \param socket socket opened towards the peer, must stay alive as
+         *         long as the GameDisplay
          */
-        ~GameDisplay();
-        GameDisplay(const GameDisplay& other) = delete; /**< \brief Default copy constructor is disabled */
-        GameDisplay& operator=(const GameDisplay&) = delete; /**< \brief Default operator = is disabled */
-
+        GameDisplay(SDL_Texture* texture,
+                    SDL_Renderer* renderer,
+                    unsigned int window_width,
+                    unsigned int window_height,
+                    const NetworkOptions& network,
+                    UdpSocket* socket);
         /**
-         *  \brief Adds a DisplayElement to the list of currently tracked
-         *         elements
+         *  \brief Destructor for GameDisplay
          *
-         *  DisplayElement added to this list will be periodically updated in
-         *  the Update() method. It will also be drawn by the Draw() method.
-         * \param display_element pointer of the element that will be tracked
-         * \return void
+         *  Destroys the World with all DisplayElements that it was keeping
+         *  track of
          *
          */
-        void AddDisplayElement(DisplayElement* display_element);
+        ~GameDisplay();
+        GameDisplay(const GameDisplay& other) = delete; /**< \brief Default copy constructor is disabled */
+        GameDisplay& operator=(const GameDisplay&) = delete; /**< \brief Default operator = is disabled */
 
         /**
          *  \brief Init method for GameDisplay
          *
-         *  Initializes the manager classes and adds the to the list of
-         *  DisplayElement object that are tracked. Initializes a Relay object
-         *  and passes it to all manager classes that need it. Plays the game's
-         *  music.
+         *  Plays the game's music and starts the simulation thread.
          *  \return void
          *
          */
@@ -96,8 +139,8 @@
         /**
          *  \brief Enter method for GameDisplay
          *
-         *  Unpauses the SystemTimer which is the main game timer. Unpauses the
-         *  music. Checks mode to see if it should immediately
+         *  Starts the simulation thread again. Unpauses the music. Checks mode
+         *  to see if it should immediately
          *  \param mode
          *  \return void
          *
@@ -106,7 +149,7 @@
         /**
          *  \brief Leave method for GameDisplay
          *
-         *  Pauses the SystemTimer which is the main game timer. Pauses the
+         *  Stops the simulation thread, which pauses the game. Pauses the
          *  music.
          *  \return void
          *
@@ -119,6 +162,8 @@
          *  destroys music used in the game. Checks to see if the level was
          *  completed. If it was the it returns the number of the next level,
          *  otherwise if player failed or the game was quit return 0
+         *  Writes the buttons of the level to RESOURCES_RECORDING_PATH unless
+         *  it was a replay or a game over the network.
          *  \return returns 0 if game was quit or player failed, else returns
          *          number of the next level
          *
@@ -128,11 +173,11 @@
         /**
          *  \brief Update method for GameDisplay
          *
-         *  Checks whether any conditions for ending the game are met and takes
+         *  Checks whether the simulation thread ended the level and takes
          *  appropriate action (level completed, game over, etc.). If not the
          *  checks the user's input to see if any special key was pressed for
-         *  quiting or pausing current display. If none of the previous
-         *  conditions were met then it updates all of its DisplayElements.
+         *  quiting or pausing current display. Otherwise hands the buttons
+         *  of the players held now to the simulation thread.
          *  \return void
          *
          */
@@ -140,7 +185,10 @@
         /**
          *  \brief Draw method for GameDisplay
          *
-         *  Draws all of GameDisplay's DisplayElement objects.
+         *  Draws the newest RenderSnapshot published by the simulation
+         *  thread: the map from its MapLayer, updated by the tiles that
+         *  changed, and the rest through a SpriteBatch, with moving objects
+         *  and the view between their last two places.
          *  \return void
          *
          */
@@ -149,8 +197,7 @@
     protected:
 
     private:
-        std::vector<DisplayElement*>    m_display_elements;
-        Relay*                          m_relay;
+        World*                          m_world;
         SDL_Texture*                    m_texture;
         SDL_Renderer*                   m_renderer;
         unsigned int                    m_window_width;
@@ -160,6 +207,64 @@
         bool                            m_level_completed;
         bool                            m_play_music = true;
         Mix_Music*                      m_music;
+        InputRecording                  m_recording;
+        InputRecording*                 m_replay; /**< nullptr unless replaying */
+        ScriptedInput*                  m_world_input; /**< buttons the World reads when replaying or over the network */
+        RollbackSession*                m_session; /**< nullptr unless playing against a peer */
+        unsigned long                   m_step; /**< number of World updates */
+
+        enum Ending
+        {
+            PLAYING = 0,
+            FAILED = 1,
+            COMPLETED = 2
+        };
+
+        /** \brief Starts the simulation thread unless it runs */
+        void Start();
+        /** \brief Stops the simulation thread and waits for it */
+        void Stop();
+        /** \brief Loop of the simulation thread */
+        void Simulate();
+        /**
+         *  \brief Makes one step of the level on the simulation thread
+         *
+         *  Ends the level if the players are dead, it was completed or the
+         *  replay is over. Otherwise updates the World, recording the
+         *  buttons held or setting the recorded ones when replaying. Over the
+         *  network the RollbackSession steps the World instead, and the level
+         *  only ends on a step made with the peer's real buttons.
+         *  \return false if the level ended
+         */
+        bool Step();
+        /**
+         *  \brief Checks the state of the World after a step of a replay or
+         *         of a recorded level
+         *
+         *  A recorded level keeps the checksum of the state every
+         *  RECORDING_CHECKSUM_INTERVAL steps. A replay compares the state
+         *  with the recorded checksum and reports the first one that differs.
+         *  \return void
+         */
+        void CheckState();
+        /** \brief Adds the part of the World in the view of the Camera to a RenderSnapshot and hands it to Draw() */
+        void Publish(unsigned long ticks);
+
+        SystemTimer                     m_timer; /**< clock of the World, stepped by the simulation thread */
+        ScriptedInput                   m_local_input; /**< buttons of this device as the simulation thread sees them */
+        std::vector<SDL_Keycode>        m_keys; /**< keys of the players, bit i of m_buttons is key i */
+        std::atomic<uint32_t>           m_buttons; /**< keys held, written by the main thread */
+        std::atomic<int>                m_ending; /**< Ending, set by the simulation thread */
+        std::atomic<bool>               m_simulating; /**< cleared to stop the simulation thread */
+        std::thread                     m_thread;
+        mutable TripleBuffer<RenderSnapshot> m_frames; /**< written by the simulation thread, taken by Draw() */
+        mutable SpriteBatch             m_batch; /**< buffers of the frames drawn by Draw() */
+        mutable MapLayer                m_layer; /**< tiles of the map as drawn by Draw() */
+        mutable std::atomic<unsigned long> m_layer_revision; /**< revision of m_layer, read by the simulation thread */
+        Camera                          m_camera; /**< view following the players, moved by the simulation thread */
+        StateBuffer                     m_check_state; /**< state of the World whose checksum is recorded or compared */
+        unsigned long                   m_matched_step; /**< last step of a replay whose checksum was the recorded one */
+        unsigned long                   m_apart_step; /**< first step of a replay whose checksum was not, 0 if none */
 };
 
 #endif // GAMEDISPLAY_H
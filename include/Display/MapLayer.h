@@ -0,0 +1,82 @@
+#ifndef MAPLAYER_H
+#define MAPLAYER_H
+
+/**
+ *  \file MapLayer.h
+ *
+ *  Defines class MapLayer which keeps the tiles of the map drawn in a
+ *  texture of their own
+ *
+ */
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include "Display/RenderSnapshot.h"
+
+/** \class MapLayer
+ *  \brief Class which draws the map from a texture kept between frames
+ *  \details The tiles are drawn once into a texture the renderer can draw
+ *           into. Afterwards only the tiles that changed, as told by the
+ *           snapshots, are drawn into it again, and every frame the part of
+ *           the map in the view is put on the screen with one copy of that
+ *           texture. The look of every tile is also kept in memory, so when
+ *           the renderer can not draw into textures or the map is larger
+ *           than its largest texture, the tiles in the view are drawn every
+ *           frame instead, found by their range of rows and columns.
+ *           A MapLayer is only used by the thread drawing the frames.
+ */
+class MapLayer
+{
+    public:
+        /**
+         *  \brief Destructor for MapLayer
+         *
+         *  Destroys the texture of the map
+         */
+        ~MapLayer();
+
+        /**
+         *  \brief Takes the changed tiles of a snapshot
+         *
+         *  Snapshots of an older revision than the one of the layer are
+         *  left alone, so a snapshot can be given again.
+         *  \param snapshot snapshot whose layer base is at most GetRevision()
+         *  \return void
+         */
+        void Update(const RenderSnapshot& snapshot);
+        /**
+         *  \brief Draws the map on given SDL_Renderer
+         *
+         *  Draws the tiles changed since the last call into the texture of
+         *  the map, then copies the part in the view to the screen.
+         *  \param renderer renderer on which the map is drawn
+         *  \param view part of the map shown on the screen, the whole map if
+         *         it is empty
+         *  \return void
+         */
+        void Draw(SDL_Renderer* renderer, const SDL_Rect& view);
+
+        unsigned long GetRevision() const { return m_revision; } /**< \brief Gives revision of the map the layer shows */
+        unsigned int GetBlits() const { return m_blits; } /**< \brief Gives number of tiles drawn by the last Draw() */
+
+    private:
+        /** \brief Makes the texture of the map if it is missing, gives false if the renderer can not */
+        bool MakeTarget(SDL_Renderer* renderer);
+        /** \brief Marks every tile to be drawn into the texture of the map */
+        void Invalidate();
+        /** \brief Draws the tiles in the view one by one */
+        void DrawTiles(SDL_Renderer* renderer, const SDL_Rect& view);
+
+        SDL_Texture*                m_texture = nullptr; /**< texture from which the tiles are taken */
+        SDL_Texture*                m_target = nullptr; /**< texture holding the drawn map */
+        bool                        m_no_target = false; /**< renderer can not draw into textures */
+        unsigned int                m_width = 0;
+        unsigned int                m_height = 0;
+        unsigned int                m_tile_size = 0;
+        unsigned long               m_revision = 0;
+        unsigned int                m_blits = 0;
+        std::vector<SDL_Rect>       m_sources; /**< look of every tile */
+        std::vector<unsigned int>   m_dirty; /**< tiles not yet drawn into the texture of the map */
+};
+
+#endif // MAPLAYER_H
@@ -0,0 +1,165 @@
+#ifndef RENDERSNAPSHOT_H
+#define RENDERSNAPSHOT_H
+
+/**
+ *  \file RenderSnapshot.h
+ *
+ *  Defines class RenderSnapshot which holds everything drawn of a World at
+ *  one step, to be drawn later by another thread
+ *
+ */
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include "Constants/WindowConstants.h"
+
+/** \class RenderSnapshot
+ *  \brief List of the sprites of a World at one step
+ *  \details DisplayElements add their sprites to it in the order they are
+ *           drawn, with the texture rectangle picked for the animation
+ *           phase of the step. Sprites which move also keep where they were
+ *           in the step before, so they can be drawn between both places
+ *           while the next step is not yet made. Once taken, a snapshot does
+ *           not depend on the World any more, so it can be drawn by a
+ *           SpriteBatch while the World goes on. Clear() keeps the memory of the list, so taking
+ *           the snapshots of one level allocates only at the start.
+ *           The tiles of the map are not sprites: the drawing thread keeps
+ *           them in a MapLayer, so a snapshot only holds the tiles whose
+ *           look changed since the revision of the layer which the drawing
+ *           thread already has.
+ *           Sprites are placed in the World. Once a view is set, only sprites
+ *           inside GetArea() are kept, and DisplayElements with many objects
+ *           look up those in the area instead of adding all of them. Overlay
+ *           sprites such as the lives of the players are placed on the
+ *           screen and drawn over the World.
+ */
+class RenderSnapshot
+{
+    public:
+        /** \brief Texture rectangle copied to the screen */
+        struct Sprite
+        {
+            SDL_Texture*    texture;
+            SDL_Rect        source;
+            SDL_Rect        dest; /**< place at the step of the snapshot */
+            int             from_x; /**< x of the place in the step before */
+            int             from_y; /**< y of the place in the step before */
+        };
+        /** \brief Tile of the map layer with its new look */
+        struct Tile
+        {
+            unsigned int    index; /**< row * width + column */
+            SDL_Rect        source;
+        };
+        /** \brief Map layer of the World */
+        struct Layer
+        {
+            SDL_Texture*    texture;
+            unsigned int    width; /**< in tiles */
+            unsigned int    height; /**< in tiles */
+            unsigned int    tile_size; /**< in pixels */
+            unsigned long   revision; /**< 0 if there is no map */
+        };
+
+        /**
+         *  \brief Empties the snapshot, keeping its memory
+         *
+         *  \param ticks SDL ticks at which the step of the snapshot is made
+         *  \param layer_base revision of the map layer the drawing thread
+         *         has, 0 to get every tile
+         *  \return void
+         */
+        void Clear(unsigned long ticks, unsigned long layer_base = 0);
+        /**
+         *  \brief Sets the part of the World seen on the screen
+         *
+         *  Must be set before anything is added.
+         *  \param view rectangle of the World shown at the step of the
+         *         snapshot
+         *  \param from_x x of the view in the step before
+         *  \param from_y y of the view in the step before
+         *  \return void
+         */
+        void SetView(const SDL_Rect& view, int from_x, int from_y);
+        /**
+         *  \brief Adds a sprite which stays in its place
+         *
+         *  \param texture texture from which the sprite is taken
+         *  \param source rectangle of the sprite in the texture
+         *  \param dest rectangle on the screen
+         *  \return void
+         */
+        void Copy(SDL_Texture* texture, const SDL_Rect& source, const SDL_Rect& dest);
+        /**
+         *  \brief Adds a sprite which moved in the last step
+         *
+         *  \param texture texture from which the sprite is taken
+         *  \param source rectangle of the sprite in the texture
+         *  \param dest rectangle on the screen after the step
+         *  \param from_x x on the screen before the step
+         *  \param from_y y on the screen before the step
+         *  \return void
+         */
+        void Move(SDL_Texture* texture, const SDL_Rect& source, const SDL_Rect& dest, int from_x, int from_y);
+        /**
+         *  \brief Adds a sprite placed on the screen instead of in the World
+         *
+         *  \param texture texture from which the sprite is taken
+         *  \param source rectangle of the sprite in the texture
+         *  \param dest rectangle on the screen
+         *  \return void
+         */
+        void Overlay(SDL_Texture* texture, const SDL_Rect& source, const SDL_Rect& dest);
+        /**
+         *  \brief Sets the size and the revision of the map layer
+         *
+         *  \param texture texture from which the tiles are taken
+         *  \param width width of the map in tiles
+         *  \param height height of the map in tiles
+         *  \param tile_size size of a tile in pixels
+         *  \param revision revision of the map at the step of the snapshot
+         *  \return void
+         */
+        void SetLayer(SDL_Texture* texture, unsigned int width, unsigned int height, unsigned int tile_size, unsigned long revision);
+        /**
+         *  \brief Adds a tile of the map layer whose look changed
+         *
+         *  \param index row * width + column of the tile
+         *  \param source rectangle of the tile in the texture
+         *  \return void
+         */
+        void ChangeTile(unsigned int index, const SDL_Rect& source)
+        {
+            m_tiles.push_back({index, source});
+        }
+        const std::vector<Sprite>& GetSprites() const { return m_sprites; } /**< \brief Gives the sprites in the order they are drawn */
+        const std::vector<Sprite>& GetOverlay() const { return m_overlay; } /**< \brief Gives the sprites drawn over the World */
+        bool HasView() const { return m_has_view; } /**< \brief Tells if a view was set, else the whole World is drawn */
+        const SDL_Rect& GetView() const { return m_view; } /**< \brief Gives the view at the step of the snapshot */
+        int GetViewFromX() const { return m_view_from_x; } /**< \brief Gives x of the view in the step before */
+        int GetViewFromY() const { return m_view_from_y; } /**< \brief Gives y of the view in the step before */
+        /** \brief Gives the part of the World whose sprites are kept, both views and VIEW_MARGIN around them */
+        const SDL_Rect& GetArea() const { return m_area; }
+        unsigned long GetTicks() const { return m_ticks; } /**< \brief Gives SDL ticks at which the snapshot was taken */
+        unsigned long GetLayerBase() const { return m_layer_base; } /**< \brief Gives revision of the map layer the changed tiles start from */
+        const Layer& GetLayer() const { return m_layer; } /**< \brief Gives the map layer */
+        const std::vector<Tile>& GetTiles() const { return m_tiles; } /**< \brief Gives the tiles changed since GetLayerBase() */
+
+    private:
+        /** \brief Tells if a sprite is seen at either of its places */
+        bool Seen(const SDL_Rect& dest, int from_x, int from_y) const;
+
+        std::vector<Sprite>     m_sprites;
+        std::vector<Sprite>     m_overlay;
+        std::vector<Tile>       m_tiles;
+        Layer                   m_layer = {nullptr, 0, 0, 0, 0};
+        unsigned long           m_ticks = 0;
+        unsigned long           m_layer_base = 0;
+        bool                    m_has_view = false;
+        SDL_Rect                m_view = {0, 0, 0, 0};
+        int                     m_view_from_x = 0;
+        int                     m_view_from_y = 0;
+        SDL_Rect                m_area = {0, 0, 0, 0};
+};
+
+#endif // RENDERSNAPSHOT_H
@@ -0,0 +1,102 @@
+#ifndef SPRITEBATCH_H
+#define SPRITEBATCH_H
+
+/**
+ *  \file SpriteBatch.h
+ *
+ *  Defines class SpriteBatch which draws the sprites of a RenderSnapshot
+ *  with one geometry call per texture
+ *
+ */
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include "Display/RenderSnapshot.h"
+
+/** \class SpriteBatch
+ *  \brief Class which turns the sprites of a snapshot into textured quads
+ *  \details Every sprite becomes four vertices and six indices in buffers
+ *           kept from frame to frame. Sprites following each other with the
+ *           same texture form one run, which SDL_RenderGeometry draws in one
+ *           call, so the order of the sprites, and with it the layers of
+ *           the World, is kept. As the whole World is cut from one atlas, a
+ *           frame usually takes one call instead of one SDL_RenderCopy per
+ *           sprite. SDL older than 2.0.18 has no SDL_RenderGeometry and no
+ *           SDL_Vertex, there only the destination of every sprite is kept
+ *           and the runs are drawn sprite by sprite.
+ *           Sprites of the World are moved by the view of the snapshot,
+ *           itself placed between its last two places, and the overlay is
+ *           added last, as it is.
+ *           A SpriteBatch is only used by the thread drawing the frames.
+ */
+class SpriteBatch
+{
+    public:
+        /**
+         *  \brief Fills the buffers with the sprites of a snapshot
+         *
+         *  Moving sprites and the view are placed as far between their
+         *  places as the time passed since the snapshot is into the next
+         *  step.
+         *  \param snapshot snapshot whose sprites are drawn
+         *  \param ticks SDL ticks of now
+         *  \return void
+         */
+        void Build(const RenderSnapshot& snapshot, unsigned long ticks);
+        /**
+         *  \brief Draws the runs filled by Build() on given SDL_Renderer
+         *
+         *  The snapshot given to Build() must not have changed since.
+         *  \param renderer renderer on which the sprites are drawn
+         *  \return void
+         */
+        void Submit(SDL_Renderer* renderer);
+        /**
+         *  \brief Builds and submits a snapshot
+         *
+         *  \param renderer renderer on which the sprites are drawn
+         *  \param snapshot snapshot whose sprites are drawn
+         *  \param ticks SDL ticks of now
+         *  \return void
+         */
+        void Draw(SDL_Renderer* renderer, const RenderSnapshot& snapshot, unsigned long ticks);
+
+        unsigned int GetSprites() const { return m_count; } /**< \brief Gives number of sprites of the last build */
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+        unsigned int GetCalls() const { return m_runs.size(); } /**< \brief Gives number of draw calls of the last build */
+#else
+        unsigned int GetCalls() const { return m_count; } /**< \brief Gives number of draw calls of the last build */
+#endif
+        /** \brief Gives the part of the World shown by the last build, empty if the snapshot had no view */
+        const SDL_Rect& GetView() const { return m_view; }
+
+    private:
+        /** \brief Adds the quad (or the destination) of a sprite moved by the given offset */
+        void Add(const RenderSnapshot::Sprite& sprite, double interpolation, int offset_x, int offset_y);
+        /** \brief Gives the sprite of the last build with given index, the overlay following the World */
+        const RenderSnapshot::Sprite& GetSprite(unsigned int i) const;
+
+        /** \brief Sprites following each other with one texture */
+        struct Run
+        {
+            SDL_Texture*    texture;
+            unsigned int    first; /**< first sprite of the run */
+            unsigned int    count;
+        };
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+        std::vector<SDL_Vertex>             m_vertices;
+        std::vector<int>                    m_indices; /**< the same two triangles for every sprite, only grows */
+        SDL_Texture*                        m_size_texture = nullptr; /**< texture whose size is kept */
+        float                               m_texture_w = 1;
+        float                               m_texture_h = 1;
+#else
+        std::vector<SDL_Rect>               m_dests; /**< where every sprite is drawn */
+#endif
+        std::vector<Run>                    m_runs;
+        unsigned int                        m_count = 0; /**< sprites of the last build */
+        const RenderSnapshot*               m_snapshot = nullptr; /**< snapshot of the last build */
+        SDL_Rect                            m_view = {0, 0, 0, 0};
+};
+
+#endif // SPRITEBATCH_H
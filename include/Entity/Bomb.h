@@ -12,7 +12,9 @@
  */
 
 #include <SDL2/SDL.h>
+#include "Display/RenderSnapshot.h"
 #include "Utility/Timer.h"
+#include "Utility/StateBuffer.h"
 
 /** \class Bomb
  *  \brief Class which represents one bomb
@@ -31,6 +33,7 @@ class Bomb
          *  \param fuse_duration the length of bomb's fuse.
          *  \param texture pointer to SDL_texture object from which the texture
          *         will be taken for method Draw()
+         *  \param system_timer SystemTimer of the World the fuse burns in
          *  \param x coordinate of the bomb on the map
          *  \param y coordinate of the bomb on the map
          *  \param bomb_size drawing size of the bomb according to 32 pixel tile
@@ -39,16 +42,19 @@ class Bomb
          *  \param intensity real value of bomb's blast radius (1.0 is radius of
          *         one tile size of the map
          *  \param damage damage in percent that a bomb does to a wall
+         *  \param serial number of the bomb in the order the bombs were placed
          *
          */
         Bomb(unsigned int fuse_duration,
              SDL_Texture* texture,
+             SystemTimer* system_timer,
              unsigned int x,
              unsigned int y,
              unsigned int bomb_size,
              unsigned int player_id,
              double intensity = 1.0,
-             unsigned int damage = 25);
+             unsigned int damage = 25,
+             unsigned int serial = 0);
         #ifdef DEBUG_OUTPUT_BOMB
         ~Bomb();
         #endif // DEBUG_OUTPUT_BOMB
@@ -59,6 +65,15 @@ class Bomb
         double GetIntensity () const { return m_intensity; }
         unsigned int GetPlayerId() const { return m_player_id; }
         unsigned int GetDamage() const { return m_damage; }
+        unsigned int GetSerial() const { return m_serial; }
+        /**
+         *  \brief Gives the game time at which the fuse runs out
+         *
+         *  The bomb goes off in the first Update() after that time, unless
+         *  another explosion sets it off sooner.
+         *  \return time in milliseconds as given by SystemTimer
+         */
+        unsigned long GetDetonationTime() const;
 
         /**
          *  \brief Update function for class Bomb
@@ -81,15 +96,27 @@ class Bomb
          */
         bool Explode() const;
         /**
-         *  \brief Draws the bomb on given SDL_Renderer
+         *  \brief Makes the bomb explode without waiting for its fuse
+         *
+         *  Used when the bomb is caught in the explosion of another bomb.
+         *
+         *  \return void
+         */
+        void Detonate() { m_explode = true; }
+        /**
+         *  \brief Draws the bomb to given RenderSnapshot
          *
          *  Draws the bomb on the map according to it's coordinates.
-         *  \param renderer represents the SDL_Renderer on which the bomb
-         *         will be drawn on.
+         *  \param snapshot snapshot to which the bomb is added
          *
          *  \return void
          */
-        void Draw(SDL_Renderer* renderer) const;
+        void Draw(RenderSnapshot& snapshot) const;
+
+        /** \brief Writes the state of the bomb */
+        void SaveState(StateBuffer& state) const;
+        /** \brief Reads the state written by SaveState() */
+        void LoadState(StateBuffer& state);
 
     protected:
 
@@ -105,6 +132,7 @@ class Bomb
         double          m_intensity;
         unsigned int    m_damage;
         unsigned int    m_phase_number;
+        unsigned int    m_serial;
 };
 
 #endif // BOMB_H
@@ -0,0 +1,249 @@
+#ifndef ENEMYBATCH_H
+#define ENEMYBATCH_H
+
+/**
+ *  \file EnemyBatch.h
+ *
+ *  Defines class EnemyBatch which keeps all enemies of one kind.
+ *
+ */
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include <cstdint>
+#include "Utility/Relay.h"
+#include "Entity/Player.h"
+#include "Utility/DistanceField.h"
+#include "Destroyer/ThreatMap.h"
+#include "Utility/Random.h"
+#include "Utility/StateBuffer.h"
+#include "System/SystemTimer.h"
+#include "Utility/Contact.h"
+#include "Display/RenderSnapshot.h"
+#include "Constants/TextureAtlas.h"
+
+/** \class EnemyBatch
+ *  \brief Class which keeps all enemies of one kind.
+ *  \details Properties shared by the kind (size, speed, texture and the way it
+ *           walks) are kept once, properties of single enemies (position,
+ *           direction, length of the current walk, time of the last step and
+ *           the animation frame) are kept in parallel arrays with one element
+ *           per enemy. Every part of the update runs over all enemies of the
+ *           batch in one loop: touching the players, choosing directions and
+ *           moving. The loops run over a range of the enemies, so ranges can
+ *           be updated on several threads at once: an enemy only writes its
+ *           own elements and reads the map, the bombs and the players.
+ *           Enemies of kind ONE and TWO wander around randomly, enemies
+ *           of kind THREE chase a player a few tiles of walking away. No
+ *           enemy steps onto a tile about to be reached by a bomb.
+ */
+class EnemyBatch
+{
+    public:
+        enum Kind
+        {
+            ONE = 0,
+            TWO = 1,
+            THREE = 2
+        };
+
+        /**
+         *  \brief Constructor for EnemyBatch.
+         *
+         *  Makes an empty batch for enemies of the given kind.
+         *  \param kind kind of the enemies in the batch
+         *  \param texture pointer to SDL_texture object from which the texture
+         *         will be taken for method Draw()
+         *  \param tile_size size of one tile on map
+         *  \param system_timer SystemTimer of the World the enemies walk in
+         */
+        EnemyBatch(Kind kind, SDL_Texture* texture, unsigned int tile_size, SystemTimer* system_timer);
+
+        /**
+         *  \brief Adds a new enemy to the batch.
+         *
+         *  \param x top left x coordinate of the enemy on the map in pixels
+         *  \param y top left y coordinate of the enemy on the map in pixels
+         *  \param random generator from which the enemy draws its walks
+         *  \return void
+         */
+        void Add(unsigned int x, unsigned int y, const Random& random);
+        /**
+         *  \brief Marks the enemy to be removed by RemoveDead().
+         *
+         *  \param i index of the enemy in the batch
+         *  \return void
+         */
+        void Kill(unsigned int i) { m_dead[i] = true; }
+        /**
+         *  \brief Removes all enemies marked by Kill().
+         *
+         *  Removing an enemy moves the last one of the batch into its place.
+         *  \return void
+         */
+        void RemoveDead();
+
+        Kind GetKind() const { return m_kind; } /**< \brief Gives the kind of the enemies */
+        unsigned int GetSize() const { return m_x.size(); } /**< \brief Gives number of enemies in the batch */
+        unsigned int GetX(unsigned int i) const { return m_x[i]; } /**< \brief Gives x coordinate of i-th enemy */
+        unsigned int GetY(unsigned int i) const { return m_y[i]; } /**< \brief Gives y coordinate of i-th enemy */
+        unsigned int GetSizeW() const { return m_size_w; } /**< \brief Gives width of the enemies */
+        unsigned int GetSizeH() const { return m_size_h; } /**< \brief Gives height of the enemies */
+
+        /**
+         *  \brief Remembers the current positions of the enemies.
+         *
+         *  Called before each Update() so that the enemies can be drawn between
+         *  the remembered positions and the positions after the update.
+         *
+         *  \return void
+         */
+        void SavePositions();
+        /**
+         *  \brief Gives the box of a player which enemies touch
+         *
+         *  The collision box is a bit smaller than the picture of the player.
+         *  \param player player whose box is given
+         *  \param tile_size size of one tile on map
+         *  \return the box in pixels on the map
+         */
+        static Contact::Box TouchBox(const Player& player, unsigned int tile_size);
+        /**
+         *  \brief Tells if any enemy of a range touches a box
+         *
+         *  A box is touched when one of its corners is inside of an enemy.
+         *  All enemies of the range are tested at once by Contact::Corners().
+         *  \param box box given by TouchBox()
+         *  \param first index of the first enemy, a multiple of 32
+         *  \param count number of enemies
+         *  \return true if the box is touched
+         */
+        bool Touches(const Contact::Box& box, unsigned int first, unsigned int count);
+        /**
+         *  \brief Updates a range of enemies of the batch.
+         *
+         *  Chooses where every enemy goes and moves the enemies whose step
+         *  time has come.
+         *
+         *  \param field distances to the players, used by chasing enemies
+         *  \param relay pointer to Relay object of the game
+         *  \param first index of the first enemy
+         *  \param count number of enemies
+         *  \return void
+         */
+        void Update(const DistanceField& field, Relay* relay, unsigned int first, unsigned int count);
+        /**
+         *  \brief Draws all enemies of the batch to given RenderSnapshot.
+         *
+         *  \param snapshot snapshot to which the enemies are added
+         *  \return void
+         */
+        void Draw(RenderSnapshot& snapshot) const;
+        /**
+         *  \brief Draws one enemy of the batch to given RenderSnapshot.
+         *
+         *  \param snapshot snapshot to which the enemy is added
+         *  \param i index of the enemy
+         *  \return void
+         */
+        void Draw(RenderSnapshot& snapshot, unsigned int i) const;
+
+        /** \brief Writes the state of the enemies of the batch */
+        void SaveState(StateBuffer& state) const;
+        /** \brief Reads the state written by SaveState() */
+        void LoadState(StateBuffer& state);
+
+    protected:
+        enum Direction
+        {
+              LEFT = 0,
+              RIGHT = 1,
+              UP = 2,
+              DOWN = 3
+        };
+
+        /**
+         *  \brief Gives new random directions to wandering enemies whose walk
+         *         has ended.
+         *
+         *  \param first index of the first enemy
+         *  \param end index after the last enemy
+         *  \return void
+         */
+        void Wander(unsigned int first, unsigned int end);
+        /**
+         *  \brief Turns the enemies close to a player towards that player.
+         *
+         *  Every enemy takes the step the field gives for the tile under its
+         *  center, or first lines up with that tile if walls are in the way.
+         *  Enemies more than ENEMY_THREE_CHASE_DISTANCE tiles of walking
+         *  away from every player wander instead.
+         *  \param field distances to the players
+         *  \param relay pointer to Relay object of the game
+         *  \param first index of the first enemy
+         *  \param end index after the last enemy
+         *  \return void
+         */
+        void Chase(const DistanceField& field, Relay* relay, unsigned int first, unsigned int end);
+        /**
+         *  \brief Moves the enemies whose step time has come.
+         *
+         *  Enemies stop instead of stepping onto a tile the bombs will soon
+         *  reach, see Safe().
+         *  \param relay pointer to Relay object of the game
+         *  \param first index of the first enemy
+         *  \param end index after the last enemy
+         *  \return void
+         */
+        void Move(Relay* relay, unsigned int first, unsigned int end);
+        /**
+         *  \brief Checks if the enemy can make one step in given direction
+         *         without walking into an explosion.
+         *
+         *  A step onto another tile is not safe if the bombs reach that tile
+         *  within ENEMY_THREAT_HORIZON milliseconds and sooner than the tile
+         *  the enemy is on, so enemies still walk out of a blast.
+         *  \param i index of the enemy in the batch
+         *  \param d direction that needs to be checked
+         *  \param threats times at which the bombs reach the tiles
+         *  \param now current game time
+         *  \return true if the step is safe
+         */
+        bool Safe(unsigned int i, Direction d, const ThreatMap& threats, unsigned long now) const;
+        /**
+         *  \brief Checks if the enemy can make one step in given direction.
+         *
+         *  \param i index of the enemy in the batch
+         *  \param d direction that needs to be checked
+         *  \param relay pointer to Relay object of the game
+         *  \return true if the step can be made
+         */
+        bool DirectionCheck(unsigned int i, Direction d, Relay* relay) const;
+
+    private:
+        Kind                        m_kind;
+        SDL_Texture*                m_texture;
+        SystemTimer*                m_system_timer;
+        unsigned int                m_tile_size;
+        unsigned int                m_speed; /**< milliseconds between two steps */
+        unsigned int                m_move_speed; /**< pixels made in one step */
+        unsigned int                m_size_w;
+        unsigned int                m_size_h;
+        unsigned int                m_rotation_const; /**< number of animation frames */
+        AtlasSprite                 m_sprite; /**< frames of the kind in the texture atlas */
+
+        std::vector<unsigned int>   m_x;
+        std::vector<unsigned int>   m_y;
+        std::vector<unsigned int>   m_previous_x;
+        std::vector<unsigned int>   m_previous_y;
+        std::vector<unsigned char>  m_direction;
+        std::vector<int>            m_walk_len;
+        std::vector<unsigned long>  m_step_time; /**< game time of the last step */
+        std::vector<unsigned int>   m_status; /**< animation frame */
+        std::vector<unsigned char>  m_chase;
+        std::vector<unsigned char>  m_dead;
+        std::vector<Random>         m_random; /**< own stream of every enemy */
+        std::vector<uint32_t>       m_touch_mask; /**< enemies touching a box, filled by Touches() */
+};
+
+#endif // ENEMYBATCH_H
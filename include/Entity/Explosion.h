@@ -16,7 +16,9 @@
  */
 
 #include <SDL2/SDL.h>
+#include "Display/RenderSnapshot.h"
 #include "Utility/Timer.h"
+#include "Utility/StateBuffer.h"
 
 /** \class Explosion
  *  \brief Class which represents visual effect of one explosion of the bomb
@@ -44,6 +46,7 @@ class Explosion
          *  \param tile_size pixel size of one tile of the map (used for Draw())
          *  \param texture pointer to SDL_texture object from which the texture
          *         will be taken for method Draw()
+         *  \param system_timer SystemTimer of the World the explosion is in
          *
          */
         Explosion(unsigned int duration,
@@ -51,7 +54,8 @@ class Explosion
                   unsigned int y_center,
                   double intensity,
                   unsigned int tile_size,
-                  SDL_Texture* texture);
+                  SDL_Texture* texture,
+                  SystemTimer* system_timer);
 
         /**
          *  \brief Update function for class Explosion
@@ -74,17 +78,24 @@ class Explosion
          *  \return true if the explosion has ended, else false
          */
         bool IsExploding() const;
+        unsigned int GetX() const { return m_x_center; } /**< \brief Gives x coordinate of the center */
+        unsigned int GetY() const { return m_y_center; } /**< \brief Gives y coordinate of the center */
+        double GetIntensity() const { return m_intensity; } /**< \brief Gives size of the explosion in tiles */
         /**
-         *  \brief Draws the explosion on given SDL_Renderer
+         *  \brief Draws the explosion to given RenderSnapshot
          *
          *  Draws the explosion on the map according to it's coordinates and
          *  size.
-         *  \param renderer represents the SDL_Renderer on which the explosion
-         *         will be drawn on.
+         *  \param snapshot snapshot to which the explosion is added
          *
          *  \return void
          */
-        void Draw(SDL_Renderer* renderer) const;
+        void Draw(RenderSnapshot& snapshot) const;
+
+        /** \brief Writes the state of the explosion */
+        void SaveState(StateBuffer& state) const;
+        /** \brief Reads the state written by SaveState() */
+        void LoadState(StateBuffer& state);
 
     protected:
 
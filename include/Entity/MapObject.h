@@ -1,6 +1,5 @@
 #ifndef MAPOBJECT_H
 #define MAPOBJECT_H
-
 // in MapObject.h MapObject.cpp Map.h Map.cpp WallDestroyer.h WallDestroyer.cpp
 //#define DEBUG_OUTPUT
 
@@ -15,9 +14,12 @@
 
 /** \class MapObject
  *  \brief class which represents an object on map
- *  \details This class contains all properties for describing a type of tile
- *           that can be placed on map like tile ID and texture on which should
- *           be placed. Also contains a method Draw() which draws it on a map.
+ *  \details This class is a compact record describing one tile of the map:
+ *           its tile ID, the kind of texture it is drawn with and, for
+ *           walls that can be destroyed, how much integrity they have left.
+ *           It is small and copyable so that Map can keep all tiles in one
+ *           contiguous array. Also contains a method GetSource() which
+ *           tells how it looks.
  */
 class MapObject
 {
@@ -25,7 +27,7 @@ class MapObject
         /**
          * \brief Enum for representing different types of tiles on the map
          */
-        enum Tile
+        enum Tile : unsigned char
         {
               EMPTY = 0, /**< Empty space on which the players and enemies can walk */
               DESTRUCTIBLE_WALL = 1, /**< Wall that can be destroyed with a bomb */
@@ -36,22 +38,13 @@ class MapObject
          *  \brief Constructor for MapObject.
          *
          *  Makes an object of class MapObject according to given parameters.
+         *  Walls start with full integrity.
          *  \param id describes type of tile on map
-         *  \param texture pointer to SDL_texture object from which the texture
-         *         will be taken for method Draw()
          *  \param kind variation of texture for given type of Tile
          *
          */
-        MapObject(Tile id, SDL_Texture *texture, unsigned int kind = 0);
-         /**
-         *  \brief Destructor for MapObject
-         *
-         *  Basic destructor for MapObject. Destructor is virtual so that the
-         *  inherited classes from this can be destroyed via this destructor.
-         */
-        virtual ~MapObject() { };
-        MapObject(const MapObject& other) = delete; /**< \brief Default copy constructor is disabled */
-        MapObject& operator=(const MapObject&) = delete; /**< \brief Default operator = is disabled */
+        MapObject(Tile id = EMPTY, unsigned int kind = 0);
+
         /** \brief Returns id of the tile
          *
          * Value returned is of type MapObject::Tile and represents id of this
@@ -60,23 +53,39 @@ class MapObject
          */
         Tile GetId() const { return m_id; }
         /**
-         *  \brief Draws a tile on given SDL_Renderer.
+         *  \brief Tells if the wall is destroyed
+         *
+         *  If the integrity of wall is at 0 the it returns true which means
+         *  that this tile should become empty.
+         *  \return true if the wall should be destroyed
+         */
+        bool IsDestroyed() const { return m_integrity == 0; }
+        /**
+         *  \brief Decreases the integrity of the wall according to damage taken
          *
-         *  Draws a tile on the map according to it's coordinates.
-         *  \param renderer represents SDL_Renderer on which a tile will be
-         *         drawn on
-         *  \param DestR location and size of renderer where should texture be
-         *         drawn
+         *  Given parameter represents the damage in percentages to the wall
+         *  that it should take. Percentages given represents a portion of
+         *  maximum integrity not current.
          *  \return void
          */
-        virtual void Draw(SDL_Renderer* renderer, const SDL_Rect *DestR);
+        void DecreaseIntegrity(int value);
+        /**
+         *  \brief Gives the rectangle of the texture the tile is drawn with
+         *
+         *  Picks the rectangle by the type and kind of the tile and, for
+         *  walls that can be destroyed, by how damaged they are. Two tiles
+         *  with the same rectangle look the same.
+         *  \return rectangle of the tile in the texture
+         */
+        SDL_Rect GetSource() const;
 
     protected:
-        Tile            m_id;
-        SDL_Texture*    m_texture;
-        unsigned int    m_kind;
 
     private:
+        Tile                m_id;
+        unsigned char       m_kind;
+        unsigned char       m_integrity;
+        static const int    S_MAX_INTEGRITY = 100; /**< number represents percentage */
 };
 
 #endif // MAPOBJECT_H
@@ -9,6 +9,8 @@
  */
 
 #include <SDL2/SDL.h>
+#include "Display/RenderSnapshot.h"
+#include "Utility/StateBuffer.h"
 
 /** \class PickUp
  *  \brief Class which represents one pickup
@@ -82,15 +84,19 @@ class PickUp
          */
         void Use();
         /**
-         *  \brief Draws the pickup on given SDL_Renderer
+         *  \brief Draws the pickup to given RenderSnapshot
          *
          *  Draws the pickup on the map according to it's coordinates.
-         *  \param renderer represents the SDL_Renderer on which the pickup
-         *         will be drawn on.
+         *  \param snapshot snapshot to which the pickup is added
          *
          *  \return void
          */
-        void Draw(SDL_Renderer* renderer) const;
+        void Draw(RenderSnapshot& snapshot) const;
+
+        /** \brief Writes the state of the pickup */
+        void SaveState(StateBuffer& state) const;
+        /** \brief Reads the state written by SaveState() */
+        void LoadState(StateBuffer& state);
 
     protected:
 
@@ -9,9 +9,11 @@
  */
 
 #include <SDL2/SDL.h>
+#include "Display/RenderSnapshot.h"
 #include "Utility/Relay.h"
 #include "System/KeyboardInput.h"
 #include "Utility/Timer.h"
+#include "Utility/StateBuffer.h"
 
 /** \class Player
  *  \brief class which represents a player
@@ -35,7 +37,8 @@ class Player
          *         will be taken for method Draw()
          *  \param tile_size size of one tile on map
          *  \param relay for getting bomb_manager with list of bombs with
-         *         methods for management
+         *         methods for management and KeyboardInput from which the
+         *         player reads its buttons
          *  \param player_id ID of the player
          *  \param val_x coordinate of the player on the map
          *  \param val_y coordinate of the player on the map
@@ -73,6 +76,7 @@ class Player
         unsigned int GetID() const;
 
         void SetKeycodes(SDL_Keycode up, SDL_Keycode down, SDL_Keycode left, SDL_Keycode right, SDL_Keycode bomb_button);
+        void GetKeycodes(SDL_Keycode& up, SDL_Keycode& down, SDL_Keycode& left, SDL_Keycode& right, SDL_Keycode& bomb_button) const;
 
         /**
          *  \brief Function that implements movement for player.
@@ -89,15 +93,14 @@ class Player
         void PlayerMove(int x, int y);
 
         /**
-         *  \brief Draws the player on given SDL_Renderer.
+         *  \brief Draws the player to given RenderSnapshot.
          *
          *  Draws the player on the map according to its coordinates.
-         *  \param renderer represents SDL_Renderer on which the player
-         *  will be drawn on
+         *  \param snapshot snapshot to which the player is added
          *
          *  \return void
          */
-        void Draw(SDL_Renderer* renderer);
+        void Draw(RenderSnapshot& snapshot) const;
 
         /**
          *  \brief Places the bomb on the map.
@@ -143,6 +146,11 @@ class Player
          */
         bool Touch(unsigned int pick_up_x, unsigned int pick_up_y);
 
+        /** \brief Writes the state of the player, its buttons and textures are not written */
+        void SaveState(StateBuffer& state) const;
+        /** \brief Reads the state written by SaveState() */
+        void LoadState(StateBuffer& state);
+
     protected:
 
     private:
@@ -171,6 +179,8 @@ class Player
         unsigned int   m_speed = 100;
         unsigned int   m_x;
         unsigned int   m_y;
+        unsigned int   m_previous_x;
+        unsigned int   m_previous_y;
         unsigned int   m_move_speed = 4;
         unsigned int   m_rotation_const = 3;
         unsigned int   m_player_size_w;
@@ -9,11 +9,18 @@
  *
  */
 
-#include <list>
 #include <SDL2/SDL_mixer.h>
 #include "Display/DisplayElement.h"
 #include "Entity/Bomb.h"
 #include "Utility/Relay.h"
+#include "Utility/SpatialGrid.h"
+#include "Utility/ObjectPool.h"
+#include "Destroyer/WallDestroyer.h"
+#include "Destroyer/ThreatMap.h"
+#include "Destroyer/BlastArea.h"
+#include "Utility/StateBuffer.h"
+#include "Simulation/WorldSnapshot.h"
+#include <vector>
 
 /** \class BombManager
  *  \brief Class which is used for keeping track of all bombs in the game.
@@ -21,7 +28,8 @@
  *           player. Has appropriate methods for adding bombs and drawing them.
  *           Also has an update method which calls the appropriate update method
  *           for all bombs. Also keeps reference to Relay which it uses to
- *           communicate to other game objects.
+ *           communicate to other game objects, and a ThreatMap telling when
+ *           the bombs will reach each tile.
  */
 class BombManager : public DisplayElement
 {
@@ -37,7 +45,8 @@ class BombManager : public DisplayElement
          *         pixels (which is required for proper implementation of method
          *         Draw())
          *  \param relay pointer to the relay object which is used to
-         *         communicate with other game objects
+         *         communicate with other game objects, its Map must already
+         *         be set
          */
         BombManager(SDL_Texture* texture, unsigned int tile_size, Relay* relay);
         /**
@@ -49,24 +58,16 @@ class BombManager : public DisplayElement
         BombManager(const BombManager& other) = delete; /**< \brief Default copy constructor is disabled */
         BombManager& operator=(const BombManager&) = delete; /**< \brief Default operator = is disabled */
 
-        /**
-         *  \brief Adds new Bomb to the list of bombs.
-         *
-         *  Adds new Bomb to the list of bombs so that it will be periodically
-         *  updated and destroyed when it's fuse runs out. Will also make new
-         *  Explosion and possibly destroy walls on the map or enemies or player
-         *
-         *  \param bomb pointer to object Bomb which will be added to the list
-         *  \return void
-         */
-        void AddBomb(Bomb *bomb);
         /**
          *  \brief Makes new Bomb according to given parameters and adds it to
          *         the list of bombs.
          *
          *  Uses the given parameters and makes a new Bomb object and adds it to
-         *  the list of bombs same as method AddBomb(Bomb* bomb). The bomb will
-         *  be periodically updated and destroyed when it's fuse runs out.
+         *  the list of bombs. The bomb will be periodically updated and
+         *  destroyed when it's fuse runs out. Will also make new Explosion and
+         *  possibly destroy walls on the map or enemies or player. Bombs are
+         *  kept in a pool of POOL_BOMB_CAPACITY slots, no bomb is made when all
+         *  of them are taken.
          *
          *  \param fuse_duration duration of bombs fuse in millisecond
          *  \param x top left x coordinate of the bomb on the map
@@ -75,9 +76,9 @@ class BombManager : public DisplayElement
          *  \param intensity real value which represents the intensity of the
          *         bombs explosion after it's fuses burns out
          *  \param damage value in percents that the bomb will do to a wall
-         *  \return void
+         *  \return true if the bomb was made
          */
-        void MakeBomb(unsigned int fuse_duration,
+        bool MakeBomb(unsigned int fuse_duration,
                       unsigned int x,
                       unsigned int y,
                       unsigned int player_id,
@@ -87,31 +88,68 @@ class BombManager : public DisplayElement
          *  \brief Update function for class BombManager
          *
          *  Calls the update methods of all the bombs it keeps track of.
+         *  Bombs whose fuse has run out are queued for detonation together
+         *  with every bomb caught in the blast of a queued bomb. All of them
+         *  go off in this tick: their effects on walls, enemies and players
+         *  and their explosions are made in one batch.
          *
          *  \return void
          */
         void Update();
         /**
-         *  \brief Draw all the bombs it keeps track of on given SLD_Renderer
+         *  \brief Draw all the bombs it keeps track of to given RenderSnapshot
          *
          *  Calls Bomb::Draw() method for all the bombs it keeps track of with
-         *  the given SLD_Renderer as parameter so it will draw them on that
-         *  same renderer.
-         *  \param renderer represents the SDL_Renderer on which the bombs
-         *         will be drawn on.
+         *  the given RenderSnapshot as parameter so it will add them to that
+         *  same snapshot. If the snapshot has a view, only the bombs found in
+         *  its area by the grid are drawn.
+         *  \param snapshot snapshot to which the bombs are added
+         *
+         *  \return void
+         */
+        void Draw(RenderSnapshot& snapshot) const;
+
+        const ThreatMap& GetThreatMap() const { return m_threats; } /**< \brief Gives times at which the bombs reach the tiles */
+
+        /**
+         *  \brief Writes all bombs on the map with their remaining fuses
+         *
+         *  \param state buffer to which the state is added
+         *  \return void
+         */
+        void SaveState(StateBuffer& state) const;
+        /**
+         *  \brief Replaces all bombs by the ones written by SaveState()
+         *
+         *  The ThreatMap is worked out again, so the Map must be loaded first.
+         *  \param state buffer from which the state is read
+         *  \return void
+         */
+        void LoadState(StateBuffer& state);
+        /**
+         *  \brief Adds the tiles of all bombs with their players
          *
+         *  The Map must be taken first, as the tiles are found from its size.
+         *  \param snapshot snapshot of the World being taken
          *  \return void
          */
-        void Draw(SDL_Renderer* renderer) const;
+        void TakeSnapshot(WorldSnapshot& snapshot) const;
 
     protected:
 
     private:
-        std::list<Bomb*>        m_bombs;
+        ObjectPool<Bomb>        m_bombs;
         unsigned int            m_bomb_size;
         unsigned int            m_tile_size;
         Relay*                  m_relay;
         Mix_Chunk*              m_bomb_sound_effect;
+        SpatialGrid<Bomb*>      m_grid;
+        std::vector<Bomb*>      m_detonations; /**< bombs going off in the current tick */
+        std::vector<Bomb*>      m_caught; /**< bombs on one tile of a blast, queued in placing order */
+        unsigned int            m_next_serial; /**< serial of the next bomb placed */
+        std::vector<BlastArea>  m_blasts; /**< areas hit by the bombs going off in the current tick */
+        WallDestroyer           m_wall_destroyer;
+        ThreatMap               m_threats;
 };
 
 #endif // BOMBMANAGER_H
@@ -9,17 +9,33 @@
  *
  */
 
-#include <list>
 #include "Display/DisplayElement.h"
 #include "Utility/Relay.h"
-#include "Entity/Enemy.h"
+#include "Entity/EnemyBatch.h"
+#include "Utility/SpatialGrid.h"
+#include "Utility/DistanceField.h"
+#include "Utility/Random.h"
+#include "Destroyer/BlastArea.h"
+#include "Utility/StateBuffer.h"
+#include "Simulation/WorldSnapshot.h"
+#include "Entity/Player.h"
+#include <vector>
 
 /** \class EnemyManager
  *  \brief Class which is used for keeping track of all the enemies in the game.
- *  \details This class contains the list of all enemies.
+ *  \details This class keeps the enemies in one EnemyBatch per kind.
  *           Has appropriate methods for adding enemies and drawing them.
- *           Also has an update method which calls the appropriate update
- *           method for all enemies.
+ *           Also has an update method which calls the update method of every
+ *           batch. Chasing enemies share one DistanceField to the players,
+ *           which is found again only when a player moves to another tile or
+ *           a wall of the map is destroyed.
+ *           Hordes are updated in two phases. First the enemies are split
+ *           into chunks of ENEMY_PARALLEL_CHUNK which may run on the
+ *           ThreadPool of the Relay: a chunk moves its own enemies and notes
+ *           which players they touch, reading only the map, the bombs and
+ *           boxes of the players taken before. Then the touched players are
+ *           killed on the calling thread, player after player, so a step
+ *           gives the same result on any number of threads.
  */
 class EnemyManager : public DisplayElement
 {
@@ -37,112 +53,145 @@ class EnemyManager : public DisplayElement
          *  \param tile_size represents the size of one tile of the map in
          *         pixels (which is required for proper implementation of method
          *         Draw())
-         *  \param relay pointer to the Relay object of the game
+         *  \param relay pointer to the Relay object of the game, its Map must
+         *         already be set
+         *  \param random generator of the World, every enemy gets its own
+         *         stream derived from it
          */
-        EnemyManager(std::string path_to_file,SDL_Texture* texture, unsigned int tile_size, Relay *relay);
+        EnemyManager(std::string path_to_file,SDL_Texture* texture, unsigned int tile_size, Relay *relay, const Random& random);
         ~EnemyManager();
         EnemyManager(const EnemyManager& other) = delete; /**< \brief Default copy constructor is disabled */
         EnemyManager& operator=(const EnemyManager&) = delete; /**< \brief Default operator = is disabled */
 
         /**
-         *  \brief Adds new Enemy to the list of enemies.
+         *  \brief Makes new enemy of kind EnemyBatch::ONE according to given
+         *         parameters and adds it to the enemies.
          *
-         *  Adds new Enemy to the list of enemies so that it will be periodically
-         *  updated and destroyed when the player kills them with bombs.
+         *  The enemy will be periodically updated and destroyed.
          *
-         *  \param enemy pointer to object Enemy which will be added to the list
-         *
-         *  \return void
-         */
-        void AddEnemy(Enemy *enemy);
-
-        /**
-         *  \brief Makes new EnemyOne according to given parameters and adds it
-         *         to the list of enemies.
-         *
-         *  Uses the given parameters and makes a new EnemyOne object and adds
-         *  it to the list of enemies same as method AddEnemy(). The enemy will
-         *  be periodically updated and destroyed.
-         *
-         *  \param x top left x coordinate of the enemy on the map
-         *  \param y top left y coordinate of the enemy on the map
+         *  \param x top left x coordinate of the enemy on the map in tiles
+         *  \param y top left y coordinate of the enemy on the map in tiles
          *
          *  \return void
          */
         void MakeEnemyOne(unsigned int x = 1, unsigned int y = 1);
 
         /**
-         *  \brief Makes new EnemyTwo according to given parameters and adds it
-         *         to the list of enemies.
+         *  \brief Makes new enemy of kind EnemyBatch::TWO according to given
+         *         parameters and adds it to the enemies.
          *
-         *  Uses the given parameters and makes a new EnemyTwo object and adds
-         *  it to the list of enemies same as method AddEnemy(). The enemy will
-         *  be periodically updated and destroyed.
+         *  The enemy will be periodically updated and destroyed.
          *
-         *  \param x top left x coordinate of the enemy on the map
-         *  \param y top left y coordinate of the enemy on the map
+         *  \param x top left x coordinate of the enemy on the map in tiles
+         *  \param y top left y coordinate of the enemy on the map in tiles
          *
          *  \return void
          */
         void MakeEnemyTwo(unsigned int x = 1, unsigned int y = 1);
 
         /**
-         *  \brief Makes new EnemyThree according to given parameters and adds
-         *         it to the list of enemies.
+         *  \brief Makes new enemy of kind EnemyBatch::THREE according to given
+         *         parameters and adds it to the enemies.
          *
-         *  Uses the given parameters and makes a new EnemyThree object and adds
-         *  it to the list of enemies same as method AddEnemy(). The enemy will
-         *  be periodically updated and destroyed.
+         *  The enemy will be periodically updated and destroyed.
          *
-         *  \param x top left x coordinate of the enemy on the map
-         *  \param y top left y coordinate of the enemy on the map
+         *  \param x top left x coordinate of the enemy on the map in tiles
+         *  \param y top left y coordinate of the enemy on the map in tiles
          *
          *  \return void
          */
         void MakeEnemyThree(unsigned int x = 1, unsigned int y = 1);
 
          /**
-         *  \brief Draw all the enemies it keeps track of on given SLD_Renderer
+         *  \brief Draw all the enemies it keeps track of to given RenderSnapshot
          *
-         *  Calls Enemy::Draw() methods for all the enemies it keeps track of with
-         *  the given SLD_Renderer so it will draw them on that same renderer.
-         *  \param renderer represents the SDL_Renderer on which the enemies
-         *         will be drawn on.
+         *  Calls EnemyBatch::Draw() methods for all the batches it keeps track of
+         *  with the given RenderSnapshot so it will add them to that same snapshot.
+         *  If the snapshot has a view, only the enemies found in its area by
+         *  the grid are drawn.
+         *  \param snapshot snapshot to which the enemies are added
          *
          *  \return void
          */
-        void Draw(SDL_Renderer* renderer) const;
+        void Draw(RenderSnapshot& snapshot) const;
 
         /**
          *  \brief Update function for class EnemyManager
          *
-         *  Calls the update methods of all the enemies it keeps track of.
+         *  Updates all chunks of enemies, on the ThreadPool of the Relay when
+         *  there are at least ENEMY_PARALLEL_MIN enemies, then kills the
+         *  players any enemy touched.
          *
          *  \return void
          */
         void Update();
 
         /**
-         *  \brief Kills the enemy if bomb is near enough.
+         *  \brief Kills the enemies near enough to any of the given bombs.
+         *
+         *  Uses Destroyer::Reaches() for every enemy in the cells around each
+         *  bomb to tell if the enemy is near the bomb.
+         *  Killed enemies are removed once all the bombs are done.
+         *
+         *  \param blasts areas hit by the bombs that exploded
+         *
+         *  \return void
+         */
+        void KillEnemies(const std::vector<BlastArea>& blasts);
+
+        /**
+         *  \brief Writes all enemies with their directions and walks
          *
-         *  Calls Destroyer::DestroyEnemy() method that for every enemy it keeps
-         *  track of decreases health if enemy is near the bomb.
+         *  \param state buffer to which the state is added
+         *  \return void
+         */
+        void SaveState(StateBuffer& state) const;
+        /**
+         *  \brief Replaces all enemies by the ones written by SaveState()
          *
-         *  \param x x coordinate of the center of the bomb on the map
-         *  \param y y coordinate of the center of the bomb on the map
-         *  \param intensity intensity of the bomb
+         *  The distances to the players are searched again on the next update.
+         *  \param state buffer from which the state is read
+         *  \return void
+         */
+        void LoadState(StateBuffer& state);
+        /**
+         *  \brief Adds the positions of all enemies, batch after batch
          *
+         *  \param snapshot snapshot of the World being taken
          *  \return void
          */
-        void KillEnemies(unsigned int x, unsigned int y, double intensity);
+        void TakeSnapshot(WorldSnapshot& snapshot) const;
 
     protected:
 
     private:
+        /** \brief Range of the enemies of one batch updated by one job */
+        struct Chunk
+        {
+            EnemyBatch*         batch;
+            unsigned int        first;
+            unsigned int        count;
+        };
+
         unsigned int            m_enemies_numb;
-        std::list<Enemy*>       m_enemies;
+        std::vector<EnemyBatch> m_batches; /**< one batch per EnemyBatch::Kind */
         Relay*                  m_relay;
         unsigned int            m_tile_size;
+        SpatialGrid<unsigned int> m_grid; /**< kind in the top byte, index in the batch below it */
+        DistanceField           m_field; /**< distances to the living players */
+        std::vector<unsigned int> m_goals; /**< tiles of the living players */
+        Random m_random; /**< generator of the World */
+        unsigned long m_made; /**< number of enemies made, gives the stream of the next one */
+        std::vector<Chunk>      m_chunks;
+        std::vector<Player*>    m_players; /**< players which can be touched, in the order of the PlayerManager */
+        std::vector<Contact::Box> m_boxes; /**< boxes of the players, taken before the chunks run */
+        std::vector<unsigned char> m_touched; /**< for every chunk whether it touched each player */
+
+        void RebuildGrid();
+        /** \brief Updates the enemies of one chunk and notes the players they touch */
+        void UpdateChunk(unsigned int chunk);
+        /** \brief Finds the distances to the players again if they moved to other tiles or the map changed */
+        void UpdateField();
 };
 
 #endif // ENEMYMANAGER_H
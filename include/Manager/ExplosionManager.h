@@ -9,9 +9,15 @@
  *
  */
 
-#include <list>
 #include "Display/DisplayElement.h"
 #include "Entity/Explosion.h"
+#include "Destroyer/BlastArea.h"
+#include "Utility/ObjectPool.h"
+#include "Utility/SpatialGrid.h"
+#include "Utility/StateBuffer.h"
+#include "Simulation/WorldSnapshot.h"
+#include "Utility/Relay.h"
+#include <vector>
 
 /** \class ExplosionManager
  *  \brief Class which is used for keeping track of all the explosions in the
@@ -35,8 +41,10 @@ class ExplosionManager : public DisplayElement
          *  \param tile_size represents the size of one tile of the map in
          *         pixels (which is required for proper implementation of method
          *         Draw())
+         *  \param relay pointer to Relay object of the game, gives the
+         *         SystemTimer the explosions are timed by
          */
-        ExplosionManager(SDL_Texture* texture, unsigned int tile_size);
+        ExplosionManager(SDL_Texture* texture, unsigned int tile_size, Relay* relay);
         /**
          *  \brief Destructor for ExplosionManager
          *
@@ -46,25 +54,15 @@ class ExplosionManager : public DisplayElement
         ExplosionManager(const ExplosionManager& other) = delete; /**< \brief Default copy constructor is disabled */
         ExplosionManager& operator=(const ExplosionManager&) = delete; /**< \brief Default operator = is disabled */
 
-        /**
-         *  \brief Adds new Explosion to the list of explosions.
-         *
-         *  Adds new Explosion to the list of explosions so that it will be
-         *  periodically updated and destroyed when it's animation plays out.
-         *
-         *  \param explosion pointer to object Explosion which will be added to
-         *         the list
-         *  \return void
-         */
-        void AddExplosion(Explosion *explosion);
         /**
          *  \brief Makes new Explosion according to given parameters and adds it
          *         to the list of explosions.
          *
          *  Uses the given parameters and makes a new Explosion object and adds
-         *  it to the list of explosions same as method
-         *  AddExplosion(Explosion *explosion). The explosion will be
-         *  periodically updated and destroyed when it's animation plays out.
+         *  it to the list of explosions. The explosion will be periodically
+         *  updated and destroyed when it's animation plays out. Explosions are
+         *  kept in a pool of POOL_EXPLOSION_CAPACITY slots, when all of them
+         *  are taken the explosion is not shown.
          *
          *  \param duration duration of explosion's animation in milliseconds
          *  \param x_center center x coordinate of the explosion on the map
@@ -77,6 +75,18 @@ class ExplosionManager : public DisplayElement
                            unsigned int x_center,
                            unsigned int y_center,
                            double intensity);
+        /**
+         *  \brief Makes one Explosion for every given bomb and adds them to
+         *         the list of explosions.
+         *
+         *  Same as calling MakeExplosion() for every bomb, used when many
+         *  bombs go off in the same tick.
+         *
+         *  \param duration duration of explosions' animation in milliseconds
+         *  \param blasts areas hit by the bombs that exploded
+         *  \return void
+         */
+        void MakeExplosions(unsigned int duration, const std::vector<BlastArea>& blasts);
         /**
          *  \brief Update function for class ExplosionManager
          *
@@ -86,24 +96,50 @@ class ExplosionManager : public DisplayElement
          */
         void Update();
         /**
-         *  \brief Draw all the explosion it keeps track of on given
-         *         SLD_Renderer
+         *  \brief Draw all the explosion it keeps track of to given
+         *         RenderSnapshot
          *
          *  Calls Explosion::Draw() methods for all the explosions it keeps
-         *  track of with the given SLD_Renderer so it will draw them on that
-         *  same renderer.
-         *  \param renderer represents the SDL_Renderer on which the bombs
-         *         will be drawn on.
+         *  track of with the given RenderSnapshot so it will add them to that
+         *  same snapshot. When the snapshot has a view only the explosions
+         *  reaching into its area are found through the grid.
+         *  \param snapshot snapshot to which the explosions are added
+         *
+         *  \return void
+         */
+        void Draw(RenderSnapshot& snapshot) const;
+
+        /**
+         *  \brief Writes all explosions
+         *
+         *  \param state buffer to which the state is added
+         *  \return void
+         */
+        void SaveState(StateBuffer& state) const;
+        /**
+         *  \brief Replaces all explosions by the ones written by SaveState()
+         *
+         *  The explosions are made again in the order they were written.
+         *  \param state buffer from which the state is read
+         *  \return void
+         */
+        void LoadState(StateBuffer& state);
+        /**
+         *  \brief Adds the tiles of all explosions with their sizes
          *
+         *  The Map must be taken first, as the tiles are found from its size.
+         *  \param snapshot snapshot of the World being taken
          *  \return void
          */
-        void Draw(SDL_Renderer* renderer) const;
+        void TakeSnapshot(WorldSnapshot& snapshot) const;
 
     protected:
 
     private:
-        std::list<Explosion*>   m_explosions;
+        ObjectPool<Explosion>   m_explosions;
         unsigned int            m_tile_size;
+        SystemTimer*            m_system_timer;
+        SpatialGrid<Explosion*> m_grid; /**< explosions by the cell of their center */
 };
 
 #endif // EXPLOSIONMANAGER_H
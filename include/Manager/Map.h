@@ -14,6 +14,10 @@
 #include "Display/DisplayElement.h"
 #include "Utility/Relay.h"
 #include "Entity/MapObject.h"
+#include "Utility/CollisionMask.h"
+#include "Utility/Random.h"
+#include "Utility/StateBuffer.h"
+#include "Simulation/WorldSnapshot.h"
 
 /** \class Map
  *  \brief Class which represents one level of the game.
@@ -38,12 +42,13 @@ class Map : public DisplayElement
          *         method Draw()
          *  \param relay pointer to the relay object which is used to
          *         communicate with other game objects
+         *  \param random generator of the World, the looks of the tiles and
+         *         the pickups left by walls are drawn from streams derived
+         *         from it
          */
-        Map(std::string path_to_file, SDL_Texture* texture, unsigned int tile_size, Relay* relay);
+        Map(std::string path_to_file, SDL_Texture* texture, unsigned int tile_size, Relay* relay, const Random& random);
         /**
          *  \brief Destructor for Map
-         *
-         *  Destroys all MapObjects on the map before deleting itself.
          */
         ~Map();
         Map(const Map& other) = delete; /**< \brief Default copy constructor is disabled */
@@ -52,34 +57,61 @@ class Map : public DisplayElement
         unsigned int GetHeight() const { return m_height; } /**< \brief Gives height of map in tiles */
         unsigned int GetWidth() const { return m_width; } /**< \brief Gives width of map in tiles */
         unsigned int GetTileSize() const { return m_tile_size; } /**< \brief Gives size of a tile in pixels */
+        unsigned long GetRevision() const { return m_opened.size(); } /**< \brief Gives number of times a tile became walkable */
+        /** \brief Gives indexes (row * width + column) of the tiles that became walkable, in that order */
+        const std::vector<unsigned int>& GetOpenedTiles() const { return m_opened; }
+        /** \brief Gives revision of the looks of the tiles, starts at 1 and grows with every tile whose look changed */
+        unsigned long GetLayerRevision() const { return m_redraw_revision + m_changed.size(); }
 
         /**
          *  \brief Tells if the tile at given coordinates is walkable on
          *
          *  Specifically it checks if the MapObject on given coordinates is of
-         *  type MapObject::EMPTY and return true if it is.
+         *  type MapObject::EMPTY and return true if it is. Coordinates outside
+         *  of the map are never walkable.
          *  \param i row coordinate of the map
          *  \param j column coordinate of the map
          *  \return true if the tile at the given coordinates is empty
          */
-        bool Walkable(unsigned int i,unsigned int j) const;
+        bool Walkable(int i, int j) const
+        {
+            return m_collision.Walkable(i, j);
+        }
+        /**
+         *  \brief Tells if a rectangle can be moved by the given offset
+         *
+         *  Checks whether all tiles that the rectangle would touch after
+         *  moving by (dx,dy) pixels are walkable. Used by everything that
+         *  moves on the map.
+         *  \param x x coordinate of the rectangle in pixels
+         *  \param y y coordinate of the rectangle in pixels
+         *  \param w width of the rectangle in pixels
+         *  \param h height of the rectangle in pixels
+         *  \param dx movement along x axis in pixels
+         *  \param dy movement along y axis in pixels
+         *  \return true if the rectangle can be moved
+         */
+        bool CanMove(int x, int y, unsigned int w, unsigned int h, int dx, int dy) const
+        {
+            return m_collision.CanMove(x, y, w, h, dx, dy);
+        }
         /**
-         *  \brief Draw the map's current layout on the given renderer
+         *  \brief Draw the map's current layout to given RenderSnapshot
          *
-         *  Calls MapObject::Draw() methods for all the MapObject in it's layout
-         *  and draws them on the given renderer.
-         *  \param renderer represents the SDL_Renderer on which the map will be
-         *         drawn on.
+         *  Sets the map layer of the snapshot and adds the tiles whose look
+         *  changed since the layer base of the snapshot, or every tile if
+         *  the base is 0 or of another map.
+         *  \param snapshot snapshot to which the map is added
          *
          *  \return void
          */
-        void Draw(SDL_Renderer* renderer) const;
+        void Draw(RenderSnapshot& snapshot) const;
         /**
          *  \brief Destroys wall on given coordinates
          *
          *  Checks if the wall on the given coordinates id of type
-         *  MapObject::DESTRUCTABLE_WALL and swaps it with object of type
-         *  MapObject::EMPTY
+         *  MapObject::DESTRUCTABLE_WALL, damages it and once it is destroyed
+         *  turns the tile into MapObject::EMPTY
          *  \param i row coordinate of the map
          *  \param j column coordinate of the map
          *  \param damage value in percent that the bomb should do to a wall
@@ -97,7 +129,10 @@ class Map : public DisplayElement
          *
          *  \return MapObject::Tile which represents the type of object
          */
-        MapObject::Tile GetTileType(unsigned int i, unsigned int j) const;
+        MapObject::Tile GetTileType(unsigned int i, unsigned int j) const
+        {
+            return m_layout[i*m_width + j].GetId();
+        }
         /**
          *  \brief Update method for Map
          *
@@ -107,6 +142,30 @@ class Map : public DisplayElement
          */
         void Update() {}
 
+        /**
+         *  \brief Writes the tiles of the map with the integrity of the walls
+         *
+         *  \param state buffer to which the state is added
+         *  \return void
+         */
+        void SaveState(StateBuffer& state) const;
+        /**
+         *  \brief Replaces the tiles by the ones written by SaveState()
+         *
+         *  The map must be of the same level. Tiles which look different
+         *  afterwards count as changed for GetLayerRevision().
+         *  \param state buffer from which the state is read
+         *  \return void
+         */
+        void LoadState(StateBuffer& state);
+        /**
+         *  \brief Gives the size of the map and the tiles which became walkable
+         *
+         *  \param snapshot snapshot of the World being taken
+         *  \return void
+         */
+        void TakeSnapshot(WorldSnapshot& snapshot) const;
+
     protected:
 
         /**
@@ -128,14 +187,29 @@ class Map : public DisplayElement
          *
          */
          void TryPlacePickUp(unsigned int i, unsigned int j);
+        /**
+         *  \brief Adds a tile whose look changed to the log of changes
+         *
+         *  Once the log has no room left it is cleared and the next revision
+         *  is drawn in full, so loading many states does not make it grow.
+         *  \param index index of the tile (row * width + column)
+         *  \return void
+         */
+        void LogChange(unsigned int index);
 
     private:
         unsigned int                            m_height;
         unsigned int                            m_width;
-        std::vector<std::vector<MapObject*>>    m_layout;
+        std::vector<MapObject>                  m_layout; /**< tiles in row-major order */
         const int                               m_tile_size;
+        CollisionMask                           m_collision;
         Relay*                                  m_relay;
         unsigned int                            m_wall_count;
+        std::vector<unsigned int>               m_opened; /**< every wall opens once, so room for all is made up front */
+        std::vector<unsigned int>               m_changed; /**< tiles whose look changed, in that order, not part of the state */
+        unsigned long                           m_redraw_revision; /**< revision from which m_changed starts, older ones are drawn in full */
+        std::vector<MapObject>                  m_loaded; /**< tiles before LoadState(), to find the changed ones */
+        Random                                  m_pickup_random;
 };
 
 #endif // MAP_H
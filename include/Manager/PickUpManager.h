@@ -12,7 +12,13 @@
 #include "Display/DisplayElement.h"
 #include "Utility/Relay.h"
 #include "Entity/PickUp.h"
-#include <list>
+#include "Utility/Contact.h"
+#include "Utility/SpatialGrid.h"
+#include "Utility/ObjectPool.h"
+#include "Utility/StateBuffer.h"
+#include "Simulation/WorldSnapshot.h"
+#include <vector>
+#include <cstdint>
 
 /** \class PickUpManager
  *  \brief Class which is used for keeping track of all pickups in the game.
@@ -37,10 +43,12 @@ class PickUpManager : public DisplayElement
          *  \param tile_size represents the size of one tile of the map in
          *         pixels (which is required for proper implementation of method
          *         Draw())
+         *  \param capacity largest number of pickups on the map at the same
+         *         time, at most one per tile of the map is ever needed
          *  \param relay pointer to the relay object which is used to
          *         communicate with other game objects
          */
-        PickUpManager(SDL_Texture* texture, unsigned int tile_size, Relay* relay);
+        PickUpManager(SDL_Texture* texture, unsigned int tile_size, unsigned int capacity, Relay* relay);
         /**
          *  \brief Destructor for PickUpManager
          *
@@ -50,25 +58,14 @@ class PickUpManager : public DisplayElement
         PickUpManager(const PickUpManager& other) = delete; /**< \brief Default copy constructor is disabled */
         PickUpManager& operator=(const PickUpManager&) = delete; /**< \brief Default operator = is disabled */
 
-        /**
-         *  \brief Adds new PickUp to the list of pickups.
-         *
-         *  Adds new PickUp to the list of pickups so that it will be
-         *  periodically updated and destroyed when it has been used.
-         *
-         *  \param pickup pointer to object PickUp which will be added to the
-         *         list
-         *  \return void
-         */
-        void AddPickUp(PickUp* pickup);
         /**
          *  \brief Makes new PickUp according to given parameters and adds it to
          *         the list of pickups.
          *
          *  Uses the given parameters and makes a new PickUp object and adds it
-         *  to the list of pickups same as method AddPickUp(PickUp* pickup). The
-         *  PickUp will be periodically updated and destroyed when it has been
-         *  used.
+         *  to the list of pickups. The PickUp will be periodically updated and
+         *  destroyed when it has been used. No PickUp is made when the pool of
+         *  pickups is full.
          *
          *  \param type describes type of PickUp to be made
          *  \param x center x coordinate of the PickUp on the map
@@ -89,17 +86,58 @@ class PickUpManager : public DisplayElement
          */
         void Update();
         /**
-         *  \brief Draw all the pickups it keeps track of on given SLD_Renderer
+         *  \brief Draw all the pickups it keeps track of to given RenderSnapshot
          *
          *  Calls PickUp::Draw() method for all the pickups it keeps track of
-         *  with the given SLD_Renderer as parameter so it will draw them on
-         *  that same renderer.
-         *  \param renderer represents the SDL_Renderer on which the pickups
-         *         will be drawn on.
+         *  with the given RenderSnapshot as parameter so it will add them to
+         *  that same snapshot. When the snapshot has a view only the pickups
+         *  in its area are found through the grid.
+         *  \param snapshot snapshot to which the pickups are added
          *
          *  \return void
          */
-        void Draw(SDL_Renderer* renderer) const;
+        void Draw(RenderSnapshot& snapshot) const;
+        /**
+         *  \brief Calls visit for every pickup whose center is inside the
+         *         given area
+         *
+         *  Only pickups in the cells around the area are taken from the grid,
+         *  their centers are packed and tested at once by Contact::Points().
+         *  Pickups are visited in the order the grid gives them.
+         *  \param x x coordinate of the area on the map
+         *  \param y y coordinate of the area on the map
+         *  \param w width of the area in pixels
+         *  \param h height of the area in pixels
+         *  \param visit function called with pointer to every touched PickUp
+         *
+         *  \return void
+         */
+        template <typename F>
+        void TouchPickUps(unsigned int x, unsigned int y, unsigned int w, unsigned int h, F visit)
+        {
+            m_candidates.clear();
+            m_candidate_x.clear();
+            m_candidate_y.clear();
+            m_grid.Query(x, y, w, h, [&](PickUp* pickup)
+            {
+                m_candidates.push_back(pickup);
+                m_candidate_x.push_back(pickup->GetX());
+                m_candidate_y.push_back(pickup->GetY());
+            });
+
+            unsigned int n = m_candidates.size();
+            Contact::Box box = {x, y, x + w, y + h};
+            if(m_touch_mask.size() < Contact::MaskWords(n))
+                m_touch_mask.resize(Contact::MaskWords(n));
+            if(n == 0 || !Contact::Points(box, m_candidate_x.data(), m_candidate_y.data(), n, m_touch_mask.data()))
+                return;
+
+            for(unsigned int word = 0; word < Contact::MaskWords(n); ++word)
+            {
+                for(uint32_t bits = m_touch_mask[word]; bits != 0; bits &= bits - 1)
+                    visit(m_candidates[word*32 + __builtin_ctz(bits)]);
+            }
+        }
 
         /** \class PickUpManager::Iterator
          *  \brief Class which is used for iterating through list of PickUp
@@ -150,22 +188,51 @@ class PickUpManager : public DisplayElement
             Iterator& operator++ ();
 
         private:
-            std::list<PickUp*>* m_pickups_pointer;
-            std::list<PickUp*>::iterator it;
+            ObjectPool<PickUp>* m_pickups_pointer;
+            ObjectPool<PickUp>::const_iterator it;
 
-            inline std::list<PickUp*>::iterator Begin() const;
-            inline std::list<PickUp*>::iterator End() const;
-            inline std::list<PickUp*>::iterator Current() const;
-            inline std::list<PickUp*>::iterator Next();
+            inline ObjectPool<PickUp>::const_iterator Begin() const;
+            inline ObjectPool<PickUp>::const_iterator End() const;
+            inline ObjectPool<PickUp>::const_iterator Current() const;
+            inline ObjectPool<PickUp>::const_iterator Next();
         };
 
+        /**
+         *  \brief Writes all pickups on the map
+         *
+         *  \param state buffer to which the state is added
+         *  \return void
+         */
+        void SaveState(StateBuffer& state) const;
+        /**
+         *  \brief Replaces all pickups by the ones written by SaveState()
+         *
+         *  The pickups are made again in the order they were written.
+         *  \param state buffer from which the state is read
+         *  \return void
+         */
+        void LoadState(StateBuffer& state);
+        /**
+         *  \brief Adds the tiles of all pickups with their types
+         *
+         *  The Map must be taken first, as the tiles are found from its size.
+         *  \param snapshot snapshot of the World being taken
+         *  \return void
+         */
+        void TakeSnapshot(WorldSnapshot& snapshot) const;
+
     protected:
 
     private:
-        std::list<PickUp*>      m_pickups;
+        ObjectPool<PickUp>      m_pickups;
         unsigned int            m_tile_size;
         unsigned int            m_draw_size;
         Relay*                  m_relay;
+        SpatialGrid<PickUp*>    m_grid; /**< pickups by the cell of their center */
+        std::vector<PickUp*>    m_candidates; /**< pickups near the area of TouchPickUps() */
+        std::vector<unsigned int> m_candidate_x; /**< center x of i-th candidate */
+        std::vector<unsigned int> m_candidate_y; /**< center y of i-th candidate */
+        std::vector<uint32_t>   m_touch_mask; /**< filled by TouchPickUps() */
         //Iterator                m_iterator;
 };
 
@@ -15,7 +15,11 @@
 #include "Entity/Player.h"
 #include "Utility/Timer.h"
 #include "Utility/Relay.h"
+#include "Utility/SpatialGrid.h"
+#include "Destroyer/BlastArea.h"
 #include "SDL2/SDL_mixer.h"
+#include "Utility/StateBuffer.h"
+#include "Simulation/WorldSnapshot.h"
 
 /** \class PlayerManager
  *  \brief Class which is used for keeping track of player in the game.
@@ -63,6 +67,7 @@ class PlayerManager : public DisplayElement
          *  \return bool
          */
         bool AreAllDead() const;
+        unsigned int GetPlayersNumber() const { return m_players.size(); } /**< \brief Gives number of players in the game */
 
         /**
          *  \brief Check if level is completed by players.
@@ -102,32 +107,31 @@ class PlayerManager : public DisplayElement
         void MakePlayer(unsigned int player_id = 0, unsigned int x = 1, unsigned int y = 1);
 
         /**
-         *  \brief Draw the player it keeps track of on given SLD_Renderer.
+         *  \brief Draw the player it keeps track of to given RenderSnapshot.
          *
          *  Calls Player::Draw() method for the player it keeps track of with
-         *  the given SLD_Renderer so it will draw them on that same renderer.
+         *  the given RenderSnapshot so it will add them to that same snapshot.
          *
-         *  \param renderer represents the SDL_Renderer on which the player
-         *         will be drawn on.
+         *  \param snapshot snapshot to which the player is added
          *
          *  \return void
          */
-        void Draw(SDL_Renderer* renderer) const;
+        void Draw(RenderSnapshot& snapshot) const;
 
         /**
-         *  \brief Draws the life board it keeps track of on given SLD_Renderer.
+         *  \brief Draws the life board it keeps track of to given RenderSnapshot.
          *
-         *  Draws lives of the player on the given SLD_Renderer so it
-         *  will draw them on that same renderer.
+         *  Draws lives of the player to the given RenderSnapshot so it
+         *  will add them to that same snapshot, as an overlay which stays
+         *  in its place on the screen when the view moves.
          *
-         *  \param renderer represents the SDL_Renderer on which the player
-         *         will be drawn on.
+         *  \param snapshot snapshot to which the lives are added
          *  \param player_id represents the ID of the player
          *  \param lives represents number of lives that are going to be drawn
          *
          *  \return void
          */
-        void DrawScore(SDL_Renderer* renderer, unsigned int player_id, unsigned int lives) const;
+        void DrawScore(RenderSnapshot& snapshot, unsigned int player_id, unsigned int lives) const;
 
         /**
          *  \brief Update function for class PlayerManager.
@@ -139,18 +143,36 @@ class PlayerManager : public DisplayElement
         void Update();
 
         /**
-         *  \brief Kills the player if bomb is near enough.
+         *  \brief Kills the players near enough to any of the given bombs.
          *
-         *  Calls Destroyer::DestroyPlayer() method that for every player it
-         *  keeps track of, decreases health if player is near the bomb.
+         *  Calls Destroyer::DestroyPlayer() method that for every player in
+         *  the cells around each bomb decreases health if player is near the
+         *  bomb.
          *
-         *  \param x x coordinate of the center of the bomb on the map
-         *  \param y y coordinate of the center of the bomb on the map
-         *  \param intensity intensity of the bomb
+         *  \param blasts areas hit by the bombs that exploded
          *
          *  \return void
          */
-        void KillPlayer(unsigned int x, unsigned int y, double intensity);
+        void KillPlayer(const std::vector<BlastArea>& blasts);
+        /**
+         *  \brief Calls visit for every player which may touch the given area
+         *
+         *  Only players in the cells around the area are looked at, the exact
+         *  collision test is left to the caller. Positions are the ones the
+         *  players had at the end of the last Update().
+         *  \param x x coordinate of the area on the map
+         *  \param y y coordinate of the area on the map
+         *  \param w width of the area in pixels
+         *  \param h height of the area in pixels
+         *  \param visit function called with pointer to every found Player
+         *
+         *  \return void
+         */
+        template <typename F>
+        void QueryPlayers(int x, int y, unsigned int w, unsigned int h, F visit) const
+        {
+            m_grid.Query(x, y, w, h, visit);
+        }
 
 
         /** \class PlayerManager::Iterator
@@ -211,6 +233,29 @@ class PlayerManager : public DisplayElement
             inline std::vector<Player*>::iterator Next();
         };
 
+        /**
+         *  \brief Writes the state of all players
+         *
+         *  \param state buffer to which the state is added
+         *  \return void
+         */
+        void SaveState(StateBuffer& state) const;
+        /**
+         *  \brief Reads the state of all players written by SaveState()
+         *
+         *  The same players must have been made from the level file.
+         *  \param state buffer from which the state is read
+         *  \return void
+         */
+        void LoadState(StateBuffer& state);
+        /**
+         *  \brief Adds the positions, lives and directions of all players
+         *
+         *  \param snapshot snapshot of the World being taken
+         *  \return void
+         */
+        void TakeSnapshot(WorldSnapshot& snapshot) const;
+
     protected:
 
     private:
@@ -222,6 +267,9 @@ class PlayerManager : public DisplayElement
         Relay*                   m_relay;
         unsigned int             m_tile_size;
         Mix_Chunk*               m_kill_sound;
+        SpatialGrid<Player*>     m_grid;
+
+        void RebuildGrid();
 };
 
 #endif // PLAYERMANAGER_H
@@ -0,0 +1,51 @@
+#ifndef NETWORKOPTIONS_H
+#define NETWORKOPTIONS_H
+
+/**
+ *  \file NetworkOptions.h
+ *
+ *  Defines struct NetworkOptions which holds how a game over the network is
+ *  set up, as given on the command line
+ *
+ */
+
+#include <string>
+#include <cstdint>
+
+/** \struct NetworkOptions
+ *  \brief Settings of a two player game between two devices
+ *  \details Both peers must be given the same level and seed, and different
+ *           players. Latency, jitter and loss only fake a slower network for
+ *           the packets this peer sends, so two processes on one machine
+ *           each given a latency of 50 play as over a round trip of 100
+ *           milliseconds.
+ */
+struct NetworkOptions
+{
+    unsigned short  local_port = 0;
+    std::string     peer_host = "127.0.0.1";
+    unsigned short  peer_port = 0;
+    unsigned int    local_player = 0; /**< 0 or 1, the player steered on this device */
+    unsigned int    level = 1;
+    uint64_t        seed = 1;
+    unsigned int    latency = 0; /**< milliseconds sent packets are held back */
+    unsigned int    jitter = 0; /**< most milliseconds added to the latency */
+    unsigned int    loss = 0; /**< percent of sent packets which are dropped */
+
+    /** \brief Tells if a game over the network was asked for */
+    bool Enabled() const { return local_port != 0 && peer_port != 0; }
+
+    /**
+     *  \brief Reads one network option from the command line
+     *
+     *  Knows --net-port N, --net-peer HOST:PORT, --net-player N,
+     *  --latency MS, --jitter MS and --loss PERCENT.
+     *  \param argc number of arguments
+     *  \param argv arguments
+     *  \param i index of the argument, moved past its value if it was read
+     *  \return false if the argument is not a network option
+     */
+    bool ParseArgument(int argc, char* argv[], int& i);
+};
+
+#endif // NETWORKOPTIONS_H
@@ -0,0 +1,171 @@
+#ifndef ROLLBACKSESSION_H
+#define ROLLBACKSESSION_H
+
+/**
+ *  \file RollbackSession.h
+ *
+ *  Defines class RollbackSession which plays a two player World on two
+ *  devices, exchanging the buttons over UDP and rolling back when the
+ *  predicted buttons of the peer were wrong
+ *
+ */
+
+#include "Simulation/World.h"
+#include "Simulation/ScriptedInput.h"
+#include "Network/UdpSocket.h"
+#include "Utility/StateBuffer.h"
+#include "Constants/NetworkConstants.h"
+#include <vector>
+#include <cstdint>
+
+/** \class RollbackSession
+ *  \brief Class which steps a World together with a peer playing the other
+ *         player
+ *  \details Each device steers one player and sends its buttons of every
+ *           step to the peer, together with the buttons of the steps the peer
+ *           has not confirmed yet, so lost packets need no resending. The
+ *           local buttons are used NETWORK_INPUT_DELAY steps after they are
+ *           read. The peer's buttons of a step which has not arrived yet are
+ *           predicted to be the last ones that did, and the World is stepped
+ *           on without waiting. The state of the World is saved before every
+ *           step; when the peer's buttons arrive and differ from the predicted
+ *           ones the World is loaded back to that step and all later steps
+ *           are played again within the same call, so the game keeps the
+ *           input latency of a local game even at 100 ms round trip. Only
+ *           when the peer's buttons are NETWORK_MAX_ROLLBACK steps late, or
+ *           this device runs ahead of the peer, a step is skipped.
+ *           Both devices compare checksums of confirmed states now and then
+ *           to notice if their games went apart.
+ */
+class RollbackSession
+{
+    public:
+        /**
+         *  \brief Constructor for RollbackSession
+         *
+         *  The World must be just made, with two players and its SystemTimer
+         *  at the same step as on the peer.
+         *  \param world World of the game, stepped only by the session
+         *  \param world_input input from which the World's players read their
+         *         buttons, set by the session on every step
+         *  \param local_player 0 or 1, the player steered on this device
+         *  \param level number of the level, checked against the peer's
+         *  \param socket socket opened towards the peer
+         */
+        RollbackSession(World* world,
+                        ScriptedInput* world_input,
+                        unsigned int local_player,
+                        unsigned int level,
+                        UdpSocket* socket);
+        RollbackSession(const RollbackSession& other) = delete; /**< \brief Default copy constructor is disabled */
+        RollbackSession& operator=(const RollbackSession&) = delete; /**< \brief Default operator = is disabled */
+
+        /**
+         *  \brief Gives the buttons of this device as bits
+         *
+         *  The buttons are those of the first player, whichever player is
+         *  steered, bits are up, down, left, right and bomb.
+         *  \param input input fed by the user
+         *  \return buttons held as bits
+         */
+        uint8_t ReadButtons(KeyboardInput* input) const;
+        /**
+         *  \brief Makes one step of the game
+         *
+         *  Reads the packets of the peer, rolls back and plays again if some
+         *  predicted buttons were wrong, then steps the World with the given
+         *  buttons of this device and sends them. The SystemTimer must
+         *  already be moved to the new step, which is taken back when the
+         *  step is skipped.
+         *  \param buttons buttons of this device as given by ReadButtons()
+         *  \return false if the step was skipped to wait for the peer
+         */
+        bool Advance(uint8_t buttons);
+        /**
+         *  \brief Reads and sends packets without stepping the game
+         *
+         *  Rolls back if some predicted buttons were wrong. Used when this
+         *  device made its last step and waits for the peer to confirm them.
+         *  \return void
+         */
+        void Poll();
+        /**
+         *  \brief Sends the last buttons again
+         *
+         *  Called when the level ended, so the peer gets them even if the
+         *  last packets were lost.
+         *  \return void
+         */
+        void Finish();
+
+        /** \brief Tells if the peer was heard from */
+        bool Connected() const { return m_connected; }
+        /** \brief Tells if all steps made so far were made with the peer's real buttons */
+        bool Confirmed() const { return m_remote_confirmed + 1 >= m_step && m_rollback_from < 0; }
+        long GetStep() const { return m_step; } /**< \brief Gives number of steps made */
+        unsigned long GetRollbacks() const { return m_rollbacks; } /**< \brief Gives number of rollbacks */
+        unsigned long GetRolledBackSteps() const { return m_rolled_back_steps; } /**< \brief Gives number of steps played again */
+        unsigned int GetLongestRollback() const { return m_longest_rollback; } /**< \brief Gives most steps played again at once */
+        unsigned long GetSkippedSteps() const { return m_skipped_steps; } /**< \brief Gives number of steps skipped to wait */
+        unsigned long GetComparedChecksums() const { return m_compared_checksums; } /**< \brief Gives number of checksums compared with the peer */
+        unsigned long GetDesyncs() const { return m_desyncs; } /**< \brief Gives number of checksums which differed */
+
+    protected:
+
+    private:
+        /** \brief Reads all waiting packets of the peer */
+        void Receive();
+        /** \brief Sends the buttons the peer has not confirmed */
+        void Send();
+        /** \brief Loads the state before the first wrongly predicted step and plays up to now again */
+        void Rollback();
+        /** \brief Saves the state and steps the World with the buttons of the given step */
+        void Simulate(long step);
+        /** \brief Tells how many steps to wait so the peer can catch up */
+        long StepsAhead() const;
+        /** \brief Makes the checksums of the states which got confirmed */
+        void MakeChecksums();
+        /** \brief Compares a checksum of the peer with the own one of the same step */
+        void CompareChecksum(long step, uint32_t checksum);
+
+        World*                      m_world;
+        ScriptedInput*              m_world_input;
+        unsigned int                m_local_player;
+        unsigned int                m_level;
+        UdpSocket*                  m_socket;
+        std::vector<SDL_Keycode>    m_keys; /**< up, down, left, right and bomb of every player */
+        bool                        m_connected;
+
+        long                        m_step; /**< next step to make */
+        long                        m_local_last; /**< last step with local buttons */
+        long                        m_remote_confirmed; /**< last step with the peer's buttons */
+        long                        m_remote_acked; /**< last step of local buttons the peer has */
+        long                        m_remote_step; /**< newest step the peer told of */
+        long                        m_remote_ahead; /**< how far the peer saw itself ahead */
+        long                        m_rollback_from; /**< first wrongly predicted step, -1 if none */
+        long                        m_wait; /**< steps still to skip for the peer to catch up */
+        long                        m_next_sync; /**< step at which waiting is considered again */
+
+        uint8_t                     m_local[NETWORK_HISTORY];
+        uint8_t                     m_remote[NETWORK_HISTORY];
+        uint8_t                     m_used[NETWORK_HISTORY]; /**< peer's buttons the step was made with */
+        std::vector<StateBuffer>    m_states; /**< state before every step */
+        StateBuffer                 m_packet;
+        std::vector<uint8_t>        m_received;
+
+        long                        m_checksum_next; /**< next step whose state gets a checksum */
+        long                        m_checksum_steps[NETWORK_CHECKSUMS];
+        uint32_t                    m_checksums[NETWORK_CHECKSUMS];
+        long                        m_remote_checksum_step; /**< newest checksum of the peer */
+        uint32_t                    m_remote_checksum;
+        long                        m_compared_step; /**< newest step whose checksums were compared */
+
+        unsigned long               m_rollbacks;
+        unsigned long               m_rolled_back_steps;
+        unsigned int                m_longest_rollback;
+        unsigned long               m_skipped_steps;
+        unsigned long               m_compared_checksums;
+        unsigned long               m_desyncs;
+};
+
+#endif // ROLLBACKSESSION_H
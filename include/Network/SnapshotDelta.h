@@ -0,0 +1,57 @@
+#ifndef SNAPSHOTDELTA_H
+#define SNAPSHOTDELTA_H
+
+/**
+ *  \file SnapshotDelta.h
+ *
+ *  Defines class SnapshotDelta which writes a WorldSnapshot as its changes
+ *  against an older one, packed into bits
+ *
+ */
+
+#include "Simulation/WorldSnapshot.h"
+#include "Utility/BitStream.h"
+
+/** \class SnapshotDelta
+ *  \brief Class which packs snapshots of a World for viewers
+ *  \details A snapshot is written against a base the viewer is known to
+ *           have, usually the last one it acknowledged. Only the tiles
+ *           opened since the base are written. A player or enemy which did
+ *           not move takes one bit, one which moved a few pixels eleven bits,
+ *           others are written in full with as many bits as the size of the
+ *           map needs. Bombs, explosions and pickups are written as the
+ *           entries of the base which are gone and the ones which are new.
+ *           Without a base, or with a base of another level or seed, the
+ *           snapshot is written in full.
+ */
+class SnapshotDelta
+{
+    public:
+        /**
+         *  \brief Writes a snapshot against a base
+         *
+         *  \param base snapshot the reader has, or nullptr
+         *  \param snapshot snapshot to write
+         *  \param out writer to which the bits are added
+         *  \return false if the snapshot was written in full as the base did
+         *          not fit
+         */
+        static bool Write(const WorldSnapshot* base, const WorldSnapshot& snapshot, BitWriter& out);
+        /**
+         *  \brief Reads a snapshot written by Write()
+         *
+         *  \param base the same base given to Write(), or nullptr if the
+         *         reader does not have it
+         *  \param in reader of the bits
+         *  \param snapshot snapshot which is filled
+         *  \return false if the bits are broken or were written against a
+         *          base which was not given
+         */
+        static bool Read(const WorldSnapshot* base, BitReader& in, WorldSnapshot& snapshot);
+
+    private:
+        /** \brief Tells if a snapshot can be written against a base */
+        static bool Fits(const WorldSnapshot& base, const WorldSnapshot& snapshot);
+};
+
+#endif // SNAPSHOTDELTA_H
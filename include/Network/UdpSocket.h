@@ -0,0 +1,149 @@
+#ifndef UDPSOCKET_H
+#define UDPSOCKET_H
+
+/**
+ *  \file UdpSocket.h
+ *
+ *  Defines class UdpSocket which sends packets to one peer or to many clients
+ *  over UDP, with an optional shim holding them back to fake a slow network
+ *
+ */
+
+#include "Utility/Random.h"
+#include "Constants/NetworkConstants.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/** \class UdpSocket
+ *  \brief Class which exchanges packets with one peer or many clients over UDP
+ *  \details The socket never blocks: Receive() gives nothing if no packet is
+ *           waiting. A socket opened towards a peer drops packets from any
+ *           other address, a socket opened only on a port, as a server's
+ *           is, takes them from anyone and tells whom they came from.
+ *           For testing on one machine the socket can hold every sent packet
+ *           back for a while, drawn from a delay and a jitter, and drop some
+ *           of them, so two processes on loopback play as over a real
+ *           network. Held packets go out from Flush(), which Send() and
+ *           Receive() call as well.
+ */
+class UdpSocket
+{
+    public:
+        /** \brief IPv4 address and port, both in network byte order */
+        struct Address
+        {
+            uint32_t        host;
+            uint16_t        port;
+
+            bool operator==(const Address& other) const { return host == other.host && port == other.port; }
+        };
+
+        /**
+         *  \brief Constructor for UdpSocket
+         *
+         *  Makes a closed socket.
+         */
+        UdpSocket();
+        /**
+         *  \brief Destructor for UdpSocket
+         *
+         *  Closes the socket.
+         */
+        ~UdpSocket();
+        UdpSocket(const UdpSocket& other) = delete; /**< \brief Default copy constructor is disabled */
+        UdpSocket& operator=(const UdpSocket&) = delete; /**< \brief Default operator = is disabled */
+
+        /**
+         *  \brief Opens the socket on a local port towards the peer
+         *
+         *  \param local_port port on which packets are received
+         *  \param peer_host IPv4 address of the peer as dotted numbers
+         *  \param peer_port port of the peer
+         *  \return false if the socket can not be opened or the address is wrong
+         */
+        bool Open(unsigned short local_port, const std::string& peer_host, unsigned short peer_port);
+        /**
+         *  \brief Opens the socket on a local port for packets from anyone
+         *
+         *  \param local_port port on which packets are received
+         *  \return false if the socket can not be opened
+         */
+        bool Open(unsigned short local_port);
+        /**
+         *  \brief Makes the socket hold back and drop sent packets
+         *
+         *  \param delay milliseconds every packet is held back
+         *  \param jitter most milliseconds added to the delay of a packet
+         *  \param loss percent of packets which are dropped
+         *  \param seed seed of the drawn jitter and losses
+         *  \return void
+         */
+        void SetLatency(unsigned int delay, unsigned int jitter, unsigned int loss, uint64_t seed);
+
+        /**
+         *  \brief Sends a packet to the peer, or holds it back
+         *
+         *  \param data bytes of the packet, at most NETWORK_PACKET_SIZE
+         *  \param size number of bytes
+         *  \return void
+         */
+        void Send(const uint8_t* data, std::size_t size);
+        /**
+         *  \brief Gives the next packet from the peer
+         *
+         *  \param data where the packet is written
+         *  \param capacity number of bytes there is room for
+         *  \return size of the packet or -1 if no packet is waiting
+         */
+        int Receive(uint8_t* data, std::size_t capacity);
+        /**
+         *  \brief Sends a packet to the given address, or holds it back
+         *
+         *  \param to address of the receiver
+         *  \param data bytes of the packet, at most NETWORK_PACKET_SIZE
+         *  \param size number of bytes
+         *  \return void
+         */
+        void SendTo(const Address& to, const uint8_t* data, std::size_t size);
+        /**
+         *  \brief Gives the next packet and the address it came from
+         *
+         *  \param from where the address of the sender is written
+         *  \param data where the packet is written
+         *  \param capacity number of bytes there is room for
+         *  \return size of the packet or -1 if no packet is waiting
+         */
+        int ReceiveFrom(Address& from, uint8_t* data, std::size_t capacity);
+        /**
+         *  \brief Sends the held back packets whose time has come
+         *  \return void
+         */
+        void Flush();
+
+    protected:
+
+    private:
+        /** \brief Packet held back by the shim */
+        struct Held
+        {
+            uint64_t        due; /**< millisecond at which it is sent */
+            Address         to;
+            std::size_t     size; /**< 0 for a free slot */
+            uint8_t         data[NETWORK_PACKET_SIZE];
+        };
+
+        void SendNow(const Address& to, const uint8_t* data, std::size_t size);
+
+        int                 m_socket;
+        Address             m_peer;
+        bool                m_has_peer;
+        unsigned int        m_delay;
+        unsigned int        m_jitter;
+        unsigned int        m_loss;
+        Random              m_random;
+        std::vector<Held>   m_held;
+};
+
+#endif // UDPSOCKET_H
@@ -0,0 +1,179 @@
+#ifndef MATCHSERVER_H
+#define MATCHSERVER_H
+
+/**
+ *  \file MatchServer.h
+ *
+ *  Defines class MatchServer which hosts many two player matches in one
+ *  process, each in its own World, and steps them on a pool of threads
+ *
+ */
+
+#include "Simulation/World.h"
+#include "Simulation/ScriptedInput.h"
+#include "Simulation/WorldSnapshot.h"
+#include "System/SystemTimer.h"
+#include "Network/UdpSocket.h"
+#include "Utility/ThreadPool.h"
+#include "Utility/StateBuffer.h"
+#include "Utility/BitStream.h"
+#include "Constants/NetworkConstants.h"
+#include <vector>
+#include <cstdint>
+
+/** \class MatchServer
+ *  \brief Class which runs the Worlds of many matches for clients over UDP
+ *  \details Every match is a World with its own SystemTimer and input, so the
+ *           matches share nothing and one step of all of them is spread over
+ *           the ThreadPool. Packets are only read and sent by the thread
+ *           calling Step(), before and after the matches are stepped.
+ *           The server is authoritative: clients only send the buttons they
+ *           hold and are sent back where the players are. A client joins a
+ *           match by sending its first buttons for a seat of it; a match
+ *           only runs while one of its seats is taken, and a seat is freed
+ *           when its client went quiet for SERVER_CLIENT_TIMEOUT steps. A
+ *           match which ended is made again from a new seed.
+ *           Any number of spectators can watch a match. They are sent a
+ *           WorldSnapshot every SERVER_STATE_INTERVAL steps, written by
+ *           SnapshotDelta against the last snapshot they acknowledged, so a
+ *           quiet match costs them a few bytes a step. Spectators which
+ *           acknowledged the same snapshot share one packet, which is packed
+ *           on the thread stepping the match. A snapshot too large for one
+ *           packet, like the first one of a large map, is split into up to
+ *           SERVER_VIEW_PARTS packets the spectator puts together again; a
+ *           larger one is not sent and counted by GetDroppedViews().
+ *           Without a socket all matches run and are steered by SetButtons().
+ */
+class MatchServer
+{
+    public:
+        /**
+         *  \brief Constructor for MatchServer
+         *
+         *  \param matches number of matches hosted
+         *  \param level number of the level every match plays
+         *  \param seed seed of the first match, the others count up from it
+         *  \param pool threads on which the matches are stepped
+         *  \param socket socket opened for packets from anyone, or nullptr
+         */
+        MatchServer(unsigned int matches, unsigned int level, uint64_t seed,
+                    ThreadPool* pool, UdpSocket* socket);
+        /**
+         *  \brief Destructor for MatchServer
+         *
+         *  Destroys the Worlds of all matches.
+         */
+        ~MatchServer();
+        MatchServer(const MatchServer& other) = delete; /**< \brief Default copy constructor is disabled */
+        MatchServer& operator=(const MatchServer&) = delete; /**< \brief Default operator = is disabled */
+
+        /**
+         *  \brief Makes one step of all running matches
+         *
+         *  Reads the packets of the clients, steps the matches on the pool,
+         *  makes the ended ones again and sends the clients their states.
+         *  \return void
+         */
+        void Step();
+        /**
+         *  \brief Sets the buttons a player holds from the next step on
+         *
+         *  \param match number of the match
+         *  \param player 0 or 1
+         *  \param buttons bits of up, down, left, right and bomb
+         *  \return void
+         */
+        void SetButtons(unsigned int match, unsigned int player, uint8_t buttons);
+
+        unsigned int GetMatches() const { return m_matches.size(); } /**< \brief Gives number of hosted matches */
+        unsigned int GetRunning() const { return m_running; } /**< \brief Gives number of matches stepped in the last step */
+        unsigned int GetClients() const; /**< \brief Gives number of taken seats */
+        unsigned int GetSpectators() const; /**< \brief Gives number of spectators of all matches */
+        unsigned long GetMatchSteps() const { return m_match_steps; } /**< \brief Gives number of steps made by all matches */
+        unsigned long GetRestarts() const { return m_restarts; } /**< \brief Gives number of matches made again after they ended */
+        unsigned long GetReceived() const { return m_received_packets; } /**< \brief Gives number of packets taken from clients */
+        unsigned long GetSent() const { return m_sent_packets; } /**< \brief Gives number of states sent to clients */
+        unsigned long GetViews() const { return m_sent_views; } /**< \brief Gives number of snapshots sent to spectators */
+        unsigned long GetViewBytes() const { return m_view_bytes; } /**< \brief Gives number of bytes of the snapshots sent */
+        unsigned long GetDroppedViews() const { return m_dropped_views; } /**< \brief Gives number of snapshots too large to be sent */
+
+    protected:
+
+    private:
+        /** \brief Client watching a match */
+        struct Spectator
+        {
+            UdpSocket::Address      address;
+            uint64_t                acked_seed; /**< seed of the match of the acknowledged snapshot */
+            uint32_t                acked_step; /**< step of the acknowledged snapshot, SERVER_NO_BASE if none */
+            unsigned long           heard; /**< step of the last packet */
+            unsigned int            view; /**< packed snapshot sent to it */
+        };
+
+        /** \brief Snapshot packed against one base */
+        struct View
+        {
+            uint32_t                base_step;
+            uint32_t                step;
+            BitWriter               bits{NETWORK_PACKET_SIZE}; /**< snapshot without the header of its packets */
+        };
+
+        /** \brief One match with its World and the clients playing it */
+        struct Match
+        {
+            SystemTimer             timer;
+            ScriptedInput           input;
+            World*                  world = nullptr;
+            uint64_t                seed = 0;
+            uint8_t                 buttons[SERVER_MATCH_PLAYERS] = {};
+            bool                    joined[SERVER_MATCH_PLAYERS] = {};
+            UdpSocket::Address      clients[SERVER_MATCH_PLAYERS] = {};
+            unsigned long           heard[SERVER_MATCH_PLAYERS] = {}; /**< step of the last packet of the seat */
+            bool                    running = false;
+            std::vector<Spectator>  spectators;
+            std::vector<WorldSnapshot> snapshots; /**< the last ones taken, by step */
+            std::vector<View>       views; /**< packed in the last step */
+            unsigned int            packed = 0; /**< number of views packed in the last step */
+        };
+
+        /** \brief Makes the World of a match from its seed */
+        void Start(Match& match);
+        /** \brief Steps the World of a match with its buttons */
+        void Simulate(Match& match);
+        /** \brief Reads all waiting packets of the clients */
+        void Receive();
+        /** \brief Sends every client the state of its match */
+        void Send();
+        /** \brief Takes a snapshot of a match and packs it for its spectators */
+        void Pack(Match& match);
+        /** \brief Sends the spectators the snapshots packed in the last step */
+        void SendViews();
+        /** \brief Sends a spectator one part of a packed snapshot */
+        void SendPart(const UdpSocket::Address& to, unsigned int number, const View& view,
+                      unsigned int part, unsigned int parts);
+        /** \brief Adds a spectator or takes its acknowledgement */
+        void Watch(Match& match, const UdpSocket::Address& from, uint64_t seed, uint32_t step);
+
+        std::vector<Match*>         m_matches;
+        std::vector<SDL_Keycode>    m_keys; /**< up, down, left, right and bomb of every player */
+        unsigned int                m_level;
+        uint64_t                    m_next_seed;
+        ThreadPool*                 m_pool;
+        UdpSocket*                  m_socket;
+        StateBuffer                 m_packet;
+        std::vector<uint8_t>        m_received;
+        BitWriter                   m_view_header;
+        std::vector<uint8_t>        m_view_packet;
+
+        unsigned long               m_step;
+        unsigned int                m_running;
+        unsigned long               m_match_steps;
+        unsigned long               m_restarts;
+        unsigned long               m_received_packets;
+        unsigned long               m_sent_packets;
+        unsigned long               m_sent_views;
+        unsigned long               m_view_bytes;
+        unsigned long               m_dropped_views;
+};
+
+#endif // MATCHSERVER_H
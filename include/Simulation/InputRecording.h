@@ -0,0 +1,159 @@
+#ifndef INPUTRECORDING_H
+#define INPUTRECORDING_H
+
+/**
+ *  \file InputRecording.h
+ *
+ *  Defines class InputRecording which records the buttons held on every
+ *  simulation step of a level so the level can be played again exactly
+ *
+ */
+
+#include "System/KeyboardInput.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "Constants/SimulationConstants.h"
+
+/** \class InputRecording
+ *  \brief Class which keeps the buttons held on every step of one level
+ *  \details Together with the level number, the number of players and the
+ *           seed of the World the buttons held on every step decide the whole
+ *           game, so a recording played back into a fresh World with
+ *           the same level, players and seed gives the same game, no matter
+ *           how fast the steps are made. The buttons of one step are kept as
+ *           bits, one for every button the players use, and steps with the
+ *           same buttons are merged into runs, which keeps recordings small.
+ *           The checksum of the state of the World is kept every
+ *           RECORDING_CHECKSUM_INTERVAL steps and after the last step, so a
+ *           replay which goes apart from the recorded game is found even if
+ *           the level lasts just as long.
+ *           Recording file has the format
+ *           "level <n>", "players <n>", "seed <n>", "steps <n>",
+ *           "keys <keycode>..." on the first lines and then one run per line
+ *           as "<steps> <bits>" and one checksum per line as
+ *           "check <steps> <checksum>"; lines starting with '#' are skipped.
+ */
+class InputRecording
+{
+    public:
+        /**
+         *  \brief Constructor for InputRecording
+         *
+         *  Makes an empty recording of no level, to be filled by Load().
+         */
+        InputRecording();
+        /**
+         *  \brief Constructor for InputRecording
+         *
+         *  Makes an empty recording of the given level.
+         *  \param level number of the level
+         *  \param players number of players
+         *  \param seed seed of the World
+         *  \param keys buttons which are recorded, at most 32
+         */
+        InputRecording(unsigned int level, unsigned int players, uint64_t seed,
+                       const std::vector<SDL_Keycode>& keys);
+
+        /**
+         *  \brief Reads a recording from a file
+         *
+         *  \param path_to_file string path to the recording file
+         *  \return false if the file can not be opened or is not a recording
+         */
+        bool Load(const std::string& path_to_file);
+        /**
+         *  \brief Writes the recording to a file
+         *
+         *  \param path_to_file string path to the recording file
+         *  \return false if the file can not be written
+         */
+        bool Save(const std::string& path_to_file) const;
+
+        /**
+         *  \brief Adds one step with the buttons held on the input
+         *
+         *  \param input input from which the players read their buttons
+         *  \return void
+         */
+        void Record(KeyboardInput* input);
+        /**
+         *  \brief Sets the buttons of the given step on the input
+         *
+         *  Steps are meant to be played in increasing order, playing an
+         *  earlier step than the last one starts again from the beginning.
+         *  Steps after the end of the recording release all buttons.
+         *  \param step number of the step, starting with 0
+         *  \param input input from which the players read their buttons
+         *  \return void
+         */
+        void Play(unsigned long step, KeyboardInput* input);
+
+        /**
+         *  \brief Tells if the checksum of the state after the given number
+         *         of steps is to be recorded
+         *
+         *  The state after the last step is always to be recorded as well.
+         *  \param steps number of steps made in the World
+         *  \return true every RECORDING_CHECKSUM_INTERVAL steps
+         */
+        static bool ChecksumDue(unsigned long steps) { return steps % RECORDING_CHECKSUM_INTERVAL == 0; }
+        /**
+         *  \brief Adds the checksum of the state after the given number of
+         *         steps
+         *
+         *  Checksums are added in increasing order of steps, a checksum of
+         *  the same number of steps replaces the last one.
+         *  \param steps number of steps made in the World
+         *  \param checksum StateBuffer::Checksum() of World::SaveState()
+         *  \return void
+         */
+        void AddChecksum(unsigned long steps, uint32_t checksum);
+        /**
+         *  \brief Tells if a checksum was recorded after the given number of
+         *         steps
+         *
+         *  \param steps number of steps made in the World
+         *  \param checksum set to the recorded checksum if there is one
+         *  \return true if there is a recorded checksum
+         */
+        bool GetChecksum(unsigned long steps, uint32_t& checksum) const;
+
+        unsigned int GetLevel() const { return m_level; } /**< \brief Gives number of the recorded level */
+        unsigned int GetPlayers() const { return m_players; } /**< \brief Gives number of players in the recorded level */
+        uint64_t GetSeed() const { return m_seed; } /**< \brief Gives seed of the recorded World */
+        unsigned long GetSteps() const { return m_steps; } /**< \brief Gives number of recorded steps */
+
+    protected:
+
+    private:
+        /** \brief Steps in a row with the same buttons */
+        struct Run
+        {
+            unsigned long   length;
+            uint32_t        bits;
+        };
+
+        /** \brief Checksum of the state after a number of steps */
+        struct Check
+        {
+            unsigned long   steps;
+            uint32_t        checksum;
+        };
+
+        /** \brief Presses and releases the buttons so exactly the given ones are held */
+        void SetButtons(uint32_t bits, KeyboardInput* input) const;
+
+        unsigned int                m_level;
+        unsigned int                m_players;
+        uint64_t                    m_seed;
+        std::vector<SDL_Keycode>    m_keys; /**< button of every bit */
+        std::vector<Run>            m_runs;
+        std::vector<Check>          m_checks; /**< in increasing order of steps */
+        unsigned long               m_steps;
+        unsigned int                m_play_run; /**< run of the last played step */
+        unsigned long               m_play_start; /**< first step of that run */
+        unsigned long               m_play_step; /**< last played step */
+};
+
+#endif // INPUTRECORDING_H
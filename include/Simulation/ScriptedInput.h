@@ -0,0 +1,83 @@
+#ifndef SCRIPTEDINPUT_H
+#define SCRIPTEDINPUT_H
+
+/**
+ *  \file ScriptedInput.h
+ *
+ *  Defines class ScriptedInput which presses and releases buttons according
+ *  to a script instead of the user
+ *
+ */
+
+#include "System/KeyboardInput.h"
+#include <string>
+#include <vector>
+
+/** \class ScriptedInput
+ *  \brief Class which presses and releases buttons according to a script
+ *  \details ScriptedInput is a KeyboardInput which is not fed by SDL_Event
+ *           but by a list of events, each one saying on which simulation
+ *           step a button is pressed or released. It can be given to a World
+ *           in place of the KeyboardInput singleton so the players can be
+ *           driven without any user.
+ *           Script file has one event per line in the format
+ *           "<step> <key> <press|release>", empty lines and lines starting
+ *           with '#' are skipped.
+ */
+class ScriptedInput : public KeyboardInput
+{
+    public:
+        /**
+         *  \brief Constructor for ScriptedInput
+         *
+         *  Makes an empty ScriptedInput which never presses any button.
+         */
+        ScriptedInput();
+        /**
+         *  \brief Constructor for ScriptedInput
+         *
+         *  Makes a ScriptedInput with events read from the given script file.
+         *  Exits the program if the file can not be opened.
+         *  \param path_to_file string path to the script file
+         */
+        ScriptedInput(std::string path_to_file);
+
+        /**
+         *  \brief Adds an event to the script
+         *
+         *  \param step simulation step on which the event will happen
+         *  \param key SDL_Keycode of the button
+         *  \param pressed true if the button is pressed, false if released
+         *  \return void
+         */
+        void AddEvent(unsigned long step, SDL_Keycode key, bool pressed);
+        /**
+         *  \brief Applies all events up to the given step
+         *
+         *  Presses and releases buttons of all events whose step is not
+         *  greater than the given one and which were not applied already.
+         *  \param step current simulation step
+         *  \return void
+         */
+        void Apply(unsigned long step);
+        /**
+         *  \brief Tells if all events were applied
+         *  \return true if there are no more events left in the script
+         */
+        bool Finished() const;
+
+    protected:
+
+    private:
+        struct Event
+        {
+            unsigned long   step;
+            SDL_Keycode     key;
+            bool            pressed;
+        };
+
+        std::vector<Event>  m_events;
+        unsigned int        m_next_event;
+};
+
+#endif // SCRIPTEDINPUT_H
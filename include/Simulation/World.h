@@ -0,0 +1,174 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+/**
+ *  \file World.h
+ *
+ *  Defines class World which owns the Map and all manager classes of one
+ *  level and steps them without needing a window or a renderer
+ *
+ */
+
+#include <SDL2/SDL.h>
+#include "Display/DisplayElement.h"
+#include "System/KeyboardInput.h"
+#include "System/SystemTimer.h"
+#include "Utility/Relay.h"
+#include "Utility/Random.h"
+#include "Utility/StateBuffer.h"
+#include "Simulation/WorldSnapshot.h"
+#include <vector>
+#include <cstdint>
+
+/** \class World
+ *
+ * \brief Class which owns the simulation of one level of the game.
+ * \details Class World builds the Map and all manager classes for the given
+ *          level, connects them through a Relay and updates them in the
+ *          same order GameDisplay always did. It never touches SDL video so
+ *          it can be used both by GameDisplay, which draws it, and by the
+ *          headless simulation which only steps it. Players read their
+ *          buttons from the KeyboardInput given to the World which makes it
+ *          possible to drive the World with a scripted input source. Its
+ *          timers measure the game time of the SystemTimer given to it, so
+ *          Worlds with their own SystemTimer and input share nothing and can
+ *          be stepped at the same time on different threads. All
+ *          random numbers come from streams derived from the seed of the
+ *          World, so a level is replayed exactly with the same seed.
+ *
+ */
+class World
+{
+    public:
+        /**
+         *  \brief Constructor for World
+         *
+         *  Loads the level files for the given level and makes the Map and
+         *  all manager classes.
+         *  \param texture pointer to SDL_Texture from which the game assets
+         *         will be drawn, can be nullptr if the World is never drawn
+         *  \param tile_size size of one tile of the map in pixels
+         *  \param players_number number of players that will be in the game
+         *  \param current_level number of the level that will be loaded
+         *  \param keyboard_input KeyboardInput from which the players read
+         *         their buttons
+         *  \param seed number from which everything random in the level is
+         *         drawn, the same seed and buttons give the same game
+         *  \param system_timer clock of the level, the game's SystemTimer
+         *         if nullptr
+         */
+        World(SDL_Texture* texture,
+              unsigned int tile_size,
+              unsigned int players_number,
+              unsigned int current_level,
+              KeyboardInput* keyboard_input,
+              uint64_t seed,
+              SystemTimer* system_timer = nullptr);
+        /**
+         *  \brief Destructor for World
+         *
+         *  Destroys all DisplayElements of the level as well as the Relay
+         *  used for communicating between them
+         *
+         */
+        ~World();
+        World(const World& other) = delete; /**< \brief Default copy constructor is disabled */
+        World& operator=(const World&) = delete; /**< \brief Default operator = is disabled */
+
+        /**
+         *  \brief Update method for World
+         *
+         *  Updates all DisplayElements of the level once, in the order in
+         *  which they were added.
+         *  \return void
+         *
+         */
+        void Update();
+        /**
+         *  \brief Draw method for World
+         *
+         *  Draws all DisplayElements of the level.
+         *  \param snapshot snapshot to which the level is added
+         *  \return void
+         *
+         */
+        void Draw(RenderSnapshot& snapshot) const;
+
+        /**
+         *  \brief Tells if all players are dead
+         *  \return true if all players are dead
+         *
+         */
+        bool PlayersDead() const;
+        /**
+         *  \brief Tells if the level was completed successfully
+         *  \return true if the level was completed
+         *
+         */
+        bool LevelCompleted() const;
+
+        Relay* GetRelay() const;
+        /**
+         *  \brief Gives the buttons the players of the World use
+         *
+         *  \param keys vector to which the up, down, left, right and bomb
+         *         buttons of every player are added in this order
+         *  \return void
+         *
+         */
+        void GetInputKeys(std::vector<SDL_Keycode>& keys) const;
+
+        /**
+         *  \brief Writes the whole state of the level
+         *
+         *  Writes the game time, the tiles of the map, the pickups, bombs,
+         *  players, enemies and explosions, everything Update() changes. The
+         *  buffer is cleared first.
+         *  \param state buffer to which the state is written
+         *  \return void
+         *
+         */
+        void SaveState(StateBuffer& state) const;
+        /**
+         *  \brief Puts the level back into a state written by SaveState()
+         *
+         *  The state must have been written by a World of the same level with
+         *  the same number of players. The game time of the World's
+         *  SystemTimer is set back to the time of the state.
+         *  \param state buffer from which the state is read
+         *  \return false if the state is not of this level or is cut short,
+         *          in the latter case the level is left half loaded
+         *
+         */
+        bool LoadState(StateBuffer& state);
+        /**
+         *  \brief Takes what a viewer sees of the level now
+         *
+         *  Allocates nothing once the snapshot has held a snapshot of the
+         *  same level.
+         *  \param snapshot snapshot which is filled
+         *  \return void
+         */
+        void TakeSnapshot(WorldSnapshot& snapshot) const;
+        uint64_t GetSeed() const { return m_random.GetSeed(); } /**< \brief Gives the seed the level was made from */
+        SystemTimer* GetSystemTimer() const { return m_relay->GetSystemTimer(); } /**< \brief Gives the clock of the level */
+        /**
+         *  \brief Sets the threads on which the enemies of hordes are updated
+         *
+         *  The result of every step is the same with and without the pool.
+         *  \param pool threads not used to step this World, or nullptr
+         *  \return void
+         */
+        void SetThreadPool(ThreadPool* pool) { m_relay->SetThreadPool(pool); }
+
+    protected:
+
+    private:
+        void AddDisplayElement(DisplayElement* display_element);
+
+        std::vector<DisplayElement*>    m_display_elements;
+        Relay*                          m_relay;
+        Random                          m_random;
+};
+
+#endif // WORLD_H
@@ -0,0 +1,89 @@
+#ifndef WORLDSNAPSHOT_H
+#define WORLDSNAPSHOT_H
+
+/**
+ *  \file WorldSnapshot.h
+ *
+ *  Defines struct WorldSnapshot which holds what a viewer sees of a World at
+ *  one step
+ *
+ */
+
+#include <vector>
+#include <cstdint>
+
+/** \struct WorldSnapshot
+ *  \brief What is drawn of a World, quantized for sending to viewers
+ *  \details Unlike the state saved by World::SaveState() it leaves out the
+ *           timers, random streams and everything else only needed to go on
+ *           playing. Players and enemies keep their pixel position, bombs,
+ *           explosions and pickups only their tile. Players and enemies are
+ *           kept in the order of the World, so an entry moving from one
+ *           snapshot to the next keeps its place; bombs, explosions and
+ *           pickups are sorted, so equal sets give equal lists.
+ *           The vectors keep their memory, so taking a snapshot of the same
+ *           level again allocates nothing.
+ */
+struct WorldSnapshot
+{
+    /** \brief Player or enemy, moving by pixels */
+    struct Mover
+    {
+        uint16_t    x;
+        uint16_t    y;
+        uint8_t     kind; /**< id of a player, EnemyBatch::Kind of an enemy */
+        uint8_t     extra; /**< lives, whether alive and direction of a player */
+
+        bool operator==(const Mover& other) const
+        {
+            return x == other.x && y == other.y && kind == other.kind && extra == other.extra;
+        }
+    };
+
+    /** \brief Bomb, explosion or pickup, standing on a tile */
+    struct Marker
+    {
+        uint32_t    tile; /**< row times width of the map plus column */
+        uint8_t     kind; /**< player of a bomb, eighths of a tile of an explosion, type of a pickup */
+
+        bool operator==(const Marker& other) const { return tile == other.tile && kind == other.kind; }
+        bool operator<(const Marker& other) const
+        {
+            return tile < other.tile || (tile == other.tile && kind < other.kind);
+        }
+    };
+
+    uint64_t                    seed = 0;
+    uint32_t                    step = 0;
+    uint16_t                    width = 0; /**< width of the map in tiles */
+    uint16_t                    height = 0; /**< height of the map in tiles */
+    uint16_t                    tile_size = 0;
+    std::vector<uint32_t>       opened; /**< tiles which became walkable, in the order they did */
+    std::vector<Mover>          players;
+    std::vector<Mover>          enemies;
+    std::vector<Marker>         bombs;
+    std::vector<Marker>         explosions;
+    std::vector<Marker>         pickups;
+
+    /** \brief Empties the lists, keeping their memory */
+    void Clear()
+    {
+        opened.clear();
+        players.clear();
+        enemies.clear();
+        bombs.clear();
+        explosions.clear();
+        pickups.clear();
+    }
+
+    /** \brief Tells if two snapshots show the same */
+    bool operator==(const WorldSnapshot& other) const
+    {
+        return seed == other.seed && step == other.step && width == other.width &&
+               height == other.height && tile_size == other.tile_size && opened == other.opened &&
+               players == other.players && enemies == other.enemies && bombs == other.bombs &&
+               explosions == other.explosions && pickups == other.pickups;
+    }
+};
+
+#endif // WORLDSNAPSHOT_H
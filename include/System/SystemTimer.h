@@ -4,38 +4,71 @@
 /**
  *  \file SystemTimer.h
  *
- *  Defines class SystemTimer which is used with SDL.h to calculate elapsed time
+ *  Defines class SystemTimer which is the simulation clock of the game
  */
 
 /** \class SystemTimer
- *  \brief class for measuring time
- *  \details This is an utility class for measuring time which can be used for
- *           properly timing events. This class is singleton which means there
- *           can only be one instance of this class.
+ *  \brief class for measuring game time
+ *  \details This is the clock of the game simulation. It does not follow the
+ *           wall time, instead it only moves forward in fixed steps when
+ *           Step() is called, so the game plays the same no matter how fast
+ *           or how slow it is being run. All Timer objects measure time from
+ *           it. How far the wall time is between two steps, to draw objects
+ *           between their positions, is known by the RenderSnapshot drawn.
+ *           The game uses the one SystemTimer given by Instance(), but every
+ *           World can be given its own, so many Worlds can be stepped apart
+ *           from each other, also on different threads.
  */
 class SystemTimer
 {
     public:
 
         /**
-         *  \brief Method to be used instead of constructor
+         *  \brief Make new SystemTimer and set it to 0.
          *
-         *  Returns pointer to object SystemTimer which is of singleton class so
+         *  Basic constructor which makes new SystemTimer object and sets it's
+         *  value to 0.
+         */
+        SystemTimer();
+
+        /**
+         *  \brief Gives the SystemTimer of the game
+         *
+         *  Returns pointer to the SystemTimer shared by the game's Displays,
          *  it will always return pointer to the same object.
-         *  \return pointer to singleton SystemTimer
+         *  \return pointer to the game's SystemTimer
          */
         static SystemTimer* Instance();
 
         /**
-         *  \brief Gives time elapsed in milliseconds
+         *  \brief Gives game time elapsed in milliseconds
          *
-         *  Value returned is unsigned long which represents time in
-         *  milliseconds since last time the timer was reset or since it was
-         *  created.
+         *  Value returned is unsigned long which represents game time in
+         *  milliseconds since the timer was created, which is the number of
+         *  steps made multiplied by the length of one step.
          *
-         *  \return number of milliseconds since last reset
+         *  \return number of milliseconds of game time
          */
         unsigned long GetTimeElapsed() const;
+        /**
+         *  \brief Moves the game time one step forward
+         *
+         *  Game time moves by SIMULATION_STEP_LENGTH milliseconds unless the
+         *  timer is paused.
+         *  \return void
+         */
+        void Step();
+        /** \brief Gives number of steps made */
+        unsigned long GetSteps() const { return m_ticks; }
+        /**
+         *  \brief Moves the game time to the given step
+         *
+         *  Used when a saved state of the game is loaded, the Timers of the
+         *  state are only right with the game time they were saved at.
+         *  \param steps number of steps made
+         *  \return void
+         */
+        void SetSteps(unsigned long steps) { m_ticks = steps; }
         /**
          *  \brief Pauses the timer
          *
@@ -61,27 +94,14 @@ class SystemTimer
          */
         bool IsPaused() const;
 
-
     protected:
 
-        /**
-         *  \brief Make new SystemTimer and set it to 0.
-         *
-         *  Basic constructor which makes new SystemTimer object and sets it's
-         *  value to 0.
-         */
-        SystemTimer();
-
     private:
-        unsigned long       m_past_ticks;
-        unsigned long       m_paused_ticks;
+        unsigned long       m_ticks;
         bool                m_paused;
 
         static SystemTimer* s_instance;
 
-        void ResetTimer();
-        void DecreaseTimer(unsigned long interval);
-
 };
 
-#endif // SCREENTIMER_H
+#endif // SYSTEMTIMER_H
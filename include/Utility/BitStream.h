@@ -0,0 +1,106 @@
+#ifndef BITSTREAM_H
+#define BITSTREAM_H
+
+/**
+ *  \file BitStream.h
+ *
+ *  Defines classes BitWriter and BitReader which pack values into as few bits
+ *  as they need and read them back
+ *
+ */
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/** \class BitWriter
+ *  \brief Class which packs values one after another into bits
+ *  \details Every value takes only the given number of bits, with no padding
+ *           between values, and the last byte is filled up with zeroes.
+ *           Clearing keeps the memory, so a writer reused for packets of the
+ *           same size allocates nothing.
+ */
+class BitWriter
+{
+    public:
+        /**
+         *  \brief Constructor for BitWriter
+         *
+         *  \param capacity number of bytes for which memory is made up front
+         */
+        explicit BitWriter(std::size_t capacity = 0);
+
+        /**
+         *  \brief Empties the writer, keeping its memory
+         *  \return void
+         */
+        void Clear();
+        /**
+         *  \brief Adds the lowest bits of a value
+         *
+         *  \param value value whose higher bits must be zero
+         *  \param bits number of bits, at most 32
+         *  \return void
+         */
+        void Write(uint32_t value, unsigned int bits);
+        /**
+         *  \brief Adds a value in groups of four bits, each followed by a bit
+         *         telling if more follow, so small values take five bits
+         *  \return void
+         */
+        void WriteVarying(uint32_t value);
+
+        const uint8_t* GetData() const { return m_data.data(); } /**< \brief Gives the written bytes */
+        std::size_t GetSize() const { return m_data.size(); } /**< \brief Gives number of written bytes */
+        std::size_t GetBits() const { return m_bits; } /**< \brief Gives number of written bits */
+
+    protected:
+
+    private:
+        std::vector<uint8_t>    m_data;
+        std::size_t             m_bits;
+};
+
+/** \class BitReader
+ *  \brief Class which reads values packed by a BitWriter
+ *  \details Reading past the end gives zeroes and marks the reader as failed
+ *           instead of stopping the program, as packets come from the network.
+ */
+class BitReader
+{
+    public:
+        /**
+         *  \brief Constructor for BitReader
+         *
+         *  \param data packed bytes, which must live as long as the reader
+         *  \param size number of bytes
+         */
+        BitReader(const uint8_t* data, std::size_t size);
+
+        /** \brief Reads the given number of bits, at most 32 */
+        uint32_t Read(unsigned int bits);
+        /** \brief Reads a value written by BitWriter::WriteVarying() */
+        uint32_t ReadVarying();
+        bool Failed() const { return m_failed; } /**< \brief Tells if a read went past the end */
+        /** \brief Gives number of bits left to read */
+        std::size_t GetRemaining() const { return m_size * 8 - m_bit; }
+
+    protected:
+
+    private:
+        const uint8_t*          m_data;
+        std::size_t             m_size;
+        std::size_t             m_bit; /**< position of the next bit to read */
+        bool                    m_failed;
+};
+
+/** \brief Gives number of bits needed to write the values below the given count */
+inline unsigned int BitsFor(uint32_t count)
+{
+    unsigned int bits = 0;
+    while (bits < 32 && ((uint64_t)1 << bits) < count)
+        ++bits;
+    return bits;
+}
+
+#endif // BITSTREAM_H
@@ -0,0 +1,108 @@
+#ifndef COLLISIONMASK_H
+#define COLLISIONMASK_H
+
+/**
+ *  \file CollisionMask.h
+ *
+ *  Defines class CollisionMask which keeps one bit per map tile telling
+ *  whether the tile can be walked on
+ *
+ */
+
+#include <vector>
+#include <cstdint>
+#include "Utility/StateBuffer.h"
+
+/** \class CollisionMask
+ *  \brief Class which keeps track of walkable tiles of the map.
+ *  \details Every tile of the map is represented by one bit which is set if
+ *           the tile can be walked on. Rows are packed into 64 bit words and
+ *           the whole grid is surrounded by a border of solid tiles, so any
+ *           coordinate, even one outside of the map, can be asked about
+ *           safely. Besides single tiles it answers whether a rectangle in
+ *           pixels can be moved by some offset, which is the test used by
+ *           everything that walks on the map.
+ */
+class CollisionMask
+{
+    public:
+        /**
+         *  \brief Constructor for CollisionMask
+         *
+         *  Makes a mask in which no tile is walkable.
+         *  \param height height of map in tiles
+         *  \param width width of map in tiles
+         *  \param tile_size size of one tile in pixels
+         */
+        CollisionMask(unsigned int height, unsigned int width, unsigned int tile_size);
+
+        /**
+         *  \brief Sets whether the given tile can be walked on
+         *
+         *  \param i row coordinate of the map
+         *  \param j column coordinate of the map
+         *  \param walkable true if the tile can be walked on
+         *  \return void
+         */
+        void SetWalkable(unsigned int i, unsigned int j, bool walkable);
+        /**
+         *  \brief Tells if the tile at given coordinates is walkable on
+         *
+         *  Coordinates outside of the map are never walkable.
+         *  \param i row coordinate of the map
+         *  \param j column coordinate of the map
+         *  \return true if the tile can be walked on
+         */
+        bool Walkable(int i, int j) const
+        {
+            unsigned int bit = Column(j);
+            return (m_bits[Row(i)*m_stride + (bit >> 6)] >> (bit & 63)) & 1;
+        }
+        /**
+         *  \brief Tells if a rectangle can be moved by the given offset
+         *
+         *  Checks whether every tile touched by the rectangle after moving it
+         *  by (dx,dy) pixels is walkable. Edges of the rectangle are included
+         *  in the test.
+         *  \param x x coordinate of the rectangle in pixels
+         *  \param y y coordinate of the rectangle in pixels
+         *  \param w width of the rectangle in pixels
+         *  \param h height of the rectangle in pixels
+         *  \param dx movement along x axis in pixels
+         *  \param dy movement along y axis in pixels
+         *  \return true if the rectangle can be moved
+         */
+        bool CanMove(int x, int y, unsigned int w, unsigned int h, int dx, int dy) const;
+
+        /** \brief Writes the state of the walkable tiles */
+        void SaveState(StateBuffer& state) const;
+        /** \brief Reads the state written by SaveState() */
+        void LoadState(StateBuffer& state);
+
+    protected:
+
+    private:
+        /** \brief Index of the padded row for the given map row */
+        unsigned int Row(int i) const
+        {
+            return i < 0 ? 0 : (i >= (int)m_height ? m_height + 1 : i + 1);
+        }
+        /** \brief Index of the padded bit for the given map column */
+        unsigned int Column(int j) const
+        {
+            return j < 0 ? 0 : (j >= (int)m_width ? m_width + 1 : j + 1);
+        }
+        /** \brief Map tile of the given pixel coordinate, -1 for negative */
+        int Tile(int p) const
+        {
+            return p < 0 ? -1 : p / m_tile_size;
+        }
+
+        unsigned int            m_height;
+        unsigned int            m_width;
+        int                     m_tile_size;
+        unsigned int            m_stride; /**< number of words in one padded row */
+        std::vector<uint64_t>   m_bits;
+};
+
+#endif // COLLISIONMASK_H
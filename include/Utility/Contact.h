@@ -0,0 +1,80 @@
+#ifndef CONTACT_H
+#define CONTACT_H
+
+/**
+ *  \file Contact.h
+ *
+ *  Defines class Contact which tests one box against many game objects at
+ *  once
+ *
+ */
+
+#include <cstdint>
+
+/** \class Contact
+ *  \brief Class which tests one box against packed arrays of game objects.
+ *  \details The coordinates of the objects are kept in separate arrays of x
+ *           and y coordinates, so four objects are tested with one vector
+ *           instruction: SSE2 on x86 hosts and NEON on the Switch. Other
+ *           targets, or builds with CONTACT_NO_SIMD defined, use the scalar
+ *           versions which give the same results. The result is a hit mask
+ *           with one bit per object, bit i%32 of word i/32 for i-th object.
+ *           All coordinates are pixels on the map and are compared as
+ *           unsigned numbers, just like the entities keep them.
+ */
+class Contact
+{
+    public:
+        /** \brief Box tested against the objects, edges are inclusive */
+        struct Box
+        {
+            unsigned int left;
+            unsigned int top;
+            unsigned int right;
+            unsigned int bottom;
+        };
+
+        /**
+         *  \brief Tests if a corner of the box is inside of any object
+         *
+         *  Objects are rectangles of the same size with top left corners in
+         *  the arrays. This is how enemies touch players.
+         *  \param box box whose corners are tested
+         *  \param x x coordinates of the objects
+         *  \param y y coordinates of the objects
+         *  \param w width of every object
+         *  \param h height of every object
+         *  \param n number of objects
+         *  \param mask hit mask with room for (n + 31)/32 words
+         *  \return true if any object was hit
+         */
+        static bool Corners(const Box& box, const unsigned int* x, const unsigned int* y,
+                            unsigned int w, unsigned int h, unsigned int n, uint32_t* mask);
+        /**
+         *  \brief Tests which objects are points inside of the box
+         *
+         *  This is how players touch pickups.
+         *  \param box box in which the points are looked for
+         *  \param x x coordinates of the points
+         *  \param y y coordinates of the points
+         *  \param n number of points
+         *  \param mask hit mask with room for (n + 31)/32 words
+         *  \return true if any point was inside
+         */
+        static bool Points(const Box& box, const unsigned int* x, const unsigned int* y,
+                           unsigned int n, uint32_t* mask);
+
+        /** \brief Scalar version of Corners(), used for leftovers and on targets without vectors */
+        static bool CornersScalar(const Box& box, const unsigned int* x, const unsigned int* y,
+                                  unsigned int w, unsigned int h, unsigned int n, uint32_t* mask);
+        /** \brief Scalar version of Points(), used for leftovers and on targets without vectors */
+        static bool PointsScalar(const Box& box, const unsigned int* x, const unsigned int* y,
+                                 unsigned int n, uint32_t* mask);
+
+        /** \brief Gives name of the instruction set used by Corners() and Points() */
+        static const char* GetPath();
+        /** \brief Gives number of mask words needed for n objects */
+        static unsigned int MaskWords(unsigned int n) { return (n + 31) / 32; }
+};
+
+#endif // CONTACT_H
@@ -0,0 +1,119 @@
+#ifndef DISTANCEFIELD_H
+#define DISTANCEFIELD_H
+
+/**
+ *  \file DistanceField.h
+ *
+ *  Defines class DistanceField which tells every tile of the map how far the
+ *  nearest player is and which way to go to get there
+ *
+ */
+
+#include <vector>
+#include <cstdint>
+
+class Map;
+
+/** \class DistanceField
+ *  \brief Class which keeps walking distances from every tile of the map to
+ *         the nearest of a set of goal tiles.
+ *  \details The distances are found by one breadth first search which starts
+ *           from all goal tiles at once and only walks over walkable tiles.
+ *           Besides the distance every reached tile remembers the step that
+ *           leads one tile closer to a goal, so anything on the map finds its
+ *           way to the nearest goal with a single lookup. The whole search is
+ *           only repeated when the goals change. Tiles opened on the map can
+ *           only make distances shorter, so for them only the tiles that get
+ *           closer to a goal are walked over again, starting from the opened
+ *           tiles (Map::GetOpenedTiles()).
+ */
+class DistanceField
+{
+    public:
+        /** \brief Step to the neighbouring tile closer to a goal */
+        enum Step
+        {
+            LEFT = 0,
+            RIGHT = 1,
+            UP = 2,
+            DOWN = 3,
+            NONE = 4 /**< the tile is a goal or no goal can be reached */
+        };
+
+        static const uint16_t UNREACHABLE = 0xFFFF; /**< distance of tiles from which no goal can be reached */
+
+        /**
+         *  \brief Constructor for DistanceField
+         *
+         *  Makes a field over a map of the given size in which no tile
+         *  reaches a goal.
+         *  \param height height of the map in tiles
+         *  \param width width of the map in tiles
+         */
+        DistanceField(unsigned int height, unsigned int width);
+
+        /**
+         *  \brief Finds the distances to the given goals again if needed
+         *
+         *  The whole search is repeated if the goals are not the same as last
+         *  time. Otherwise only the tiles opened on the map since the last
+         *  update are taken into account, if any.
+         *  \param map map over which the distances are found
+         *  \param goals indexes (row * width + column) of the goal tiles in
+         *         increasing order
+         *  \return true if the distances were found again
+         */
+        bool Update(const Map& map, const std::vector<unsigned int>& goals);
+        /**
+         *  \brief Finds the distances to the given goals over the whole map
+         *
+         *  \param map map over which the distances are found
+         *  \param goals indexes (row * width + column) of the goal tiles in
+         *         increasing order
+         *  \return void
+         */
+        void Search(const Map& map, const std::vector<unsigned int>& goals);
+        /**
+         *  \brief Makes the next Update() search the whole map again
+         *
+         *  Needed when the map changes in other ways than by opening tiles,
+         *  such as when a saved state is loaded.
+         *  \return void
+         */
+        void Reset() { m_searched = false; }
+
+        /** \brief Gives number of steps from the tile to the nearest goal, UNREACHABLE if there is none */
+        uint16_t GetDistance(unsigned int i, unsigned int j) const
+        {
+            return i < m_height && j < m_width ? m_distance[i*m_width + j] : UNREACHABLE;
+        }
+        /** \brief Gives the step from the tile towards the nearest goal */
+        Step GetStep(unsigned int i, unsigned int j) const
+        {
+            return i < m_height && j < m_width ? (Step)m_step[i*m_width + j] : NONE;
+        }
+
+    protected:
+
+    private:
+        /** \brief Shortens the distances through the tiles opened since the last update */
+        void Repair(const Map& map);
+        /** \brief Shortens the distances around the queued tiles until nothing changes */
+        void Relax(const Map& map);
+        /** \brief Adds a tile to the end of the queue */
+        void Push(unsigned int tile);
+
+        unsigned int                m_height;
+        unsigned int                m_width;
+        std::vector<uint16_t>       m_distance;
+        std::vector<uint8_t>        m_step;
+        std::vector<unsigned int>   m_queue; /**< ring of tiles whose neighbours need to be looked at */
+        std::vector<uint8_t>        m_queued; /**< tells which tiles are in the queue */
+        unsigned int                m_head;
+        unsigned int                m_tail;
+        std::vector<unsigned int>   m_goals; /**< goals of the last search */
+        unsigned long               m_map_revision; /**< Map::GetRevision() at the last update */
+        bool                        m_searched;
+};
+
+#endif // DISTANCEFIELD_H
@@ -0,0 +1,132 @@
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+/**
+ *  \file ObjectPool.h
+ *
+ *  Defines template class ObjectPool which keeps short lived game objects in
+ *  memory allocated once
+ *
+ */
+
+#include <vector>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+/** \class ObjectPool
+ *  \brief Class which makes and destroys objects in a fixed number of slots.
+ *  \details All the memory is allocated when the pool is made, making and
+ *           destroying an object afterwards never touches the heap and takes
+ *           constant time. An object stays in the same slot for its whole
+ *           life, so pointers to it stay valid until it is destroyed. Live
+ *           objects are also kept in a dense list for iterating, destroying
+ *           an object moves the last one of the list into its place.
+ */
+template <typename T>
+class ObjectPool
+{
+    public:
+        typedef typename std::vector<T*>::const_iterator const_iterator;
+
+        /**
+         *  \brief Constructor for ObjectPool
+         *
+         *  Makes an empty pool.
+         *  \param capacity largest number of objects alive at the same time
+         */
+        explicit ObjectPool(unsigned int capacity)
+            : m_slots(capacity),
+              m_position(capacity)
+        {
+            m_free.reserve(capacity);
+            for (unsigned int i = capacity; i > 0; --i)
+                m_free.push_back(i - 1);
+            m_live.reserve(capacity);
+        }
+        /**
+         *  \brief Destructor for ObjectPool
+         *
+         *  Destroys all objects still alive.
+         */
+        ~ObjectPool()
+        {
+            Clear();
+        }
+        ObjectPool(const ObjectPool& other) = delete; /**< \brief Default copy constructor is disabled */
+        ObjectPool& operator=(const ObjectPool&) = delete; /**< \brief Default operator = is disabled */
+
+        /**
+         *  \brief Makes a new object in a free slot
+         *
+         *  \param args arguments for the constructor of the object
+         *  \return pointer to the new object, nullptr if the pool is full
+         */
+        template <typename... Args>
+        T* Make(Args&&... args)
+        {
+            if (m_free.empty())
+                return nullptr;
+
+            unsigned int slot = m_free.back();
+            m_free.pop_back();
+            T* object = new (&m_slots[slot]) T(std::forward<Args>(args)...);
+            m_position[slot] = m_live.size();
+            m_live.push_back(object);
+            return object;
+        }
+        /**
+         *  \brief Destroys an object of the pool and frees its slot
+         *
+         *  \param object pointer to the object, must have been made by this
+         *         pool
+         *  \return void
+         */
+        void Destroy(T* object)
+        {
+            unsigned int slot = Slot(object);
+            unsigned int position = m_position[slot];
+
+            T* last = m_live.back();
+            m_live[position] = last;
+            m_position[Slot(last)] = position;
+            m_live.pop_back();
+
+            object->~T();
+            m_free.push_back(slot);
+        }
+        /**
+         *  \brief Destroys all objects of the pool
+         *
+         *  \return void
+         */
+        void Clear()
+        {
+            while (!m_live.empty())
+                Destroy(m_live.back());
+        }
+
+        T* operator[](unsigned int i) const { return m_live[i]; } /**< \brief Gives i-th live object */
+        unsigned int GetSize() const { return m_live.size(); } /**< \brief Gives number of live objects */
+        unsigned int GetCapacity() const { return m_slots.size(); } /**< \brief Gives number of slots */
+        const_iterator begin() const { return m_live.begin(); } /**< \brief Gives iterator to first live object */
+        const_iterator end() const { return m_live.end(); } /**< \brief Gives iterator past last live object */
+
+    protected:
+
+    private:
+        typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Storage;
+
+        /** \brief Slot in which the given object lives */
+        unsigned int Slot(T* object) const
+        {
+            return reinterpret_cast<Storage*>(object) - m_slots.data();
+        }
+
+        std::vector<Storage>        m_slots;
+        std::vector<unsigned int>   m_position; /**< position of every slot in m_live */
+        std::vector<unsigned int>   m_free;
+        std::vector<T*>             m_live;
+};
+
+#endif // OBJECTPOOL_H
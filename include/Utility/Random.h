@@ -0,0 +1,69 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+/**
+ *  \file Random.h
+ *
+ *  Defines class Random which makes reproducible random numbers
+ *
+ */
+
+#include <cstdint>
+
+/** \class Random
+ *  \brief Small seeded generator of random numbers (PCG32).
+ *  \details Every generator keeps its own state, so objects which draw numbers
+ *           from their own generator do not depend on the order in which the
+ *           others are updated. The World owns the generator made from the
+ *           seed of the level, everything else gets a stream derived from it
+ *           with Derive(), so the seed alone decides every number drawn.
+ */
+class Random
+{
+    public:
+        /**
+         *  \brief Constructor for Random
+         *
+         *  \param seed number from which all numbers are made
+         *  \param stream selects one of the independent sequences for the
+         *         same seed
+         */
+        Random(uint64_t seed = 0, uint64_t stream = 0);
+
+        /**
+         *  \brief Makes a new generator from this one
+         *
+         *  The new generator only depends on the seed of this one and the
+         *  given id, not on the numbers drawn so far.
+         *  \param id number of the stream, different ids give unrelated
+         *         sequences
+         *  \return the new generator
+         */
+        Random Derive(uint64_t id) const;
+
+        /** \brief Gives the next 32 random bits */
+        uint32_t Next()
+        {
+            uint64_t old = m_state;
+            m_state = old * 6364136223846793005ULL + m_increment;
+            uint32_t shifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+            uint32_t rotation = (uint32_t)(old >> 59);
+            return (shifted >> rotation) | (shifted << ((32 - rotation) & 31));
+        }
+        /** \brief Gives a random number from 0 to bound - 1 */
+        unsigned int Below(unsigned int bound)
+        {
+            return (unsigned int)(((uint64_t)Next() * bound) >> 32);
+        }
+
+        uint64_t GetSeed() const { return m_seed; } /**< \brief Gives the seed the generator was made from */
+
+    protected:
+
+    private:
+        uint64_t    m_seed;
+        uint64_t    m_state;
+        uint64_t    m_increment; /**< odd, selects the stream */
+};
+
+#endif // RANDOM_H
@@ -14,6 +14,9 @@ class PlayerManager;
 class EnemyManager;
 class Map;
 class PickUpManager;
+class KeyboardInput;
+class SystemTimer;
+class ThreadPool;
 
 class Relay
 {
@@ -64,6 +67,22 @@ class Relay
         PickUpManager* GetPickUpManager() const;
         void SetPickUpManager(PickUpManager* val);
 
+        KeyboardInput* GetKeyboardInput() const;
+        void SetKeyboardInput(KeyboardInput* val);
+
+        SystemTimer* GetSystemTimer() const;
+        void SetSystemTimer(SystemTimer* val);
+
+        /**
+         *  \brief Gives the threads the managers may spread their updates on
+         *
+         *  nullptr, the default, keeps every update on the calling thread.
+         *  The pool must not be the one the World itself is stepped on, as
+         *  a job can not wait for another job of its own pool.
+         */
+        ThreadPool* GetThreadPool() const;
+        void SetThreadPool(ThreadPool* val);
+
         /**
          *  \brief Tells if all player are dead
          *
@@ -93,6 +112,9 @@ class Relay
         EnemyManager*     m_enemy_manager;
         Map*              m_map;
         PickUpManager*    m_pickup_manager;
+        KeyboardInput*    m_keyboard_input;
+        SystemTimer*      m_system_timer;
+        ThreadPool*       m_thread_pool;
 
 };
 
@@ -0,0 +1,177 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+/**
+ *  \file SpatialGrid.h
+ *
+ *  Defines template class SpatialGrid which buckets game objects by the map
+ *  cell they are in so that only nearby objects have to be looked at
+ *
+ */
+
+#include <vector>
+#include <cstddef>
+
+/** \class SpatialGrid
+ *  \brief Class which finds game objects close to some area of the map.
+ *  \details The map is split into square cells (normally one tile each) and
+ *           every object is kept in the bucket of the cell its anchor point
+ *           falls in. Cells are hashed into a fixed number of buckets, so the
+ *           grid does not have to know how big the map is and coordinates
+ *           outside of the map are fine as well. Objects may be up to
+ *           item_size pixels large to the right and down of their anchor,
+ *           queries are widened by that much so no object touching the asked
+ *           area is missed. A query can give objects which are merely close
+ *           to the area, the exact test is left to the caller.
+ */
+template <typename T>
+class SpatialGrid
+{
+    public:
+        /**
+         *  \brief Constructor for SpatialGrid
+         *
+         *  Makes an empty grid. Room for a few objects is made in every bucket
+         *  up front so moving objects around does not allocate.
+         *  \param cell_size size of one cell in pixels
+         *  \param item_size largest width or height of an object in pixels
+         *  \param buckets number of buckets, must be a power of two
+         *  \param bucket_capacity number of objects every bucket has room for
+         */
+        SpatialGrid(unsigned int cell_size, unsigned int item_size, unsigned int buckets = 256,
+                    unsigned int bucket_capacity = 4)
+            : m_cell_size(cell_size),
+              m_item_size(item_size),
+              m_mask(buckets - 1),
+              m_buckets(buckets),
+              m_size(0)
+        {
+            for (auto i = m_buckets.begin(); i != m_buckets.end(); ++i)
+                i->reserve(bucket_capacity);
+        }
+
+        /**
+         *  \brief Removes all objects from the grid
+         *
+         *  Buckets keep their memory so rebuilding the grid every tick does
+         *  not allocate.
+         *  \return void
+         */
+        void Clear()
+        {
+            for (auto i = m_buckets.begin(); i != m_buckets.end(); ++i)
+                i->clear();
+            m_size = 0;
+        }
+        /**
+         *  \brief Adds an object to the grid
+         *
+         *  \param item object to be added
+         *  \param x x coordinate of the anchor of the object in pixels
+         *  \param y y coordinate of the anchor of the object in pixels
+         *  \return void
+         */
+        void Insert(T item, int x, int y)
+        {
+            Entry entry = {Cell(x), Cell(y), item};
+            m_buckets[Bucket(entry.column, entry.row)].push_back(entry);
+            ++m_size;
+        }
+        /**
+         *  \brief Removes an object from the grid
+         *
+         *  \param item object to be removed
+         *  \param x x coordinate the object was inserted with
+         *  \param y y coordinate the object was inserted with
+         *  \return true if the object was found and removed
+         */
+        bool Remove(T item, int x, int y)
+        {
+            int column = Cell(x);
+            int row = Cell(y);
+            std::vector<Entry>& bucket = m_buckets[Bucket(column, row)];
+            for (auto i = bucket.begin(); i != bucket.end(); ++i)
+            {
+                if (i->item == item && i->column == column && i->row == row)
+                {
+                    bucket.erase(i);
+                    --m_size;
+                    return true;
+                }
+            }
+            return false;
+        }
+        /**
+         *  \brief Calls visit for every object which may touch the given area
+         *
+         *  Every object is visited at most once. Objects are visited in the
+         *  same order for the same contents of the grid.
+         *  \param x x coordinate of the area in pixels
+         *  \param y y coordinate of the area in pixels
+         *  \param w width of the area in pixels
+         *  \param h height of the area in pixels
+         *  \param visit function called with every found object
+         *  \return void
+         */
+        template <typename F>
+        void Query(int x, int y, unsigned int w, unsigned int h, F visit) const
+        {
+            int first_column = Cell(x - (int)m_item_size);
+            int last_column = Cell(x + (int)w);
+            int first_row = Cell(y - (int)m_item_size);
+            int last_row = Cell(y + (int)h);
+
+            // An area larger than the table would visit buckets many times
+            if ((unsigned int)(last_column - first_column + 1) * (last_row - first_row + 1) > m_buckets.size())
+            {
+                for (auto b = m_buckets.begin(); b != m_buckets.end(); ++b)
+                    for (auto i = b->begin(); i != b->end(); ++i)
+                        if (i->column >= first_column && i->column <= last_column &&
+                            i->row >= first_row && i->row <= last_row)
+                            visit(i->item);
+                return;
+            }
+
+            for (int row = first_row; row <= last_row; ++row)
+            {
+                for (int column = first_column; column <= last_column; ++column)
+                {
+                    const std::vector<Entry>& bucket = m_buckets[Bucket(column, row)];
+                    for (auto i = bucket.begin(); i != bucket.end(); ++i)
+                        if (i->column == column && i->row == row)
+                            visit(i->item);
+                }
+            }
+        }
+
+        std::size_t GetSize() const { return m_size; } /**< \brief Gives number of objects in the grid */
+
+    protected:
+
+    private:
+        struct Entry
+        {
+            int     column;
+            int     row;
+            T       item;
+        };
+
+        /** \brief Cell of the given pixel coordinate, rounded down */
+        int Cell(int p) const
+        {
+            return p >= 0 ? p / (int)m_cell_size : -(((int)m_cell_size - 1 - p) / (int)m_cell_size);
+        }
+        /** \brief Bucket in which the given cell is kept */
+        unsigned int Bucket(int column, int row) const
+        {
+            return ((unsigned int)column * 73856093u ^ (unsigned int)row * 19349663u) & m_mask;
+        }
+
+        unsigned int                        m_cell_size;
+        unsigned int                        m_item_size;
+        unsigned int                        m_mask;
+        std::vector<std::vector<Entry>>     m_buckets;
+        std::size_t                         m_size;
+};
+
+#endif // SPATIALGRID_H
@@ -0,0 +1,118 @@
+#ifndef STATEBUFFER_H
+#define STATEBUFFER_H
+
+/**
+ *  \file StateBuffer.h
+ *
+ *  Defines class StateBuffer into which the state of a World is written as
+ *  plain bytes and read back from
+ *
+ */
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+/** \class StateBuffer
+ *  \brief Class which keeps the state of the game as a block of bytes.
+ *  \details Values are written one after another as their bytes, with no
+ *           names or padding, and must be read back in the same order by the
+ *           same build of the game. Clearing the buffer keeps its memory, so
+ *           once a buffer has held one state of a level writing the next
+ *           states allocates nothing. Reading past the end gives zeroes and
+ *           marks the buffer as failed instead of stopping the program.
+ */
+class StateBuffer
+{
+    public:
+        /**
+         *  \brief Constructor for StateBuffer
+         *
+         *  Makes an empty buffer.
+         *  \param capacity number of bytes for which memory is made up front
+         */
+        explicit StateBuffer(std::size_t capacity = 0);
+
+        /**
+         *  \brief Empties the buffer for writing, keeping its memory
+         *  \return void
+         */
+        void Clear();
+        /**
+         *  \brief Starts reading again from the first byte
+         *  \return void
+         */
+        void Rewind();
+        /**
+         *  \brief Replaces the contents with the given bytes and rewinds
+         *
+         *  \param data bytes of a state written by another buffer
+         *  \param size number of bytes
+         *  \return void
+         */
+        void Assign(const uint8_t* data, std::size_t size);
+
+        /** \brief Adds bytes to the end of the buffer */
+        void WriteBytes(const void* data, std::size_t size);
+        /** \brief Reads the next bytes of the buffer, zeroes if there are not enough */
+        void ReadBytes(void* data, std::size_t size);
+
+        /** \brief Adds a value to the end of the buffer */
+        template <typename T>
+        void Write(const T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "only plain values can be written");
+            WriteBytes(&value, sizeof(T));
+        }
+        /** \brief Reads the next value of the buffer */
+        template <typename T>
+        void Read(T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "only plain values can be read");
+            ReadBytes(&value, sizeof(T));
+        }
+        /** \brief Adds the size and all values of a vector to the end of the buffer */
+        template <typename T>
+        void WriteVector(const std::vector<T>& values)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "only plain values can be written");
+            Write((uint32_t)values.size());
+            WriteBytes(values.data(), values.size() * sizeof(T));
+        }
+        /**
+         *  \brief Reads a vector written by WriteVector()
+         *
+         *  The vector is resized to the written size, which allocates nothing
+         *  if it already had room for it.
+         */
+        template <typename T>
+        void ReadVector(std::vector<T>& values)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "only plain values can be read");
+            uint32_t size = 0;
+            Read(size);
+            if (size * sizeof(T) > m_data.size() - m_read)
+            {
+                m_failed = true;
+                size = 0;
+            }
+            values.resize(size);
+            ReadBytes(values.data(), size * sizeof(T));
+        }
+
+        const uint8_t* GetData() const { return m_data.data(); } /**< \brief Gives the written bytes */
+        std::size_t GetSize() const { return m_data.size(); } /**< \brief Gives number of written bytes */
+        bool Failed() const { return m_failed; } /**< \brief Tells if a read went past the end */
+        /** \brief Gives a checksum of the written bytes, equal states give equal checksums */
+        uint32_t Checksum() const;
+
+    protected:
+
+    private:
+        std::vector<uint8_t>    m_data;
+        std::size_t             m_read; /**< position of the next byte to read */
+        bool                    m_failed;
+};
+
+#endif // STATEBUFFER_H
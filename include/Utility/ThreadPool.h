@@ -0,0 +1,77 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+/**
+ *  \file ThreadPool.h
+ *
+ *  Defines class ThreadPool which runs the same job for many indices on a
+ *  fixed set of threads
+ *
+ */
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+/** \class ThreadPool
+ *  \brief Class which spreads a job over a fixed number of threads
+ *  \details The threads are started once and wait between jobs, so running
+ *           a job every simulation step costs no thread starts. Run() gives
+ *           out the indices one by one to whichever thread is free, the
+ *           calling thread included, and returns once all of them are done.
+ *           Jobs for different indices must not touch the same data.
+ */
+class ThreadPool
+{
+    public:
+        /**
+         *  \brief Constructor for ThreadPool
+         *
+         *  \param threads number of threads that run jobs, counting the one
+         *         calling Run(); 0 for one per core
+         */
+        explicit ThreadPool(unsigned int threads);
+        /**
+         *  \brief Destructor for ThreadPool
+         *
+         *  Stops and joins all threads.
+         */
+        ~ThreadPool();
+        ThreadPool(const ThreadPool& other) = delete; /**< \brief Default copy constructor is disabled */
+        ThreadPool& operator=(const ThreadPool&) = delete; /**< \brief Default operator = is disabled */
+
+        /**
+         *  \brief Runs the job once for every index and waits for all of them
+         *
+         *  \param count number of indices, the job gets 0 to count - 1
+         *  \param job function called with an index
+         *  \return void
+         */
+        void Run(unsigned int count, const std::function<void(unsigned int)>& job);
+        /** \brief Gives number of threads that run jobs */
+        unsigned int GetThreads() const { return m_workers.size() + 1; }
+
+    protected:
+
+    private:
+        /** \brief Loop of a worker thread */
+        void Work();
+        /** \brief Runs the job for indices until none are left */
+        void Take();
+
+        std::vector<std::thread>                    m_workers;
+        std::mutex                                  m_mutex;
+        std::condition_variable                     m_start;
+        std::condition_variable                     m_done;
+        const std::function<void(unsigned int)>*    m_job;
+        unsigned int                                m_count;
+        std::atomic<unsigned int>                   m_next; /**< next index to give out */
+        unsigned int                                m_busy; /**< workers still in the job */
+        unsigned long                               m_generation; /**< number of jobs started */
+        bool                                        m_stop;
+};
+
+#endif // THREADPOOL_H
@@ -2,6 +2,7 @@
 #define TIMER_H
 
 #include "System/SystemTimer.h"
+#include "Utility/StateBuffer.h"
 
 /**
  *  \file Timer.h
@@ -87,6 +88,13 @@ class Timer
          *  \return true if the timer is paused and not measuring time.
          */
         bool IsPaused() const;
+        /** \brief Gives the SystemTimer the time is measured from */
+        SystemTimer* GetSystemTimer() const { return m_system_timer; }
+
+        /** \brief Writes the state of the timer */
+        void SaveState(StateBuffer& state) const;
+        /** \brief Reads the state written by SaveState() */
+        void LoadState(StateBuffer& state);
 
     protected:
 
@@ -0,0 +1,69 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+/**
+ *  \file TripleBuffer.h
+ *
+ *  Defines class template TripleBuffer which hands the newest of a stream of
+ *  values from one thread to another without locks
+ *
+ */
+
+#include <atomic>
+
+/** \class TripleBuffer
+ *  \brief Three values, one written, one read and one handed between them
+ *  \details The writing thread fills GetBack() and calls Publish(), which
+ *           swaps it with the value in the middle. The reading thread calls
+ *           Acquire(), which swaps the value it reads with the middle one if
+ *           that one was published since. Neither thread ever waits for the
+ *           other: a writer publishing faster than the reader acquires
+ *           replaces the unread value, a reader acquiring faster than the
+ *           writer publishes keeps reading the last one. The values are
+ *           reused, so a value keeping its memory is not allocated again.
+ *           Only one thread may write and one thread may read.
+ */
+template <typename T>
+class TripleBuffer
+{
+    public:
+        /** \brief Value the writing thread fills before Publish() */
+        T& GetBack() { return m_values[m_back]; }
+        /** \brief Value the reading thread reads, the newest one since Acquire() */
+        const T& GetFront() const { return m_values[m_front]; }
+
+        /**
+         *  \brief Hands the back value to the reading thread
+         *
+         *  The writer gets the middle value as its new back value.
+         *  \return void
+         */
+        void Publish()
+        {
+            m_back = m_middle.exchange(m_back | FRESH, std::memory_order_acq_rel) & INDEX;
+        }
+        /**
+         *  \brief Takes the value published last, if it was not taken yet
+         *
+         *  \return true if GetFront() now gives a newer value
+         */
+        bool Acquire()
+        {
+            // Only the writer changes the middle value, and it leaves it fresh
+            if (!(m_middle.load(std::memory_order_relaxed) & FRESH))
+                return false;
+            m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX;
+            return true;
+        }
+
+    private:
+        static const unsigned int INDEX = 3;
+        static const unsigned int FRESH = 4; /**< set while the middle value was not acquired */
+
+        T                           m_values[3];
+        unsigned int                m_back = 0;
+        unsigned int                m_front = 1;
+        std::atomic<unsigned int>   m_middle{2};
+};
+
+#endif // TRIPLEBUFFER_H
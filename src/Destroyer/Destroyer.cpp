@@ -5,18 +5,20 @@ Destroyer::Destroyer()
 {
 }
 
-void Destroyer::DestroyEnemy(Enemy* enemy,
-                                  unsigned int start_x,
-                                  unsigned int start_y,
-                                  unsigned int tile_size,
-                                  double intensity)
+bool Destroyer::Reaches(unsigned int x,
+                        unsigned int y,
+                        unsigned int w,
+                        unsigned int h,
+                        unsigned int start_x,
+                        unsigned int start_y,
+                        unsigned int tile_size,
+                        double intensity)
 {
-    unsigned int enemy_center_x = enemy->GetX() + enemy->GetSizeW() / 2;
-    unsigned int enemy_center_y = enemy->GetY() + enemy->GetSizeH() / 2;
-    double distance = std::sqrt( Square(start_x-enemy_center_x) + Square(start_y-enemy_center_y) );
+    unsigned int center_x = x + w / 2;
+    unsigned int center_y = y + h / 2;
+    double distance = std::sqrt( Square(start_x-center_x) + Square(start_y-center_y) );
 
-    if (distance < tile_size * intensity / 2)
-        enemy->SetHealth(0);
+    return distance < tile_size * intensity / 2;
 }
 
 void Destroyer::DestroyPlayer(Player* player,
@@ -25,10 +27,7 @@ void Destroyer::DestroyPlayer(Player* player,
                                   unsigned int tile_size,
                                   double intensity)
 {
-    unsigned int player_center_x = player->GetX() + player->GetSizeW() / 2;
-    unsigned int player_center_y = player->GetY() + player->GetSizeH() / 2;
-    double distance = std::sqrt( Square(start_x-player_center_x) + Square(start_y-player_center_y) );
-
-    if (distance < tile_size * intensity / 2)
+    if (Reaches(player->GetX(), player->GetY(), player->GetSizeW(), player->GetSizeH(),
+                start_x, start_y, tile_size, intensity))
         player->SetHealth(0);
 }
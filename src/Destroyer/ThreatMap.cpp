@@ -0,0 +1,135 @@
+#include "Destroyer/ThreatMap.h"
+#include "Destroyer/Destroyer.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+ThreatMap::ThreatMap(unsigned int height, unsigned int width, unsigned int tile_size, unsigned int capacity)
+    : m_height(height),
+      m_width(width),
+      m_tile_size(tile_size),
+      m_time(height * width, NEVER),
+      m_entries(capacity),
+      m_count(0),
+      m_wall_destroyer(tile_size)
+{
+    int side = 2*WALL_DESTROYER_TABLE_REACH + 1;
+    for (auto entry = m_entries.begin(); entry != m_entries.end(); ++entry)
+    {
+        entry->reach.reserve(side*side);
+        entry->spread.reserve(side*side);
+    }
+    m_written.reserve(height * width);
+}
+
+void ThreatMap::Add(const Bomb* bomb, const Map* map)
+{
+    if (m_count == m_entries.size())
+        return;
+
+    Entry& entry = m_entries[m_count++];
+    entry.bomb = bomb;
+    Spread(entry, map);
+    Resolve();
+}
+
+void ThreatMap::Remove(const Bomb* bomb)
+{
+    for (unsigned int i = 0; i < m_count; ++i)
+    {
+        if (m_entries[i].bomb == bomb)
+        {
+            // Swapping keeps the memory of both entries
+            std::swap(m_entries[i], m_entries[--m_count]);
+            return;
+        }
+    }
+}
+
+void ThreatMap::Refresh(const Map* map)
+{
+    for (unsigned int i = 0; i < m_count; ++i)
+        Spread(m_entries[i], map);
+    Resolve();
+}
+
+void ThreatMap::Clear()
+{
+    m_count = 0;
+    Resolve();
+}
+
+void ThreatMap::Spread(Entry& entry, const Map* map)
+{
+    const Bomb* bomb = entry.bomb;
+    entry.tile = (bomb->GetY() / m_tile_size) * m_width + bomb->GetX() / m_tile_size;
+    entry.reach.clear();
+    entry.spread.clear();
+
+    // The bomb can be anywhere inside its tile so one more tile is needed
+    int reach = (int)std::ceil(bomb->GetIntensity()/2) + 1;
+    int row = bomb->GetY() / m_tile_size;
+    int col = bomb->GetX() / m_tile_size;
+    for (int i = std::max(row - reach, 0); i <= std::min(row + reach, (int)m_height - 1); ++i)
+        for (int j = std::max(col - reach, 0); j <= std::min(col + reach, (int)m_width - 1); ++j)
+            if (Destroyer::Reaches(j * m_tile_size, i * m_tile_size, m_tile_size, m_tile_size,
+                                   bomb->GetX(), bomb->GetY(), m_tile_size, bomb->GetIntensity()))
+                entry.reach.push_back(i * m_width + j);
+
+    const std::vector<WallDestroyer::Position>& tiles =
+        m_wall_destroyer.Spread(map, bomb->GetX(), bomb->GetY(), bomb->GetIntensity());
+    for (auto tile = tiles.begin(); tile != tiles.end(); ++tile)
+        entry.spread.push_back(tile->row * m_width + tile->col);
+}
+
+void ThreatMap::Resolve()
+{
+    for (unsigned int i = 0; i < m_count; ++i)
+    {
+        m_entries[i].time = m_entries[i].bomb->GetDetonationTime();
+        m_entries[i].done = false;
+    }
+
+    // The bomb going off first is final, it may then set off the bombs it
+    // reaches at the same time. There are few bombs so they are simply
+    // looked through every time.
+    for (unsigned int n = 0; n < m_count; ++n)
+    {
+        Entry* first = nullptr;
+        for (unsigned int i = 0; i < m_count; ++i)
+            if (!m_entries[i].done && (first == nullptr || m_entries[i].time < first->time))
+                first = &m_entries[i];
+        first->done = true;
+
+        for (unsigned int i = 0; i < m_count; ++i)
+        {
+            Entry& other = m_entries[i];
+            if (other.done || other.time <= first->time)
+                continue;
+            for (auto tile = first->spread.begin(); tile != first->spread.end(); ++tile)
+            {
+                if (*tile == other.tile)
+                {
+                    other.time = first->time;
+                    break;
+                }
+            }
+        }
+    }
+
+    for (auto tile = m_written.begin(); tile != m_written.end(); ++tile)
+        m_time[*tile] = NEVER;
+    m_written.clear();
+
+    for (unsigned int i = 0; i < m_count; ++i)
+    {
+        const Entry& entry = m_entries[i];
+        for (auto tile = entry.reach.begin(); tile != entry.reach.end(); ++tile)
+        {
+            if (m_time[*tile] == NEVER)
+                m_written.push_back(*tile);
+            if (entry.time < m_time[*tile])
+                m_time[*tile] = entry.time;
+        }
+    }
+}
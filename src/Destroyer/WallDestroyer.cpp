@@ -7,78 +7,164 @@
 #endif // DEBUG_OUTPUT_WALLDESTROYER
 
 #include<cmath>
+#include<cstdlib>
 
-WallDestroyer::WallDestroyer(Map* level,
-                             unsigned int start_x,
-                             unsigned int start_y,
-                             unsigned int tile_size,
-                             double intensity,
-                             unsigned int damage)
-    :   m_level(level),
-        m_start_x(start_x),
-        m_start_y(start_y),
-        m_tile_size(tile_size),
-        m_intensity(intensity/2),
-        m_damage(damage)
+WallDestroyer::WallDestroyer(unsigned int tile_size)
+    :   m_tile_size(tile_size),
+        m_start_x(0),
+        m_start_y(0),
+        m_reach_squared(0)
 {
-    int i = m_start_y / tile_size; // row number
-    int j = m_start_x / tile_size; // column number
-    #ifdef DEBUG_OUTPUT_WALLDESTROYER
-    std::cout << "WallDestroyer Start at: (i,j)=" << i << "," << j << std::endl;
-    #endif // DEBUG_OUTPUT_WALLDESTROYER
-    CheckAndCall(i-1,j,-1,0);       //UP
-    CheckAndCall(i+1,j,1,0);        //DOWN
-    CheckAndCall(i,j-1,0,-1);       //LEFT
-    CheckAndCall(i,j+1,0,1);        //RIGHT
-    CheckAndCall(i-1,j-1,-1,-1);    //UP LEFT
-    CheckAndCall(i-1,j+1,-1,1);     //UP RIGHT
-    CheckAndCall(i+1,j-1,1,-1);     //DOWN LEFT
-    CheckAndCall(i+1,j+1,1,1);      //DOWN RIGHT
+    // Shared tables are made here rather than in the middle of a game
+    OffsetTable(1, m_storage);
+    int side = 2*WALL_DESTROYER_TABLE_REACH + 1;
+    m_open.reserve(side*side);
+    m_affected.reserve(side*side);
 }
 
-void WallDestroyer::Spread(int row, int col, int direction_row, int direction_col) const
+const std::vector<WallDestroyer::Position>& WallDestroyer::Explode(Map* level,
+                                                                   unsigned int start_x,
+                                                                   unsigned int start_y,
+                                                                   double intensity,
+                                                                   unsigned int damage)
 {
-    #ifdef DEBUG_OUTPUT_WALLDESTROYER
-    std::cout << "WallDestroyer Explosion spread to: (i,j)=" << row << "," << col << std::endl;
-    #endif // DEBUG_OUTPUT_WALLDESTROYER
-    if ((direction_row != 0))
-        CheckAndCall(row+direction_row,col              ,direction_row,direction_col);
-    if ((direction_col != 0))
-        CheckAndCall(row              ,col+direction_col,direction_row,direction_col);
-    if ((direction_row != 0) && (direction_col != 0))
-        CheckAndCall(row+direction_row,col+direction_col,direction_row,direction_col);
+    Spread(level, start_x, start_y, intensity);
+
+    // Walls only stop the explosion, so damaging them afterwards changes nothing
+    // about where it spread
+    for (auto tile = m_affected.begin() + 1; tile != m_affected.end(); ++tile)
+    {
+        if (level->GetTileType(tile->row, tile->col) == MapObject::DESTRUCTIBLE_WALL)
+        {
+            #ifdef DEBUG_OUTPUT_WALLDESTROYER
+            std::cout << "WallDestroyer Destroying wall: (i,j)=" << tile->row << "," << tile->col << std::endl;
+            #endif // DEBUG_OUTPUT_WALLDESTROYER
+            level->DestroyWall(tile->row, tile->col, damage);
+        }
+    }
+    return m_affected;
 }
 
-void WallDestroyer::Destroy(int row, int col) const
+const std::vector<WallDestroyer::Position>& WallDestroyer::Spread(const Map* level,
+                                                                  unsigned int start_x,
+                                                                  unsigned int start_y,
+                                                                  double intensity)
 {
-    double distance = DistanceToCenter(row,col);
+    m_start_x = start_x;
+    m_start_y = start_y;
+    m_reach_squared = (intensity/2 * m_tile_size) * (intensity/2 * m_tile_size);
+
+    int i = m_start_y / m_tile_size; // row number
+    int j = m_start_x / m_tile_size; // column number
     #ifdef DEBUG_OUTPUT_WALLDESTROYER
-    std::cout << "WallDestroyer Destroy: distance=" << distance << ", reach=" << m_intensity * m_tile_size << std::endl;
+    std::cout << "WallDestroyer Start at: (i,j)=" << i << "," << j << std::endl;
     #endif // DEBUG_OUTPUT_WALLDESTROYER
-    if (distance < m_intensity * m_tile_size)
+
+    // The bomb can be anywhere inside its tile so one more tile is needed
+    int reach = (int)std::ceil(intensity/2) + 1;
+    const std::vector<Offset>& table = OffsetTable(reach, m_storage);
+
+    // Tiles of the window around the bomb through which the explosion spreads
+    int side = 2*reach + 1;
+    m_open.assign(side*side, false);
+    m_open[reach*side + reach] = true;
+    m_affected.clear();
+    m_affected.push_back({i, j});
+
+    int height = level->GetHeight();
+    int width = level->GetWidth();
+    for (auto o = table.begin(); o != table.end(); ++o)
     {
-        #ifdef DEBUG_OUTPUT_WALLDESTROYER
-        std::cout << "WallDestroyer Destroying wall: (i,j)=" << row << "," << col << std::endl;
-        #endif // DEBUG_OUTPUT_WALLDESTROYER
-        m_level->DestroyWall(row,col,m_damage);
+        if (!m_open[o->from[0]] && !(o->from[1] >= 0 && m_open[o->from[1]]) && !(o->from[2] >= 0 && m_open[o->from[2]]))
+            continue;
+
+        int row = i + o->row;
+        int col = j + o->col;
+        if (row < 0 || col < 0 || row >= height || col >= width || !InReach(row, col))
+            continue;
+
+        MapObject::Tile tile = level->GetTileType(row, col);
+        if (tile == MapObject::EMPTY)
+        {
+            #ifdef DEBUG_OUTPUT_WALLDESTROYER
+            std::cout << "WallDestroyer Explosion spread to: (i,j)=" << row << "," << col << std::endl;
+            #endif // DEBUG_OUTPUT_WALLDESTROYER
+            m_open[o->cell] = true;
+            m_affected.push_back({row, col});
+        }
+        else if (tile == MapObject::DESTRUCTIBLE_WALL)
+        {
+            m_affected.push_back({row, col});
+        }
     }
+    return m_affected;
 }
 
-double WallDestroyer::DistanceToCenter(int row, int col) const
+const std::vector<WallDestroyer::Offset>& WallDestroyer::OffsetTable(int reach, std::vector<Offset>& storage)
 {
-    int wall_center_x = col * m_tile_size + m_tile_size / 2;
-    int wall_center_y = row * m_tile_size + m_tile_size / 2;
-    return std::sqrt( Square(m_start_x-wall_center_x) + Square(m_start_y-wall_center_y) );
+    static const std::vector<std::vector<Offset>> tables = []()
+    {
+        std::vector<std::vector<Offset>> made(WALL_DESTROYER_TABLE_REACH + 1);
+        for (int r = 1; r <= WALL_DESTROYER_TABLE_REACH; ++r)
+            MakeOffsetTable(r, made[r]);
+        return made;
+    }();
+
+    if (reach <= WALL_DESTROYER_TABLE_REACH)
+        return tables[reach];
+    MakeOffsetTable(reach, storage);
+    return storage;
 }
 
-void WallDestroyer::CheckAndCall(int new_row, int new_col, int direction_row, int direction_col) const
+void WallDestroyer::MakeOffsetTable(int reach, std::vector<Offset>& table)
 {
-    if (DistanceToCenter(new_row,new_col) < m_intensity * m_tile_size)
+    int side = 2*reach + 1;
+    auto cell = [reach, side](int row, int col) { return (row + reach)*side + col + reach; };
+
+    table.clear();
+    // Ordered by distance in steps so every tile follows the ones it is reached from
+    for (int steps = 1; steps <= 2*reach; ++steps)
     {
-        MapObject::Tile tile = m_level->GetTileType(new_row,new_col);
-        if (tile == MapObject::EMPTY)
-            Spread(new_row,new_col,direction_row,direction_col);
-        else if (tile == MapObject::DESTRUCTIBLE_WALL)
-            Destroy(new_row,new_col);
+        for (int row = -reach; row <= reach; ++row)
+        {
+            int rest = steps - std::abs(row);
+            if (rest < 0 || rest > reach)
+                continue;
+            for (int col = -rest; col <= rest; col += (rest ? 2*rest : 1))
+            {
+                int direction_row = (row > 0) - (row < 0);
+                int direction_col = (col > 0) - (col < 0);
+                Offset offset = {row, col, cell(row, col), {-1, -1, -1}};
+
+                if (row == 0 || col == 0)
+                {
+                    // Along an axis the explosion only goes straight
+                    offset.from[0] = cell(row - direction_row, col - direction_col);
+                }
+                else if (std::abs(row) == 1 && std::abs(col) == 1)
+                {
+                    offset.from[0] = cell(0, 0);
+                }
+                else
+                {
+                    // Inside a quadrant it comes from the tiles closer to the bomb
+                    int n = 0;
+                    if (std::abs(row) > 1)
+                        offset.from[n++] = cell(row - direction_row, col);
+                    if (std::abs(col) > 1)
+                        offset.from[n++] = cell(row, col - direction_col);
+                    if (std::abs(row) > 1 && std::abs(col) > 1)
+                        offset.from[n++] = cell(row - direction_row, col - direction_col);
+                }
+                table.push_back(offset);
+            }
+        }
     }
 }
+
+bool WallDestroyer::InReach(int row, int col) const
+{
+    int wall_center_x = col * m_tile_size + m_tile_size / 2;
+    int wall_center_y = row * m_tile_size + m_tile_size / 2;
+    return Square(m_start_x - wall_center_x) + Square(m_start_y - wall_center_y) < m_reach_squared;
+}
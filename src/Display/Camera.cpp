@@ -0,0 +1,67 @@
+#include "Display/Camera.h"
+#include "Manager/Map.h"
+#include "Manager/PlayerManager.h"
+#include "Entity/Player.h"
+
+Camera::Camera(unsigned int width, unsigned int height)
+    : m_view{0, 0, (int)width, (int)height},
+      m_from_x(0),
+      m_from_y(0),
+      m_placed(false)
+{
+}
+
+void Camera::Follow(Relay* relay)
+{
+    const Map* map = relay->GetMap();
+    long x = 0;
+    long y = 0;
+    unsigned int players = 0;
+    for (PlayerManager::Iterator it(relay->GetPlayerManager()); !it.Finished(); ++it)
+    {
+        const Player& player = it.GetPlayer();
+        if (player.GetLives() == 0 || player.IsLevelCompleted())
+            continue;
+        x += player.GetX() + player.GetSizeW() / 2;
+        y += player.GetY() + player.GetSizeH() / 2;
+        ++players;
+    }
+
+    unsigned int world_width = map->GetWidth() * map->GetTileSize();
+    unsigned int world_height = map->GetHeight() * map->GetTileSize();
+    if (players > 0)
+        LookAt(x / players, y / players, world_width, world_height);
+    else
+        LookAt(m_view.x + m_view.w / 2, m_view.y + m_view.h / 2, world_width, world_height);
+}
+
+void Camera::LookAt(int x, int y, unsigned int world_width, unsigned int world_height)
+{
+    int view_x = Place(x, m_view.w, world_width);
+    int view_y = Place(y, m_view.h, world_height);
+    if (m_placed)
+    {
+        m_from_x = m_view.x;
+        m_from_y = m_view.y;
+    }
+    else
+    {
+        m_from_x = view_x;
+        m_from_y = view_y;
+        m_placed = true;
+    }
+    m_view.x = view_x;
+    m_view.y = view_y;
+}
+
+int Camera::Place(int center, int view, int world)
+{
+    if (world <= view)
+        return (world - view) / 2;
+    int place = center - view / 2;
+    if (place < 0)
+        return 0;
+    if (place > world - view)
+        return world - view;
+    return place;
+}
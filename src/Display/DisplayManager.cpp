@@ -7,13 +7,20 @@ DisplayManager::DisplayManager(SDL_Texture* texture,
                                SDL_Renderer* renderer,
                                bool* running,
                                unsigned int window_width,
-                               unsigned int window_height)
+                               unsigned int window_height,
+                               Display* first)
     : m_renderer(renderer),
       m_window_width(window_width),
       m_window_height(window_height)
 {
     m_displays.push(new ExitDisplay(running));
-    m_displays.push(new WelcomeDisplay(texture,renderer,window_width,window_height));
+    if (first == nullptr)
+        m_displays.push(new WelcomeDisplay(texture,renderer,window_width,window_height));
+    else
+    {
+        m_displays.push(first);
+        first->Init();
+    }
 }
 
 DisplayManager::~DisplayManager()
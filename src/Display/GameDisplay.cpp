@@ -1,29 +1,23 @@
 #include "Display/GameDisplay.h"
 #include "Display/PauseDisplay.h"
-#include "System/SystemTimer.h"
-
-#include "Utility/Relay.h"
-#include "Manager/Map.h"
-#include "Manager/BombManager.h"
-#include "Manager/ExplosionManager.h"
-#include "Manager/PlayerManager.h"
-#include "Manager/EnemyManager.h"
-#include "Manager/PickUpManager.h"
+#include "System/FreeTimer.h"
 
 #include "Constants/ResourcesConstants.h"
 #include "Constants/WindowConstants.h"
+#include "Constants/SimulationConstants.h"
 
 #include <string>
-#include <sstream>
+#include <ctime>
+#include <iostream>
 
 GameDisplay::GameDisplay(SDL_Texture* texture,
                          SDL_Renderer* renderer,
                          unsigned int window_width,
                          unsigned int window_height,
                          unsigned int players_number,
-                         unsigned int current_level,
-                         unsigned int number_of_screen_elements)
+                         unsigned int current_level)
     : Display(),
+      m_world(nullptr),
       m_texture(texture),
       m_renderer(renderer),
       m_window_width(window_width),
@@ -31,75 +25,117 @@ GameDisplay::GameDisplay(SDL_Texture* texture,
       m_players_number(players_number),
       m_current_level(current_level),
       m_level_completed(false),
-      m_music(nullptr)
-{
-    m_display_elements.reserve(number_of_screen_elements);
-    SystemTimer::Instance()->Pause();
-
-    unsigned int tile_size = MAP_TILE_SIZE;
-    m_relay = new Relay();
-
-    std::string level_num;
-    std::stringstream convert;
-    convert << m_current_level;
-    level_num = convert.str();
-
-    std::string path_level = RESOURCES_LEVELS_PATH + RESOURCES_LEVEL_MAP + level_num + RESOURCES_LEVEL_MAP_EXT;
-    std::string path_player = RESOURCES_LEVELS_PATH + RESOURCES_LEVEL_PLAYER + level_num + RESOURCES_LEVEL_PLAYER_EXT;
-    std::string path_enemy = RESOURCES_LEVELS_PATH + RESOURCES_LEVEL_ENEMY + level_num + RESOURCES_LEVEL_ENEMY_EXT;
-
-    Map* level = new Map(path_level, m_texture, tile_size, m_relay);
-    ExplosionManager* explosion_manager = new ExplosionManager(m_texture, tile_size);
-    BombManager* bomb_manager = new BombManager(m_texture, tile_size, m_relay);
-    PlayerManager* player_manager = new PlayerManager(path_player, m_texture, tile_size, m_relay, m_players_number);
-    if (m_players_number>1)
-        player_manager->GetPlayerById(1)->SetKeycodes(SDLK_w, SDLK_s, SDLK_a, SDLK_d, SDLK_g);
-    EnemyManager* enemy_manager = new EnemyManager(path_enemy, m_texture, tile_size, m_relay);
-    PickUpManager* pickup_manager = new PickUpManager(m_texture,tile_size,m_relay);
-
-    m_relay->SetExplosionManager(explosion_manager);
-    m_relay->SetBombManager(bomb_manager);
-    m_relay->SetPlayerManager(player_manager);
-    m_relay->SetEnemyManager(enemy_manager);
-    m_relay->SetMap(level);
-    m_relay->SetPickUpManager(pickup_manager);
-
-    AddDisplayElement(level);
-    AddDisplayElement(pickup_manager);
-    AddDisplayElement(bomb_manager);
-    AddDisplayElement(player_manager);
-    AddDisplayElement(enemy_manager);
-    AddDisplayElement(explosion_manager);
+      m_music(nullptr),
+      m_replay(nullptr),
+      m_world_input(nullptr),
+      m_session(nullptr),
+      m_step(0),
+      m_buttons(0),
+      m_ending(PLAYING),
+      m_simulating(false),
+      m_layer_revision(0),
+      m_camera(window_width, window_height),
+      m_matched_step(0),
+      m_apart_step(0)
+{
+    m_world = new World(m_texture, MAP_TILE_SIZE, m_players_number, m_current_level, &m_local_input, time(nullptr), &m_timer);
+    m_world->GetInputKeys(m_keys);
+    m_recording = InputRecording(m_current_level, m_players_number, m_world->GetSeed(), m_keys);
 
     std::string path_music = RESOURCES_BASE_PATH + RESOURCES_MUSIC_GAME;
     m_music = Mix_LoadMUS(path_music.c_str());
 }
 
-GameDisplay::~GameDisplay()
+GameDisplay::GameDisplay(SDL_Texture* texture,
+                         SDL_Renderer* renderer,
+                         unsigned int window_width,
+                         unsigned int window_height,
+                         InputRecording* replay)
+    : Display(),
+      m_world(nullptr),
+      m_texture(texture),
+      m_renderer(renderer),
+      m_window_width(window_width),
+      m_window_height(window_height),
+      m_players_number(replay->GetPlayers()),
+      m_current_level(replay->GetLevel()),
+      m_level_completed(false),
+      m_music(nullptr),
+      m_replay(replay),
+      m_world_input(new ScriptedInput()),
+      m_session(nullptr),
+      m_step(0),
+      m_buttons(0),
+      m_ending(PLAYING),
+      m_simulating(false),
+      m_layer_revision(0),
+      m_camera(window_width, window_height),
+      m_matched_step(0),
+      m_apart_step(0)
 {
-    for (auto i = m_display_elements.begin(); i != m_display_elements.end(); ++i)
-    {
-        delete (*i);
-    }
-    m_display_elements.clear();
-    delete m_relay;
+    m_world = new World(m_texture, MAP_TILE_SIZE, m_players_number, m_current_level, m_world_input, m_replay->GetSeed(), &m_timer);
+    m_world->GetInputKeys(m_keys);
+
+    std::string path_music = RESOURCES_BASE_PATH + RESOURCES_MUSIC_GAME;
+    m_music = Mix_LoadMUS(path_music.c_str());
+}
+
+GameDisplay::GameDisplay(SDL_Texture* texture,
+                         SDL_Renderer* renderer,
+                         unsigned int window_width,
+                         unsigned int window_height,
+                         const NetworkOptions& network,
+                         UdpSocket* socket)
+    : Display(),
+      m_world(nullptr),
+      m_texture(texture),
+      m_renderer(renderer),
+      m_window_width(window_width),
+      m_window_height(window_height),
+      m_players_number(2),
+      m_current_level(network.level),
+      m_level_completed(false),
+      m_music(nullptr),
+      m_replay(nullptr),
+      m_world_input(new ScriptedInput()),
+      m_session(nullptr),
+      m_step(0),
+      m_buttons(0),
+      m_ending(PLAYING),
+      m_simulating(false),
+      m_layer_revision(0),
+      m_camera(window_width, window_height),
+      m_matched_step(0),
+      m_apart_step(0)
+{
+    // Both devices count the steps of the World from 0, as its clock does
+    m_world = new World(m_texture, MAP_TILE_SIZE, m_players_number, m_current_level, m_world_input, network.seed, &m_timer);
+    m_world->GetInputKeys(m_keys);
+    m_session = new RollbackSession(m_world, m_world_input, network.local_player, m_current_level, socket);
+
+    std::string path_music = RESOURCES_BASE_PATH + RESOURCES_MUSIC_GAME;
+    m_music = Mix_LoadMUS(path_music.c_str());
 }
 
-void GameDisplay::AddDisplayElement(DisplayElement* display_element)
+GameDisplay::~GameDisplay()
 {
-    m_display_elements.push_back(display_element);
+    Stop();
+    delete m_session;
+    delete m_world;
+    delete m_world_input;
 }
 
 void GameDisplay::Init()
 {
     Mix_PlayMusic(m_music, -1);
-    SystemTimer::Instance()->Unpause();
+    // The first frame is drawn before the simulation thread made a step
+    Publish(SDL_GetTicks());
+    Start();
 }
 
 void GameDisplay::Enter(int mode)
 {
     Mix_ResumeMusic();
-    SystemTimer::Instance()->Unpause();
     m_leave_next = false;
     if (mode == 0)
     {
@@ -108,26 +144,41 @@ void GameDisplay::Enter(int mode)
     else
     {
         m_leave_previous = false;
+        Start();
     }
 }
 
 void GameDisplay::Leave()
 {
     Mix_PauseMusic();
-    SystemTimer::Instance()->Pause();
+    Stop();
 }
 
 int GameDisplay::Destroy()
 {
+    Stop();
     Mix_PauseMusic();
     Mix_FreeMusic(m_music);
 
-    for (auto i = m_display_elements.begin(); i != m_display_elements.end(); ++i)
+    bool network = m_session != nullptr;
+    if (network)
+        m_session->Finish();
+    delete m_session;
+    m_session = nullptr;
+    if (m_replay != nullptr && m_apart_step == 0 && m_ending != PLAYING && m_step < m_replay->GetSteps())
+        std::cout << "Replay ended after step " << m_step << " of the " << m_replay->GetSteps()
+                  << " recorded steps" << std::endl;
+    if (m_replay == nullptr && !network)
     {
-        delete (*i);
+        m_world->SaveState(m_check_state);
+        m_recording.AddChecksum(m_step, m_check_state.Checksum());
     }
-    m_display_elements.clear();
-    delete m_relay;
+    delete m_world;
+    m_world = nullptr;
+    if (m_replay != nullptr || network)
+        return 0;
+
+    m_recording.Save(RESOURCES_RECORDING_PATH);
     if (m_level_completed)
         return ++m_current_level;
     else
@@ -136,15 +187,11 @@ int GameDisplay::Destroy()
 
 void GameDisplay::Update()
 {
-    if (m_relay->PlayersDead())
-    {
-        m_leave_previous = true;
-        m_level_completed = false;
-    }
-    else if (m_relay->LevelCompleted())
+    int ending = m_ending.load();
+    if (ending != PLAYING)
     {
         m_leave_previous = true;
-        m_level_completed = true;
+        m_level_completed = ending == COMPLETED;
     }
     else if (m_keyboard_input->IsKeyOn(11))
     {
@@ -153,17 +200,157 @@ void GameDisplay::Update()
     }
     else
     {
-        for (auto i = m_display_elements.begin(); i != m_display_elements.end(); ++i)
+        uint32_t buttons = 0;
+        for (unsigned int i = 0; i < m_keys.size(); ++i)
+            if (m_keyboard_input->IsKeyOn(m_keys[i]))
+                buttons |= 1u << i;
+        m_buttons.store(buttons, std::memory_order_relaxed);
+    }
+}
+
+void GameDisplay::Draw(SDL_Renderer* renderer) const
+{
+    m_frames.Acquire();
+    const RenderSnapshot& frame = m_frames.GetFront();
+    m_layer.Update(frame);
+    m_layer_revision.store(m_layer.GetRevision(), std::memory_order_relaxed);
+    m_batch.Build(frame, SDL_GetTicks());
+    m_layer.Draw(renderer, m_batch.GetView());
+    m_batch.Submit(renderer);
+}
+
+void GameDisplay::Start()
+{
+    if (m_thread.joinable())
+        return;
+    m_simulating = true;
+    m_thread = std::thread(&GameDisplay::Simulate, this);
+}
+
+void GameDisplay::Stop()
+{
+    m_simulating = false;
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+void GameDisplay::Simulate()
+{
+    // Replays run as many steps in the time of one as a hitch may drop
+    unsigned long speed = m_replay != nullptr ? SIMULATION_MAX_STEPS_PER_FRAME : 1;
+    FreeTimer clock;
+    unsigned long accumulator = 0;
+
+    while (m_simulating)
+    {
+        unsigned long elapsed = clock.GetTimeElapsed();
+        clock.DecreaseTimer(elapsed);
+        accumulator += elapsed * speed;
+        if (accumulator > SIMULATION_STEP_LENGTH * SIMULATION_MAX_STEPS_PER_FRAME)
+            accumulator = SIMULATION_STEP_LENGTH * SIMULATION_MAX_STEPS_PER_FRAME;
+
+        bool stepped = false;
+        while (accumulator >= SIMULATION_STEP_LENGTH && m_ending == PLAYING)
         {
-            (*i)->Update();
+            if (!Step())
+                break;
+            accumulator -= SIMULATION_STEP_LENGTH;
+            stepped = true;
         }
+        // The last step was due the rest of the accumulator ago
+        if (stepped)
+            Publish(SDL_GetTicks() - accumulator / speed);
+
+        SDL_Delay((SIMULATION_STEP_LENGTH - accumulator % SIMULATION_STEP_LENGTH) / speed + 1);
     }
 }
 
-void GameDisplay::Draw(SDL_Renderer* renderer) const
+bool GameDisplay::Step()
 {
-    for (auto i = m_display_elements.cbegin(); i != m_display_elements.cend(); ++i)
+    // A predicted step may still be rolled back, so the level ends only on
+    // steps made with the peer's real buttons
+    bool confirmed = m_session == nullptr || m_session->Confirmed();
+    if (confirmed && m_world->PlayersDead())
     {
-        (*i)->Draw(renderer);
+        m_ending = FAILED;
+        return false;
     }
+    if (confirmed && m_world->LevelCompleted())
+    {
+        m_ending = COMPLETED;
+        return false;
+    }
+    if (m_replay != nullptr && m_step >= m_replay->GetSteps())
+    {
+        m_ending = FAILED;
+        return false;
+    }
+
+    // Releases go first, as pressing a direction releases the others
+    uint32_t buttons = m_buttons.load(std::memory_order_relaxed);
+    for (unsigned int pass = 0; pass < 2; ++pass)
+    {
+        for (unsigned int i = 0; i < m_keys.size(); ++i)
+        {
+            bool on = buttons >> i & 1;
+            if (pass == 0 && !on && m_local_input.IsKeyOn(m_keys[i]))
+                m_local_input.TurnKeyOff(m_keys[i]);
+            else if (pass == 1 && on && !m_local_input.IsKeyOn(m_keys[i]))
+                m_local_input.TurnKeyOn(m_keys[i]);
+        }
+    }
+
+    m_timer.Step();
+    if (m_session != nullptr)
+    {
+        if (m_session->Advance(m_session->ReadButtons(&m_local_input)))
+            ++m_step;
+    }
+    else
+    {
+        if (m_replay != nullptr)
+            m_replay->Play(m_step, m_world_input);
+        else
+            m_recording.Record(&m_local_input);
+        m_world->Update();
+        ++m_step;
+        CheckState();
+    }
+    return true;
+}
+
+void GameDisplay::CheckState()
+{
+    uint32_t recorded;
+    if (m_replay == nullptr)
+    {
+        if (InputRecording::ChecksumDue(m_step))
+        {
+            m_world->SaveState(m_check_state);
+            m_recording.AddChecksum(m_step, m_check_state.Checksum());
+        }
+    }
+    else if (m_apart_step == 0 && m_replay->GetChecksum(m_step, recorded))
+    {
+        m_world->SaveState(m_check_state);
+        if (m_check_state.Checksum() == recorded)
+            m_matched_step = m_step;
+        else
+        {
+            m_apart_step = m_step;
+            std::cout << "Replay went apart from the recording between steps " << m_matched_step
+                      << " and " << m_step << std::endl;
+        }
+    }
+}
+
+void GameDisplay::Publish(unsigned long ticks)
+{
+    RenderSnapshot& frame = m_frames.GetBack();
+    // Snapshots only carry the tiles which changed since the ones Draw() took
+    frame.Clear(ticks, m_layer_revision.load(std::memory_order_relaxed));
+    m_camera.Follow(m_world->GetRelay());
+    frame.SetView(m_camera.GetView(), m_camera.GetFromX(), m_camera.GetFromY());
+    m_world->Draw(frame);
+    m_frames.Publish();
 }
@@ -0,0 +1,130 @@
+#include "Display/MapLayer.h"
+#include <algorithm>
+
+MapLayer::~MapLayer()
+{
+    if (m_target != nullptr)
+        SDL_DestroyTexture(m_target);
+}
+
+void MapLayer::Update(const RenderSnapshot& snapshot)
+{
+    const RenderSnapshot::Layer& layer = snapshot.GetLayer();
+    if (layer.revision == 0 || layer.revision <= m_revision)
+        return;
+
+    if (layer.width != m_width || layer.height != m_height || layer.tile_size != m_tile_size)
+    {
+        // Another map, its snapshots hold every tile
+        if (m_target != nullptr)
+            SDL_DestroyTexture(m_target);
+        m_target = nullptr;
+        m_no_target = false;
+        m_width = layer.width;
+        m_height = layer.height;
+        m_tile_size = layer.tile_size;
+        m_sources.assign(m_width * m_height, SDL_Rect{0, 0, 0, 0});
+        m_dirty.clear();
+    }
+    m_texture = layer.texture;
+    m_revision = layer.revision;
+
+    const std::vector<RenderSnapshot::Tile>& tiles = snapshot.GetTiles();
+    for (auto tile = tiles.begin(); tile != tiles.end(); ++tile)
+    {
+        if (tile->index >= m_sources.size())
+            continue;
+        m_sources[tile->index] = tile->source;
+        m_dirty.push_back(tile->index);
+    }
+}
+
+bool MapLayer::MakeTarget(SDL_Renderer* renderer)
+{
+    if (m_target != nullptr)
+        return true;
+    if (m_no_target || m_sources.empty())
+        return false;
+    SDL_RendererInfo info;
+    bool fits = SDL_GetRendererInfo(renderer, &info) == 0
+             && m_width * m_tile_size <= (unsigned int)info.max_texture_width
+             && m_height * m_tile_size <= (unsigned int)info.max_texture_height;
+    if (fits && SDL_RenderTargetSupported(renderer))
+        m_target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                     m_width * m_tile_size, m_height * m_tile_size);
+    if (m_target == nullptr)
+    {
+        m_no_target = true;
+        return false;
+    }
+    Invalidate();
+    return true;
+}
+
+void MapLayer::Invalidate()
+{
+    m_dirty.clear();
+    for (unsigned int index = 0; index < m_sources.size(); ++index)
+        m_dirty.push_back(index);
+}
+
+void MapLayer::DrawTiles(SDL_Renderer* renderer, const SDL_Rect& view)
+{
+    int size = m_tile_size;
+    int first_column = view.x > 0 ? view.x / size : 0;
+    int first_row = view.y > 0 ? view.y / size : 0;
+    int last_column = std::min((int)m_width - 1, (view.x + view.w - 1) / size);
+    int last_row = std::min((int)m_height - 1, (view.y + view.h - 1) / size);
+
+    SDL_Rect dest = {0, 0, size, size};
+    for (int row = first_row; row <= last_row; ++row)
+    {
+        dest.y = row * size - view.y;
+        for (int column = first_column; column <= last_column; ++column)
+        {
+            dest.x = column * size - view.x;
+            SDL_RenderCopy(renderer, m_texture, &m_sources[row * m_width + column], &dest);
+            ++m_blits;
+        }
+    }
+}
+
+void MapLayer::Draw(SDL_Renderer* renderer, const SDL_Rect& view)
+{
+    m_blits = 0;
+    if (m_sources.empty())
+        return;
+
+    SDL_Rect shown = view;
+    if (shown.w == 0 || shown.h == 0)
+        shown = {0, 0, (int)(m_width * m_tile_size), (int)(m_height * m_tile_size)};
+    if (!MakeTarget(renderer))
+    {
+        m_dirty.clear();
+        DrawTiles(renderer, shown);
+        return;
+    }
+
+    if (!m_dirty.empty())
+    {
+        SDL_Rect dest = {0, 0, (int)m_tile_size, (int)m_tile_size};
+        SDL_SetRenderTarget(renderer, m_target);
+        for (auto index = m_dirty.begin(); index != m_dirty.end(); ++index)
+        {
+            dest.x = *index % m_width * m_tile_size;
+            dest.y = *index / m_width * m_tile_size;
+            SDL_RenderCopy(renderer, m_texture, &m_sources[*index], &dest);
+        }
+        SDL_SetRenderTarget(renderer, nullptr);
+        m_blits = m_dirty.size();
+        m_dirty.clear();
+    }
+
+    // The part of the view which lies on the map, a view larger than the map leaves a border
+    SDL_Rect whole = {0, 0, (int)(m_width * m_tile_size), (int)(m_height * m_tile_size)};
+    SDL_Rect source;
+    if (!SDL_IntersectRect(&whole, &shown, &source))
+        return;
+    SDL_Rect dest = {source.x - shown.x, source.y - shown.y, source.w, source.h};
+    SDL_RenderCopy(renderer, m_target, &source, &dest);
+}
@@ -0,0 +1,60 @@
+#include "Display/RenderSnapshot.h"
+#include <algorithm>
+
+void RenderSnapshot::Clear(unsigned long ticks, unsigned long layer_base)
+{
+    m_sprites.clear();
+    m_overlay.clear();
+    m_tiles.clear();
+    m_layer = {nullptr, 0, 0, 0, 0};
+    m_ticks = ticks;
+    m_layer_base = layer_base;
+    m_has_view = false;
+}
+
+void RenderSnapshot::SetView(const SDL_Rect& view, int from_x, int from_y)
+{
+    m_has_view = true;
+    m_view = view;
+    m_view_from_x = from_x;
+    m_view_from_y = from_y;
+
+    int left = std::min(view.x, from_x) - (int)VIEW_MARGIN;
+    int top = std::min(view.y, from_y) - (int)VIEW_MARGIN;
+    int right = std::max(view.x, from_x) + view.w + (int)VIEW_MARGIN;
+    int bottom = std::max(view.y, from_y) + view.h + (int)VIEW_MARGIN;
+    m_area = {left, top, right - left, bottom - top};
+}
+
+bool RenderSnapshot::Seen(const SDL_Rect& dest, int from_x, int from_y) const
+{
+    if (!m_has_view)
+        return true;
+    int left = std::min(dest.x, from_x);
+    int top = std::min(dest.y, from_y);
+    int right = std::max(dest.x, from_x) + dest.w;
+    int bottom = std::max(dest.y, from_y) + dest.h;
+    return right > m_area.x && left < m_area.x + m_area.w && bottom > m_area.y && top < m_area.y + m_area.h;
+}
+
+void RenderSnapshot::Copy(SDL_Texture* texture, const SDL_Rect& source, const SDL_Rect& dest)
+{
+    if (Seen(dest, dest.x, dest.y))
+        m_sprites.push_back({texture, source, dest, dest.x, dest.y});
+}
+
+void RenderSnapshot::Move(SDL_Texture* texture, const SDL_Rect& source, const SDL_Rect& dest, int from_x, int from_y)
+{
+    if (Seen(dest, from_x, from_y))
+        m_sprites.push_back({texture, source, dest, from_x, from_y});
+}
+
+void RenderSnapshot::Overlay(SDL_Texture* texture, const SDL_Rect& source, const SDL_Rect& dest)
+{
+    m_overlay.push_back({texture, source, dest, dest.x, dest.y});
+}
+
+void RenderSnapshot::SetLayer(SDL_Texture* texture, unsigned int width, unsigned int height, unsigned int tile_size, unsigned long revision)
+{
+    m_layer = {texture, width, height, tile_size, revision};
+}
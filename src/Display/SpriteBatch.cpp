@@ -0,0 +1,105 @@
+#include "Display/SpriteBatch.h"
+#include "Constants/SimulationConstants.h"
+
+void SpriteBatch::Build(const RenderSnapshot& snapshot, unsigned long ticks)
+{
+    // The next step is due SIMULATION_STEP_LENGTH after this one was made
+    unsigned long since = ticks > snapshot.GetTicks() ? ticks - snapshot.GetTicks() : 0;
+    double interpolation = since < SIMULATION_STEP_LENGTH ? (double)since / SIMULATION_STEP_LENGTH : 1.0;
+
+    const std::vector<RenderSnapshot::Sprite>& sprites = snapshot.GetSprites();
+    const std::vector<RenderSnapshot::Sprite>& overlay = snapshot.GetOverlay();
+    unsigned int count = sprites.size() + overlay.size();
+    m_snapshot = &snapshot;
+    m_count = 0;
+    m_runs.clear();
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    m_vertices.clear();
+    m_vertices.reserve(count * 4);
+    while (m_indices.size() < count * 6)
+    {
+        int v = m_indices.size() / 6 * 4;
+        int quad[6] = {v, v + 1, v + 2, v + 2, v + 1, v + 3};
+        m_indices.insert(m_indices.end(), quad, quad + 6);
+    }
+#else
+    m_dests.clear();
+    m_dests.reserve(count);
+#endif
+
+    m_view = {0, 0, 0, 0};
+    if (snapshot.HasView())
+    {
+        const SDL_Rect& view = snapshot.GetView();
+        m_view = view;
+        m_view.x = snapshot.GetViewFromX() + (int)((view.x - snapshot.GetViewFromX()) * interpolation + 0.5);
+        m_view.y = snapshot.GetViewFromY() + (int)((view.y - snapshot.GetViewFromY()) * interpolation + 0.5);
+    }
+
+    for (auto sprite = sprites.begin(); sprite != sprites.end(); ++sprite)
+        Add(*sprite, interpolation, -m_view.x, -m_view.y);
+    for (auto sprite = overlay.begin(); sprite != overlay.end(); ++sprite)
+        Add(*sprite, interpolation, 0, 0);
+}
+
+void SpriteBatch::Add(const RenderSnapshot::Sprite& sprite, double interpolation, int offset_x, int offset_y)
+{
+    if (m_runs.empty() || m_runs.back().texture != sprite.texture)
+        m_runs.push_back({sprite.texture, m_count, 0});
+    ++m_runs.back().count;
+    ++m_count;
+
+    SDL_Rect dest = sprite.dest;
+    dest.x = sprite.from_x + (int)((dest.x - sprite.from_x) * interpolation + 0.5) + offset_x;
+    dest.y = sprite.from_y + (int)((dest.y - sprite.from_y) * interpolation + 0.5) + offset_y;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (sprite.texture != m_size_texture && sprite.texture != nullptr)
+    {
+        int w = 1, h = 1;
+        SDL_QueryTexture(sprite.texture, nullptr, nullptr, &w, &h);
+        m_size_texture = sprite.texture;
+        m_texture_w = w;
+        m_texture_h = h;
+    }
+
+    float left = dest.x, top = dest.y, right = dest.x + dest.w, bottom = dest.y + dest.h;
+    float u0 = sprite.source.x / m_texture_w, v0 = sprite.source.y / m_texture_h;
+    float u1 = (sprite.source.x + sprite.source.w) / m_texture_w;
+    float v1 = (sprite.source.y + sprite.source.h) / m_texture_h;
+    SDL_Color white = {255, 255, 255, 255};
+    m_vertices.push_back({{left, top}, white, {u0, v0}});
+    m_vertices.push_back({{right, top}, white, {u1, v0}});
+    m_vertices.push_back({{left, bottom}, white, {u0, v1}});
+    m_vertices.push_back({{right, bottom}, white, {u1, v1}});
+#else
+    m_dests.push_back(dest);
+#endif
+}
+
+const RenderSnapshot::Sprite& SpriteBatch::GetSprite(unsigned int i) const
+{
+    const std::vector<RenderSnapshot::Sprite>& sprites = m_snapshot->GetSprites();
+    return i < sprites.size() ? sprites[i] : m_snapshot->GetOverlay()[i - sprites.size()];
+}
+
+void SpriteBatch::Submit(SDL_Renderer* renderer)
+{
+    for (auto run = m_runs.begin(); run != m_runs.end(); ++run)
+    {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+        // Indices of a run point at its own vertices, which start at 4 * first
+        SDL_RenderGeometry(renderer, run->texture, &m_vertices[run->first * 4], run->count * 4,
+                           m_indices.data(), run->count * 6);
+#else
+        for (unsigned int i = run->first; i < run->first + run->count; ++i)
+            SDL_RenderCopy(renderer, run->texture, &GetSprite(i).source, &m_dests[i]);
+#endif
+    }
+}
+
+void SpriteBatch::Draw(SDL_Renderer* renderer, const RenderSnapshot& snapshot, unsigned long ticks)
+{
+    Build(snapshot, ticks);
+    Submit(renderer);
+}
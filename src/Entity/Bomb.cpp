@@ -1,5 +1,5 @@
 #include "Entity/Bomb.h"
-#include "Constants/TextureBombConstants.h"
+#include "Constants/TextureAtlas.h"
 
 #ifdef DEBUG_OUTPUT_BOMB
 #include <iostream>
@@ -7,13 +7,15 @@
 
 Bomb::Bomb(unsigned int fuse_duration,
            SDL_Texture* texture,
+           SystemTimer* system_timer,
            unsigned int x,
            unsigned int y,
            unsigned int bomb_size,
            unsigned int player_id,
            double intensity,
-           unsigned int damage)
-    :   m_timer(),
+           unsigned int damage,
+           unsigned int serial)
+    :   m_timer(system_timer),
         m_fuse_duration(fuse_duration),
         m_texture(texture),
         m_explode(false),
@@ -23,7 +25,8 @@ Bomb::Bomb(unsigned int fuse_duration,
         m_player_id(player_id),
         m_intensity(intensity),
         m_damage(damage),
-        m_phase_number(0)
+        m_phase_number(0),
+        m_serial(serial)
 {
     #ifdef DEBUG_OUTPUT_BOMB
     std::cout << "Bomb placed: X:" << m_x << " Y:" << m_y << " fuse:" << m_fuse_duration << " intesity:" << m_intensity << std::endl;
@@ -43,32 +46,62 @@ void Bomb::Update()
         m_explode = true;
     else
     {
-        m_phase_number =  m_timer.GetTimeElapsed() / (m_fuse_duration / TEXTURE_BOMB_COUNT); // Time elapsed / Phase length
+        m_phase_number =  m_timer.GetTimeElapsed() / (m_fuse_duration / ATLAS_BOMB_PHASES); // Time elapsed / Phase length
         #ifdef DEBUG_OUTPUT_BOMB
         std::cout << "Bomb: X:" << m_x << " Y:" << m_y << " Phase:" << m_phase_number << std::endl;
         #endif // DEBUG_OUTPUT_BOMB
     }
 }
 
+unsigned long Bomb::GetDetonationTime() const
+{
+    return m_timer.GetSystemTimer()->GetTimeElapsed() - m_timer.GetTimeElapsed() + m_fuse_duration;
+}
+
 bool Bomb::Explode() const
 {
     return m_explode;
 }
 
-void Bomb::Draw(SDL_Renderer* renderer) const
+void Bomb::Draw(RenderSnapshot& snapshot) const
 {
-    SDL_Rect SrcR;
+    // The phase reaches ATLAS_BOMB_PHASES at the very end of a fuse not divisible by it
+    unsigned int phase = m_phase_number < ATLAS_BOMB_PHASES ? m_phase_number : ATLAS_BOMB_PHASES - 1;
+    const SDL_Rect& SrcR = AtlasFrame(ATLAS_BOMB, 0, phase);
     SDL_Rect DestR;
 
-    SrcR.h = TEXTURE_BOMB_H;
-    SrcR.w = TEXTURE_BOMB_W;
-    SrcR.x = TEXTURE_BOMB_X + m_phase_number * TEXTURE_BOMB_OFFSET_X;
-    SrcR.y = TEXTURE_BOMB_Y + m_phase_number * TEXTURE_BOMB_OFFSET_Y;
-
     DestR.h = m_draw_size;
     DestR.w = m_draw_size;
     DestR.x = m_x - m_draw_size / 2;
     DestR.y = m_y - m_draw_size / 2;
 
-    SDL_RenderCopy(renderer, m_texture, &SrcR, &DestR);
+    snapshot.Copy(m_texture, SrcR, DestR);
+}
+
+void Bomb::SaveState(StateBuffer& state) const
+{
+    m_timer.SaveState(state);
+    state.Write(m_fuse_duration);
+    state.Write(m_explode);
+    state.Write(m_x);
+    state.Write(m_y);
+    state.Write(m_player_id);
+    state.Write(m_intensity);
+    state.Write(m_damage);
+    state.Write(m_phase_number);
+    state.Write(m_serial);
+}
+
+void Bomb::LoadState(StateBuffer& state)
+{
+    m_timer.LoadState(state);
+    state.Read(m_fuse_duration);
+    state.Read(m_explode);
+    state.Read(m_x);
+    state.Read(m_y);
+    state.Read(m_player_id);
+    state.Read(m_intensity);
+    state.Read(m_damage);
+    state.Read(m_phase_number);
+    state.Read(m_serial);
 }
@@ -0,0 +1,278 @@
+#include "Entity/EnemyBatch.h"
+#include "Manager/Map.h"
+#include "Manager/BombManager.h"
+#include "System/SystemTimer.h"
+#include "Constants/TextureEnemyConstants.h"
+#include "Constants/EnemyConstants.h"
+
+EnemyBatch::EnemyBatch(Kind kind, SDL_Texture* texture, unsigned int tile_size, SystemTimer* system_timer)
+    : m_kind(kind),
+      m_texture(texture),
+      m_system_timer(system_timer),
+      m_tile_size(tile_size),
+      m_move_speed(4 * tile_size/32) //speed according to 32px tile size
+{
+    switch(kind)
+    {
+        case ONE:
+            m_speed = 100; //timer speed
+            m_sprite = ATLAS_ENEMY_ONE;
+            m_rotation_const = ATLAS_ENEMY_ONE_PHASES;
+            m_size_w = TEXTURE_ENEMY_ONE_SIZE_W *tile_size/32;
+            m_size_h = TEXTURE_ENEMY_ONE_SIZE_H *tile_size/32; //size according to 32px tile size
+            break;
+        case TWO:
+            m_speed = 74; //timer speed
+            m_sprite = ATLAS_ENEMY_TWO;
+            m_rotation_const = ATLAS_ENEMY_TWO_PHASES;
+            m_size_w = TEXTURE_ENEMY_TWO_SIZE_W *tile_size/32;
+            m_size_h = TEXTURE_ENEMY_TWO_SIZE_H *tile_size/32; //size according to 32px tile size
+            break;
+        case THREE:
+            m_speed = 100; //timer speed
+            m_sprite = ATLAS_ENEMY_THREE;
+            m_rotation_const = ATLAS_ENEMY_THREE_PHASES;
+            m_size_w = TEXTURE_ENEMY_THREE_SIZE_W *tile_size/32;
+            m_size_h = TEXTURE_ENEMY_THREE_SIZE_H *tile_size/32; //size according to 32px tile size
+            break;
+    }
+}
+
+void EnemyBatch::Add(unsigned int x, unsigned int y, const Random& random)
+{
+    m_x.push_back(x);
+    m_y.push_back(y);
+    m_previous_x.push_back(x);
+    m_previous_y.push_back(y);
+    m_direction.push_back(RIGHT);
+    m_walk_len.push_back(0);
+    m_step_time.push_back(m_system_timer->GetTimeElapsed());
+    m_status.push_back(0);
+    m_chase.push_back(false);
+    m_dead.push_back(false);
+    m_random.push_back(random);
+    m_touch_mask.resize(Contact::MaskWords(m_x.size()));
+}
+
+void EnemyBatch::RemoveDead()
+{
+    for(unsigned int i = 0; i < m_x.size();)
+    {
+        if(!m_dead[i])
+        {
+            ++i;
+            continue;
+        }
+
+        m_x[i] = m_x.back(); m_x.pop_back();
+        m_y[i] = m_y.back(); m_y.pop_back();
+        m_previous_x[i] = m_previous_x.back(); m_previous_x.pop_back();
+        m_previous_y[i] = m_previous_y.back(); m_previous_y.pop_back();
+        m_direction[i] = m_direction.back(); m_direction.pop_back();
+        m_walk_len[i] = m_walk_len.back(); m_walk_len.pop_back();
+        m_step_time[i] = m_step_time.back(); m_step_time.pop_back();
+        m_status[i] = m_status.back(); m_status.pop_back();
+        m_chase[i] = m_chase.back(); m_chase.pop_back();
+        m_dead[i] = m_dead.back(); m_dead.pop_back();
+        m_random[i] = m_random.back(); m_random.pop_back();
+    }
+}
+
+void EnemyBatch::SaveState(StateBuffer& state) const
+{
+    state.WriteVector(m_x);
+    state.WriteVector(m_y);
+    state.WriteVector(m_previous_x);
+    state.WriteVector(m_previous_y);
+    state.WriteVector(m_direction);
+    state.WriteVector(m_walk_len);
+    state.WriteVector(m_step_time);
+    state.WriteVector(m_status);
+    state.WriteVector(m_chase);
+    state.WriteVector(m_dead);
+    state.WriteVector(m_random);
+}
+
+void EnemyBatch::LoadState(StateBuffer& state)
+{
+    state.ReadVector(m_x);
+    state.ReadVector(m_y);
+    state.ReadVector(m_previous_x);
+    state.ReadVector(m_previous_y);
+    state.ReadVector(m_direction);
+    state.ReadVector(m_walk_len);
+    state.ReadVector(m_step_time);
+    state.ReadVector(m_status);
+    state.ReadVector(m_chase);
+    state.ReadVector(m_dead);
+    state.ReadVector(m_random);
+    m_touch_mask.resize(Contact::MaskWords(m_x.size()));
+}
+
+void EnemyBatch::SavePositions()
+{
+    m_previous_x = m_x;
+    m_previous_y = m_y;
+}
+
+void EnemyBatch::Update(const DistanceField& field, Relay* relay, unsigned int first, unsigned int count)
+{
+    if(m_kind == THREE)
+        Chase(field, relay, first, first + count);
+    Wander(first, first + count);
+    Move(relay, first, first + count);
+}
+
+Contact::Box EnemyBatch::TouchBox(const Player& player, unsigned int tile_size)
+{
+    //Setting coordinates for better collision
+    Contact::Box box;
+    box.left = player.GetX() + tile_size/6;
+    box.top = player.GetY() + tile_size/6;
+    box.right = box.left + player.GetSizeW() - tile_size/3;
+    box.bottom = box.top + player.GetSizeH() - tile_size/4;
+    //----------------------------------------
+    return box;
+}
+
+bool EnemyBatch::Touches(const Contact::Box& box, unsigned int first, unsigned int count)
+{
+    // Ranges start on a word of the mask, so ranges never write the same word
+    return Contact::Corners(box, m_x.data() + first, m_y.data() + first, m_size_w, m_size_h,
+                            count, m_touch_mask.data() + first/32);
+}
+
+void EnemyBatch::Wander(unsigned int first, unsigned int end)
+{
+    for(unsigned int i = first; i < end; ++i)
+    {
+        if(m_walk_len[i] <= 0 && !m_chase[i])
+        {
+            m_walk_len[i] = m_random[i].Below(5) + 10;
+            m_direction[i] = m_random[i].Below(4);
+        }
+    }
+}
+
+void EnemyBatch::Chase(const DistanceField& field, Relay* relay, unsigned int first, unsigned int end)
+{
+    for(unsigned int i = first; i < end; ++i)
+    {
+        // Tile under the center of the enemy
+        unsigned int row = (m_y[i] + m_size_h/2) / m_tile_size;
+        unsigned int column = (m_x[i] + m_size_w/2) / m_tile_size;
+
+        m_chase[i] = field.GetDistance(row, column) <= ENEMY_THREE_CHASE_DISTANCE;
+        if(!m_chase[i])
+            continue;
+
+        DistanceField::Step step = field.GetStep(row, column);
+        if(step == DistanceField::NONE)
+            continue; // already on the tile of the player
+
+        if(DirectionCheck(i, (Direction)step, relay))
+        {
+            m_direction[i] = step;
+            continue;
+        }
+
+        // Walls are in the way until the enemy is lined up with its tile
+        if(step == DistanceField::UP || step == DistanceField::DOWN)
+            m_direction[i] = m_x[i] < column*m_tile_size ? RIGHT : LEFT;
+        else
+            m_direction[i] = m_y[i] < row*m_tile_size ? DOWN : UP;
+    }
+}
+
+void EnemyBatch::Move(Relay* relay, unsigned int first, unsigned int end)
+{
+    const ThreatMap& threats = relay->GetBombManager()->GetThreatMap();
+    unsigned long now = m_system_timer->GetTimeElapsed();
+    for(unsigned int i = first; i < end; ++i)
+    {
+        if(now - m_step_time[i] <= m_speed)
+            continue;
+
+        m_walk_len[i]--;
+        if(!Safe(i, (Direction)m_direction[i], threats, now))
+            m_walk_len[i] = 0; // wanderers choose another direction
+        else if(DirectionCheck(i, (Direction)m_direction[i], relay))
+        {
+            switch(m_direction[i])
+            {
+                case LEFT:
+                    m_x[i] -= m_move_speed;
+                    break;
+                case RIGHT:
+                    m_x[i] += m_move_speed;
+                    break;
+                case UP:
+                    m_y[i] -= m_move_speed;
+                    break;
+                case DOWN:
+                    m_y[i] += m_move_speed;
+                    break;
+            }
+        }
+        if(++m_status[i] >= m_rotation_const)
+            m_status[i] = 0;
+        m_step_time[i] = now;
+    }
+}
+
+bool EnemyBatch::Safe(unsigned int i, Direction d, const ThreatMap& threats, unsigned long now) const
+{
+    unsigned int x = m_x[i] + m_size_w/2;
+    unsigned int y = m_y[i] + m_size_h/2;
+    unsigned int next_x = x + (d == RIGHT ? m_move_speed : 0) - (d == LEFT ? m_move_speed : 0);
+    unsigned int next_y = y + (d == DOWN ? m_move_speed : 0) - (d == UP ? m_move_speed : 0);
+    if(next_x / m_tile_size == x / m_tile_size && next_y / m_tile_size == y / m_tile_size)
+        return true;
+
+    unsigned long here = threats.TimeUntilLethal(y / m_tile_size, x / m_tile_size, now);
+    unsigned long there = threats.TimeUntilLethal(next_y / m_tile_size, next_x / m_tile_size, now);
+    return there > ENEMY_THREAT_HORIZON || there >= here;
+}
+
+bool EnemyBatch::DirectionCheck(unsigned int i, Direction d, Relay* relay) const
+{
+    int dx = 0;
+    int dy = 0;
+    switch(d)
+    {
+        case LEFT:
+            dx = -(int)m_move_speed;
+            break;
+        case RIGHT:
+            dx = m_move_speed;
+            break;
+        case UP:
+            dy = -(int)m_move_speed;
+            break;
+        case DOWN:
+            dy = m_move_speed;
+            break;
+    }
+    return relay->GetMap()->CanMove(m_x[i], m_y[i], m_size_w, m_size_h, dx, dy);
+}
+
+void EnemyBatch::Draw(RenderSnapshot& snapshot) const
+{
+    unsigned int n = m_x.size();
+    for(unsigned int i = 0; i < n; ++i)
+    {
+        Draw(snapshot, i);
+    }
+}
+
+void EnemyBatch::Draw(RenderSnapshot& snapshot, unsigned int i) const
+{
+    const SDL_Rect& SrcR = AtlasFrame(m_sprite, 0, m_status[i]);
+    SDL_Rect DestR;
+    DestR.w = m_size_w;
+    DestR.h = m_size_h;
+    DestR.x = m_x[i];
+    DestR.y = m_y[i];
+
+    snapshot.Move(m_texture, SrcR, DestR, m_previous_x[i], m_previous_y[i]);
+}
@@ -1,13 +1,14 @@
 #include "Entity/Explosion.h"
-#include "Constants/TextureExplosionConstants.h"
+#include "Constants/TextureAtlas.h"
 
 Explosion::Explosion(unsigned int duration,
                      unsigned int x_center,
                      unsigned int y_center,
                      double intensity,
                      unsigned int tile_size,
-                     SDL_Texture* texture)
-    :   m_timer(),
+                     SDL_Texture* texture,
+                     SystemTimer* system_timer)
+    :   m_timer(system_timer),
         m_duration(duration),
         m_exploding(true),
         m_x_center(x_center),
@@ -28,8 +29,8 @@ void Explosion::Update()
         m_exploding = false;
     else
     {
-        m_phase_number = m_timer.GetTimeElapsed() / (m_duration / TEXTURE_EXPLOSION_COUNT); // Time elapsed / Phase length
-        m_phase_number = min2(m_phase_number, TEXTURE_EXPLOSION_COUNT - 1); // stops overflow
+        m_phase_number = m_timer.GetTimeElapsed() / (m_duration / ATLAS_EXPLOSION_PHASES); // Time elapsed / Phase length
+        m_phase_number = min2(m_phase_number, ATLAS_EXPLOSION_PHASES - 1); // stops overflow
         #ifdef DEBUG_OUTPUT
         std::cout << "Explosion: X:" << m_x_center << " Y:" << m_y_center << " Phase:" << m_phase_number << std::endl;
         #endif // DEBUG_OUTPUT
@@ -41,30 +42,39 @@ bool Explosion::IsExploding() const
     return m_exploding;
 }
 
-void Explosion::Draw(SDL_Renderer* renderer) const
+void Explosion::Draw(RenderSnapshot& snapshot) const
 {
-    SDL_Rect SrcR;
+    const SDL_Rect& SrcR = AtlasFrame(ATLAS_EXPLOSION, 0, m_phase_number);
     SDL_Rect DestR;
     unsigned int explosion_size = m_tile_size * m_intensity;
-    unsigned int number_in_line = m_phase_number % TEXTURE_EXPLOSION_LINE_COUNT;
-    unsigned int line_number = m_phase_number / TEXTURE_EXPLOSION_LINE_COUNT;
-
-    SrcR.h = TEXTURE_EXPLOSION_H;
-    SrcR.w = TEXTURE_EXPLOSION_W;
-    SrcR.x = TEXTURE_EXPLOSION_X
-        + TEXTURE_EXPLOSION_LINE_OFFSET_X * line_number
-        + TEXTURE_EXPLOSION_OFFSET_X * number_in_line
-        ;
-    SrcR.y = TEXTURE_EXPLOSION_Y
-        + TEXTURE_EXPLOSION_LINE_OFFSET_Y * line_number
-        + TEXTURE_EXPLOSION_OFFSET_Y * number_in_line
-        ;
 
     DestR.h = explosion_size;
     DestR.w = explosion_size;
     DestR.x = m_x_center - explosion_size / 2;
     DestR.y = m_y_center - explosion_size / 2;
 
-    SDL_RenderCopy(renderer, m_texture, &SrcR, &DestR);
+    snapshot.Copy(m_texture, SrcR, DestR);
 }
 
+
+void Explosion::SaveState(StateBuffer& state) const
+{
+    m_timer.SaveState(state);
+    state.Write(m_duration);
+    state.Write(m_exploding);
+    state.Write(m_x_center);
+    state.Write(m_y_center);
+    state.Write(m_intensity);
+    state.Write(m_phase_number);
+}
+
+void Explosion::LoadState(StateBuffer& state)
+{
+    m_timer.LoadState(state);
+    state.Read(m_duration);
+    state.Read(m_exploding);
+    state.Read(m_x_center);
+    state.Read(m_y_center);
+    state.Read(m_intensity);
+    state.Read(m_phase_number);
+}
@@ -1,28 +1,30 @@
 #include "Entity/MapObject.h"
-#include "Constants/TextureMapObjectConstants.h"
+#include "Constants/TextureAtlas.h"
 
-MapObject::MapObject(Tile id, SDL_Texture *texture, unsigned int kind)
-    : m_id(id), m_texture(texture), m_kind(kind)
+MapObject::MapObject(Tile id, unsigned int kind)
+    : m_id(id), m_kind(kind), m_integrity(S_MAX_INTEGRITY)
 {
 }
 
-void MapObject::Draw(SDL_Renderer* renderer, const SDL_Rect *DestR)
+void MapObject::DecreaseIntegrity(int value)
+{
+    int integrity = m_integrity - value;
+    if (integrity < 0)
+        integrity = 0;
+    m_integrity = integrity;
+}
+
+SDL_Rect MapObject::GetSource() const
 {
-    SDL_Rect SrcR;
     if (m_id == EMPTY)
+        return AtlasFrame(ATLAS_MAP_EMPTY, m_kind, 0);
+    else if (m_id == DESTRUCTIBLE_WALL)
     {
-        SrcR.h = TEXTURE_MAP_EMPTY_H;
-        SrcR.w = TEXTURE_MAP_EMPTY_W;
-        SrcR.x = TEXTURE_MAP_EMPTY_X + TEXTURE_MAP_EMPTY_KIND_OFFSET_X * m_kind;
-        SrcR.y = TEXTURE_MAP_EMPTY_Y + TEXTURE_MAP_EMPTY_KIND_OFFSET_Y * m_kind;
+        unsigned int integrity_level = (S_MAX_INTEGRITY-m_integrity) / (S_MAX_INTEGRITY / ATLAS_MAP_DESTRUCTIBLE_PHASES);
+        if (integrity_level > ATLAS_MAP_DESTRUCTIBLE_PHASES - 1)
+            integrity_level = ATLAS_MAP_DESTRUCTIBLE_PHASES - 1;
+        return AtlasFrame(ATLAS_MAP_DESTRUCTIBLE, m_kind, integrity_level);
     }
     else //if (m_id == INDESTRUCTIBLE_WALL)
-    {
-        SrcR.h = TEXTURE_MAP_INDESTRUCTIBLE_H;
-        SrcR.w = TEXTURE_MAP_INDESTRUCTIBLE_W;
-        SrcR.x = TEXTURE_MAP_INDESTRUCTIBLE_X + TEXTURE_MAP_INDESTRUCTIBLE_KIND_OFFSET_X * m_kind;
-        SrcR.y = TEXTURE_MAP_INDESTRUCTIBLE_Y + TEXTURE_MAP_INDESTRUCTIBLE_KIND_OFFSET_Y * m_kind;
-    }
-
-    SDL_RenderCopy(renderer, m_texture, &SrcR, DestR);
+        return AtlasFrame(ATLAS_MAP_INDESTRUCTIBLE, m_kind, 0);
 }
@@ -2,18 +2,22 @@
 #include "Manager/Map.h"
 #include "Manager/BombManager.h"
 #include "Constants/TexturePlayerConstants.h"
+#include "Constants/TextureAtlas.h"
 #include "Constants/PlayerConstants.h"
 #include "Manager/PickUpManager.h"
 #include "Entity/PickUp.h"
 #include <iostream>
 
 Player::Player(SDL_Texture* tex, unsigned int tile_size, Relay *relay, unsigned int player_id, unsigned int val_x, unsigned int val_y)
-                    :m_keyboard_input(KeyboardInput::Instance())
+                    :m_timer(relay->GetSystemTimer()),
+                     m_keyboard_input(relay->GetKeyboardInput())
 {
     this->m_x = val_x*tile_size;
     this->m_y = val_y*tile_size;
     this->m_input_x = m_x;
     this->m_input_y = m_y;
+    this->m_previous_x = m_x;
+    this->m_previous_y = m_y;
 
     this->m_tex = tex;
     this->m_direction = DOWN;
@@ -40,10 +44,13 @@ bool Player::Touch(unsigned int pick_up_x, unsigned int pick_up_y)
 
 void Player::Update()
 {
+    m_previous_x = m_x;
+    m_previous_y = m_y;
+
     //TOUCH with pick_up &pick_up
-    for(PickUpManager::Iterator it(m_relay->GetPickUpManager()); !it.Finished() ; ++it)
+    m_relay->GetPickUpManager()->TouchPickUps(m_x, m_y, m_player_size_w, m_player_size_h, [&](PickUp* found)
     {
-        PickUp& pick_up = it.GetPickUp();
+        PickUp& pick_up = *found;
         unsigned int pick_up_x = pick_up.GetX();
         unsigned int pick_up_y = pick_up.GetY();
         bool picked_up_pick_up = false;
@@ -193,7 +200,7 @@ void Player::Update()
                     break;
             }
         }
-    }
+    });
 
     //Place bomb
     if(m_keyboard_input->IsKeyOn(m_bomb_button))
@@ -242,9 +249,9 @@ void Player::PlaceBomb()
 {
     if(m_bomb_temp_num < m_bomb_num)
     {
-		m_relay->GetBombManager()->MakeBomb(5000,m_x+m_player_size_w/2,m_y+m_player_size_h/2,
-                                      m_player_id,m_bomb_intensity, m_bomb_damage);
-        m_bomb_temp_num++;
+		if(m_relay->GetBombManager()->MakeBomb(5000,m_x+m_player_size_w/2,m_y+m_player_size_h/2,
+                                               m_player_id,m_bomb_intensity, m_bomb_damage))
+            m_bomb_temp_num++;
     }
 }
 
@@ -253,134 +260,40 @@ void Player::DecreaseTempBombNumber()
     m_bomb_temp_num--;
 }
 
-void Player::Draw(SDL_Renderer *renderer)
+void Player::Draw(RenderSnapshot& snapshot) const
 {
-    SDL_Rect SrcR;
+    // Frames of the second player follow the ones of the first in the atlas
+    const SDL_Rect& SrcR = AtlasFrame((AtlasSprite)(ATLAS_PLAYER_ONE + m_player_id),
+                                      m_direction, m_status % m_rotation_const);
     SDL_Rect DestR;
 
-    SrcR.y = TEXTURE_PLAYER_Y;
-    SrcR.w = TEXTURE_PLAYER_SOURCE_W;
-    SrcR.h = TEXTURE_PLAYER_SOURCE_H;
-
-    unsigned int source_texture_x = m_player_id * TEXTURE_PLAYER_MAIN_SOURCE_OFFSET
-                                                    + TEXTURE_PLAYER_MINI_SOURCE_OFFSET; //Calculates which set of images
-
-    switch(m_direction)
-    {
-    case UP:
-        //POSTION OF BOMBERMAN
-        if(m_status % m_rotation_const == 0)
-        {
-            SrcR.x = source_texture_x + 3*TEXTURE_PLAYER_TEXTURE_OFFSET;
-        }
-        if(m_status % m_rotation_const == 1)
-        {
-            SrcR.x = source_texture_x + 4*TEXTURE_PLAYER_TEXTURE_OFFSET;
-        }
-        if(m_status % m_rotation_const == 2)
-        {
-            SrcR.x = source_texture_x + 5*TEXTURE_PLAYER_TEXTURE_OFFSET;
-        }
-        break;
-
-    case DOWN:
-        //POSTION OF BOMBERMAN
-        if(m_status % m_rotation_const == 0)
-        {
-            SrcR.x = source_texture_x;
-
-        }
-        if(m_status % m_rotation_const == 1)
-        {
-            SrcR.x = source_texture_x + TEXTURE_PLAYER_TEXTURE_OFFSET;
-        }
-        if(m_status % m_rotation_const == 2)
-        {
-            SrcR.x = source_texture_x + 2*TEXTURE_PLAYER_TEXTURE_OFFSET;
-        }
-        break;
-
-    case LEFT:
-        //POSTION OF BOMBERMAN
-        if(m_status % m_rotation_const == 0)
-        {
-            SrcR.x = source_texture_x + 6*TEXTURE_PLAYER_TEXTURE_OFFSET;
-        }
-        if(m_status % m_rotation_const == 1)
-        {
-            SrcR.x = source_texture_x + 7*TEXTURE_PLAYER_TEXTURE_OFFSET;
-        }
-        if(m_status % m_rotation_const == 2)
-        {
-            SrcR.x = source_texture_x + 8*TEXTURE_PLAYER_TEXTURE_OFFSET;
-        }
-        break;
-
-    case RIGHT:
-        //POSTION OF BOMBERMAN
-        if(m_status % m_rotation_const == 0)
-        {
-            SrcR.x = source_texture_x + 9*TEXTURE_PLAYER_TEXTURE_OFFSET;
-        }
-        if(m_status % m_rotation_const == 1)
-        {
-            SrcR.x = source_texture_x + 10*TEXTURE_PLAYER_TEXTURE_OFFSET;
-        }
-        if(m_status % m_rotation_const == 2)
-        {
-            SrcR.x = source_texture_x + 11*TEXTURE_PLAYER_TEXTURE_OFFSET;
-        }
-        break;
-    }
-
     DestR.x = m_x;
     DestR.y = m_y;
     DestR.w = m_player_size_w;
     DestR.h = m_player_size_h;
 
-    SDL_RenderCopy(renderer, m_tex, &SrcR, &DestR);
+    snapshot.Move(m_tex, SrcR, DestR, m_previous_x, m_previous_y);
 }
 
 void Player::PlayerMove(int x, int y)
 {
-    unsigned int field_size = m_tile_size;
-
-    if(x == 1) // MOVE RIGHT ------------
-    {
+    if(x == 1)
         m_direction = RIGHT;
-        if( m_relay->GetMap()->Walkable( m_y/field_size, (m_x+m_player_size_w+m_move_speed)/field_size )
-                && m_relay->GetMap()->Walkable( (m_y+m_player_size_h)/field_size, (m_x+m_player_size_w+m_move_speed)/field_size) )
-        {
-            m_x = m_x + m_move_speed;
-        }
+    else if(x == -1)
+        m_direction = LEFT;
+    else if(y == 1)
+        m_direction = DOWN;
+    else if(y == -1)
+        m_direction = UP;
+
+    int dx = x*(int)m_move_speed;
+    int dy = y*(int)m_move_speed;
+    if(m_relay->GetMap()->CanMove(m_x, m_y, m_player_size_w, m_player_size_h, dx, dy))
+    {
+        m_x = m_x + dx;
+        m_y = m_y + dy;
     }
-    else if (x == -1) // MOVE LEFT ------------
-        {
-            m_direction = LEFT;
-            if(m_relay->GetMap()->Walkable( m_y/field_size, (m_x-m_move_speed)/field_size )
-                    && m_relay->GetMap()->Walkable( (m_y+m_player_size_h)/field_size, (m_x-m_move_speed)/field_size) )
-            {
-                m_x = m_x - m_move_speed;
-            }
-        }
-        else if(y == 1) // MOVE DOWN ------------
-            {
-                m_direction = DOWN;
-                if(m_relay->GetMap()->Walkable( (m_y+m_player_size_h+m_move_speed)/field_size, m_x/field_size )
-                    && m_relay->GetMap()->Walkable( (m_y+m_player_size_h+m_move_speed)/field_size, (m_x+m_player_size_w)/field_size ) )
-                {
-                    m_y = m_y + m_move_speed;
-                }
-            }
-            else if(y == -1) // MOVE UP ------------
-                {
-                    m_direction = UP;
-                    if(m_relay->GetMap()->Walkable( (m_y - m_move_speed)/field_size, m_x/field_size )
-                        &&  m_relay->GetMap()->Walkable( (m_y - m_move_speed)/field_size, (m_x+m_player_size_w)/field_size) )
-                    {
-                        m_y = m_y - m_move_speed;
-                    }
-                }
+
     m_status++;
     if(m_status >= m_rotation_const)
         m_status = 0;
@@ -397,6 +310,7 @@ void Player::SetX(int val)
         m_x = val;
     else
         m_x = m_input_x;
+    m_previous_x = m_x;
 }
 
 unsigned int Player::GetY() const
@@ -410,6 +324,7 @@ void Player::SetY(int val)
         m_y = val;
     else
         m_y = m_input_y;
+    m_previous_y = m_y;
 }
 
 unsigned int Player::GetSizeW() const
@@ -477,6 +392,15 @@ void Player::SetKeycodes(SDL_Keycode up, SDL_Keycode down, SDL_Keycode left, SDL
     m_bomb_button = bomb_button;
 }
 
+void Player::GetKeycodes(SDL_Keycode& up, SDL_Keycode& down, SDL_Keycode& left, SDL_Keycode& right, SDL_Keycode& bomb_button) const
+{
+    up = m_up;
+    down = m_down;
+    left = m_left;
+    right = m_right;
+    bomb_button = m_bomb_button;
+}
+
 
 unsigned int Player::GetAlive() const
 {
@@ -515,3 +439,49 @@ bool Player::IsAlive() const
     else
         return false;
 }
+
+void Player::SaveState(StateBuffer& state) const
+{
+    state.Write(m_direction);
+    state.Write(m_bomb_ready);
+    state.Write(m_level_completed);
+    state.Write(m_status);
+    m_timer.SaveState(state);
+    state.Write(m_bomb_num);
+    state.Write(m_bomb_temp_num);
+    state.Write(m_bomb_intensity);
+    state.Write(m_bomb_damage);
+    state.Write(m_input_x);
+    state.Write(m_input_y);
+    state.Write(m_lives);
+    state.Write(m_alive);
+    state.Write(m_health);
+    state.Write(m_speed);
+    state.Write(m_x);
+    state.Write(m_y);
+    state.Write(m_previous_x);
+    state.Write(m_previous_y);
+}
+
+void Player::LoadState(StateBuffer& state)
+{
+    state.Read(m_direction);
+    state.Read(m_bomb_ready);
+    state.Read(m_level_completed);
+    state.Read(m_status);
+    m_timer.LoadState(state);
+    state.Read(m_bomb_num);
+    state.Read(m_bomb_temp_num);
+    state.Read(m_bomb_intensity);
+    state.Read(m_bomb_damage);
+    state.Read(m_input_x);
+    state.Read(m_input_y);
+    state.Read(m_lives);
+    state.Read(m_alive);
+    state.Read(m_health);
+    state.Read(m_speed);
+    state.Read(m_x);
+    state.Read(m_y);
+    state.Read(m_previous_x);
+    state.Read(m_previous_y);
+}
@@ -1,83 +1,175 @@
 #include "Manager/BombManager.h"
 
-#ifdef DEBUG_OUTPUT_BOMB
-#include <iostream>
-#endif // DEBUG_OUTPUT_BOMB
-
-#include "Destroyer/WallDestroyer.h"
 #include "Manager/ExplosionManager.h"
 #include "Manager/EnemyManager.h"
 #include "Manager/PlayerManager.h"
 #include "Constants/ResourcesConstants.h"
 #include "Constants/TextureExplosionConstants.h"
 #include "Constants/TextureBombConstants.h"
+#include "Constants/PoolConstants.h"
+#include <algorithm>
 
 BombManager::BombManager(SDL_Texture* texture,
                          unsigned int tile_size,
                          Relay* relay)
     : DisplayElement(texture),
+      m_bombs(POOL_BOMB_CAPACITY),
       m_bomb_size(tile_size * BOMB_SIZE_RELATIVE_TO_TILE_SIZE),
       m_tile_size(tile_size),
-      m_relay(relay)
+      m_relay(relay),
+      m_grid(tile_size, 0),
+      m_next_serial(0),
+      m_wall_destroyer(tile_size),
+      m_threats(relay->GetMap()->GetHeight(), relay->GetMap()->GetWidth(), tile_size, POOL_BOMB_CAPACITY)
 {
     std::string path_music = RESOURCES_BASE_PATH + RESOURCES_EXPLOSION_LOAD;
     m_bomb_sound_effect = Mix_LoadWAV(path_music.c_str());
+    m_detonations.reserve(POOL_BOMB_CAPACITY);
+    m_caught.reserve(POOL_BOMB_CAPACITY);
+    m_blasts.reserve(POOL_BOMB_CAPACITY);
 }
 
 BombManager::~BombManager()
 {
     Mix_FreeChunk(m_bomb_sound_effect);
-
-    for(auto i = m_bombs.begin(); i != m_bombs.end(); ++i)
-    {
-        delete (*i);
-        #ifdef DEBUG_OUTPUT_BOMB
-        std::cout << "Bomb deleted" << std::endl;
-        #endif // DEBUG_OUTPUT_BOMB
-    }
 }
 
-void BombManager::AddBomb(Bomb *bomb)
-{
-    m_bombs.push_back(bomb);
-}
-
-void BombManager::MakeBomb(unsigned int fuse_duration,
+bool BombManager::MakeBomb(unsigned int fuse_duration,
                            unsigned int x,
                            unsigned int y,
                            unsigned int player_id,
                            double intensity,
                            unsigned int damage)
 {
-    Bomb* b = new Bomb(fuse_duration,m_texture,x,y,m_bomb_size,player_id,intensity,damage);
-    AddBomb(b);
+    Bomb* b = m_bombs.Make(fuse_duration,m_texture,m_relay->GetSystemTimer(),x,y,m_bomb_size,player_id,intensity,damage,m_next_serial);
+    if(b == nullptr)
+        return false;
+    m_next_serial++;
+    m_grid.Insert(b, b->GetX(), b->GetY());
+    m_threats.Add(b, m_relay->GetMap());
+    return true;
 }
 
 void BombManager::Update()
 {
-    for(auto i = m_bombs.begin(); i != m_bombs.end();)
+    m_detonations.clear();
+    for(auto i = m_bombs.begin(); i != m_bombs.end(); ++i)
     {
         (*i)->Update();
         if((*i)->Explode())
+            m_detonations.push_back(*i);
+    }
+
+    if(m_detonations.empty())
+        return;
+
+    // Bombs caught in a blast are queued as well and may set off further bombs.
+    // The order of a grid bucket depends on how the grid was filled, which is
+    // not the same after LoadState(), so bombs sharing a tile are queued in
+    // the order they were placed.
+    m_blasts.clear();
+    for(std::size_t n = 0; n < m_detonations.size(); ++n)
+    {
+        Bomb* bomb = m_detonations[n];
+        m_grid.Remove(bomb, bomb->GetX(), bomb->GetY());
+        m_blasts.push_back({bomb->GetX(), bomb->GetY(), bomb->GetIntensity()});
+
+        const std::vector<WallDestroyer::Position>& tiles =
+            m_wall_destroyer.Explode(m_relay->GetMap(), bomb->GetX(), bomb->GetY(), bomb->GetIntensity(), bomb->GetDamage());
+        for(auto tile = tiles.begin(); tile != tiles.end(); ++tile)
+        {
+            m_caught.clear();
+            m_grid.Query(tile->col * m_tile_size, tile->row * m_tile_size, m_tile_size - 1, m_tile_size - 1, [&](Bomb* other)
+            {
+                if(!other->Explode())
+                    m_caught.push_back(other);
+            });
+            std::sort(m_caught.begin(), m_caught.end(), [](const Bomb* a, const Bomb* b)
+            {
+                return a->GetSerial() < b->GetSerial();
+            });
+            for(auto other = m_caught.begin(); other != m_caught.end(); ++other)
+            {
+                (*other)->Detonate();
+                m_detonations.push_back(*other);
+            }
+        }
+    }
+
+    Mix_PlayChannel(-1, m_bomb_sound_effect, 0);
+    m_relay->GetExplosionManager()->MakeExplosions(EXPLOSION_ANIMATION_LENGTH, m_blasts);
+    m_relay->GetEnemyManager()->KillEnemies(m_blasts);
+    m_relay->GetPlayerManager()->KillPlayer(m_blasts);
+
+    // Removing a bomb moves the last one into its place
+    for(unsigned int i = 0; i < m_bombs.GetSize();)
+    {
+        Bomb* bomb = m_bombs[i];
+        if(bomb->Explode())
         {
-            Mix_PlayChannel(-1, m_bomb_sound_effect, 0);
-            m_relay->GetExplosionManager()->MakeExplosion(EXPLOSION_ANIMATION_LENGTH, (*i)->GetX(), (*i)->GetY(), (*i)->GetIntensity());
-            WallDestroyer wd(m_relay->GetMap(), (*i)->GetX(), (*i)->GetY(), m_tile_size, (*i)->GetIntensity(), (*i)->GetDamage());
-            m_relay->GetEnemyManager()->KillEnemies((*i)->GetX(), (*i)->GetY(), (*i)->GetIntensity());
-            m_relay->GetPlayerManager()->KillPlayer((*i)->GetX(), (*i)->GetY(), (*i)->GetIntensity());
-            m_relay->GetPlayerManager()->GetPlayerById((*i)->GetPlayerId())->DecreaseTempBombNumber();
-            delete (*i);
-            i = m_bombs.erase(i);
+            m_relay->GetPlayerManager()->GetPlayerById(bomb->GetPlayerId())->DecreaseTempBombNumber();
+            m_threats.Remove(bomb);
+            m_bombs.Destroy(bomb);
         }
         else
             ++i;
     }
+    m_threats.Refresh(m_relay->GetMap());
+}
+
+void BombManager::Draw(RenderSnapshot& snapshot) const
+{
+    if(snapshot.HasView())
+    {
+        const SDL_Rect& area = snapshot.GetArea();
+        m_grid.Query(area.x, area.y, area.w, area.h, [&](Bomb* bomb)
+        {
+            bomb->Draw(snapshot);
+        });
+        return;
+    }
+    for(auto i = m_bombs.begin(); i != m_bombs.end(); ++i)
+    {
+        (*i)->Draw(snapshot);
+    }
+}
+
+void BombManager::SaveState(StateBuffer& state) const
+{
+    state.Write(m_next_serial);
+    state.Write(m_bombs.GetSize());
+    for(auto i = m_bombs.begin(); i != m_bombs.end(); ++i)
+    {
+        (*i)->SaveState(state);
+    }
+}
+
+void BombManager::LoadState(StateBuffer& state)
+{
+    m_bombs.Clear();
+    m_grid.Clear();
+    m_threats.Clear();
+
+    state.Read(m_next_serial);
+    unsigned int count = 0;
+    state.Read(count);
+    for(unsigned int i = 0; i < count && !state.Failed(); ++i)
+    {
+        Bomb* bomb = m_bombs.Make(0,m_texture,m_relay->GetSystemTimer(),0,0,m_bomb_size,0);
+        if(bomb == nullptr)
+            break;
+        bomb->LoadState(state);
+        m_grid.Insert(bomb, bomb->GetX(), bomb->GetY());
+        m_threats.Add(bomb, m_relay->GetMap());
+    }
 }
 
-void BombManager::Draw(SDL_Renderer* renderer) const
+void BombManager::TakeSnapshot(WorldSnapshot& snapshot) const
 {
     for(auto i = m_bombs.begin(); i != m_bombs.end(); ++i)
     {
-        (*i)->Draw(renderer);
+        uint32_t tile = (*i)->GetY() / snapshot.tile_size * snapshot.width + (*i)->GetX() / snapshot.tile_size;
+        snapshot.bombs.push_back({tile, (uint8_t)(*i)->GetPlayerId()});
     }
+    std::sort(snapshot.bombs.begin(), snapshot.bombs.end());
 }
@@ -1,19 +1,41 @@
 #include "Manager/EnemyManager.h"
 #include "Manager/PlayerManager.h"
+#include "Manager/Map.h"
 #include <fstream>
 #include <iostream>
+#include <cstdlib>
+#include <algorithm>
 #include "Entity/Player.h"
 #include "Destroyer/Destroyer.h"
-#include "Entity/EnemyOne.h"
-#include "Entity/EnemyTwo.h"
-#include "Entity/EnemyThree.h"
+#include "Constants/SimulationConstants.h"
+#include "Constants/EnemyConstants.h"
+#include "Utility/ThreadPool.h"
 
-EnemyManager::EnemyManager(std::string path_to_file, SDL_Texture* texture, unsigned int tile_size, Relay *relay)
-    : DisplayElement(texture)
+// One bucket per tile, so the enemies in the view are found without looking at most others
+static unsigned int GridBuckets(const Map* map)
+{
+    unsigned int buckets = ENEMY_GRID_BUCKETS_MIN;
+    while(buckets < map->GetWidth() * map->GetHeight() && buckets < ENEMY_GRID_BUCKETS_MAX)
+        buckets *= 2;
+    return buckets;
+}
+
+EnemyManager::EnemyManager(std::string path_to_file, SDL_Texture* texture, unsigned int tile_size, Relay *relay, const Random& random)
+    : DisplayElement(texture),
+      m_grid(tile_size, tile_size, GridBuckets(relay->GetMap())),
+      m_field(relay->GetMap()->GetHeight(), relay->GetMap()->GetWidth()),
+      m_random(random),
+      m_made(0)
 {
     m_texture = texture;
     m_tile_size = tile_size;
     m_relay = relay;
+    m_goals.reserve(8);
+
+    m_batches.reserve(3);
+    m_batches.emplace_back(EnemyBatch::ONE, texture, tile_size, relay->GetSystemTimer());
+    m_batches.emplace_back(EnemyBatch::TWO, texture, tile_size, relay->GetSystemTimer());
+    m_batches.emplace_back(EnemyBatch::THREE, texture, tile_size, relay->GetSystemTimer());
 
     std::fstream fs;
     fs.open (path_to_file, std::fstream::in);
@@ -47,66 +69,199 @@ EnemyManager::EnemyManager(std::string path_to_file, SDL_Texture* texture, unsig
     }
 
     fs.close();
+    RebuildGrid();
+
+    // Steps only reuse this memory, enemies are never added afterwards
+    m_chunks.reserve(m_enemies_numb/ENEMY_PARALLEL_CHUNK + m_batches.size());
+    m_players.reserve(8);
+    m_boxes.reserve(8);
+    m_touched.reserve(m_chunks.capacity() * 8);
 }
 
 EnemyManager::~EnemyManager()
 {
-    for(auto i = m_enemies.begin(); i != m_enemies.end(); ++i)
+}
+
+void EnemyManager::KillEnemies(const std::vector<BlastArea>& blasts)
+{
+    bool killed = false;
+    for(auto blast = blasts.begin(); blast != blasts.end(); ++blast)
+    {
+        int reach = m_tile_size * blast->intensity / 2;
+        m_grid.Query((int)blast->x - reach, (int)blast->y - reach, 2*reach, 2*reach, [&](unsigned int handle)
+        {
+            EnemyBatch& batch = m_batches[handle >> 24];
+            unsigned int i = handle & 0xFFFFFF;
+            if(Destroyer::Reaches(batch.GetX(i), batch.GetY(i), batch.GetSizeW(), batch.GetSizeH(),
+                                  blast->x, blast->y, m_tile_size, blast->intensity))
+            {
+                batch.Kill(i);
+                killed = true;
+            }
+        });
+    }
+
+    if(!killed)
+        return;
+
+    for(auto batch = m_batches.begin(); batch != m_batches.end(); ++batch)
+    {
+        batch->RemoveDead();
+    }
+    RebuildGrid();
+}
+
+void EnemyManager::MakeEnemyOne(unsigned int x, unsigned int y)
+{
+    m_batches[EnemyBatch::ONE].Add(x*m_tile_size, y*m_tile_size, m_random.Derive(RANDOM_STREAM_ENEMIES + m_made++));
+}
+
+void EnemyManager::MakeEnemyTwo(unsigned int x, unsigned int y)
+{
+    m_batches[EnemyBatch::TWO].Add(x*m_tile_size, y*m_tile_size, m_random.Derive(RANDOM_STREAM_ENEMIES + m_made++));
+}
+
+void EnemyManager::MakeEnemyThree(unsigned int x, unsigned int y)
+{
+    m_batches[EnemyBatch::THREE].Add(x*m_tile_size, y*m_tile_size, m_random.Derive(RANDOM_STREAM_ENEMIES + m_made++));
+}
+
+void EnemyManager::Draw(RenderSnapshot& snapshot) const
+{
+    if(!snapshot.HasView())
     {
-        delete (*i);
+        for(auto batch = m_batches.begin(); batch != m_batches.end(); ++batch)
+        {
+            batch->Draw(snapshot);
+        }
+        return;
     }
+
+    const SDL_Rect& area = snapshot.GetArea();
+    m_grid.Query(area.x, area.y, area.w, area.h, [&](unsigned int handle)
+    {
+        m_batches[handle >> 24].Draw(snapshot, handle & 0xFFFFFF);
+    });
 }
 
-void EnemyManager::KillEnemies(unsigned int x, unsigned int y, double intensity)
+void EnemyManager::Update()
 {
-    for(auto i = m_enemies.begin(); i != m_enemies.end();)
+    if(m_batches[EnemyBatch::THREE].GetSize() > 0)
+        UpdateField();
+
+    // Players do not move while the enemies do, so their boxes are taken once
+    m_players.clear();
+    m_boxes.clear();
+    for(PlayerManager::Iterator it(m_relay->GetPlayerManager()); !it.Finished(); ++it)
+    {
+        m_players.push_back(&it.GetPlayer());
+        m_boxes.push_back(EnemyBatch::TouchBox(it.GetPlayer(), m_tile_size));
+    }
+
+    unsigned int enemies = 0;
+    m_chunks.clear();
+    for(auto batch = m_batches.begin(); batch != m_batches.end(); ++batch)
+    {
+        batch->SavePositions();
+        enemies += batch->GetSize();
+        for(unsigned int first = 0; first < batch->GetSize(); first += ENEMY_PARALLEL_CHUNK)
+            m_chunks.push_back({&*batch, first, std::min(ENEMY_PARALLEL_CHUNK, batch->GetSize() - first)});
+    }
+    m_touched.assign(m_chunks.size() * m_players.size(), false);
+
+    ThreadPool* pool = m_relay->GetThreadPool();
+    if(pool != nullptr && enemies >= ENEMY_PARALLEL_MIN)
+        pool->Run(m_chunks.size(), [this](unsigned int chunk) { UpdateChunk(chunk); });
+    else
+    {
+        for(unsigned int chunk = 0; chunk < m_chunks.size(); ++chunk)
+            UpdateChunk(chunk);
+    }
+
+    for(unsigned int p = 0; p < m_players.size(); ++p)
     {
-        Destroyer::DestroyEnemy(*i, x, y, m_tile_size, intensity);
-        if((*i)->GetHealth() == 0)
+        for(unsigned int chunk = 0; chunk < m_chunks.size(); ++chunk)
         {
-            delete (*i);
-            i = m_enemies.erase(i);
+            if(m_touched[chunk*m_players.size() + p])
+            {
+                m_players[p]->SetHealth(0);
+                break;
+            }
         }
-        else
-            ++i;
     }
+    RebuildGrid();
 }
 
-void EnemyManager::AddEnemy(Enemy *enemy)
+void EnemyManager::UpdateChunk(unsigned int chunk)
 {
-    m_enemies.push_back(enemy);
+    const Chunk& range = m_chunks[chunk];
+    // Touches are tested before the enemies of the chunk move
+    for(unsigned int p = 0; p < m_boxes.size(); ++p)
+        m_touched[chunk*m_boxes.size() + p] = range.batch->Touches(m_boxes[p], range.first, range.count);
+    range.batch->Update(m_field, m_relay, range.first, range.count);
 }
 
-void EnemyManager::MakeEnemyOne(unsigned int x, unsigned int y)
+void EnemyManager::RebuildGrid()
 {
-    Enemy* e = new EnemyOne(m_texture, m_tile_size,x, y);
-    AddEnemy(e);
+    m_grid.Clear();
+    for(auto batch = m_batches.begin(); batch != m_batches.end(); ++batch)
+    {
+        unsigned int kind = batch->GetKind();
+        for(unsigned int i = 0; i < batch->GetSize(); ++i)
+        {
+            m_grid.Insert(kind << 24 | i, batch->GetX(i), batch->GetY(i));
+        }
+    }
 }
 
-void EnemyManager::MakeEnemyTwo(unsigned int x, unsigned int y)
+void EnemyManager::UpdateField()
 {
-    Enemy* e = new EnemyTwo(m_texture, m_tile_size, x, y);
-    AddEnemy(e);
+    const Map* map = m_relay->GetMap();
+    m_goals.clear();
+    for(PlayerManager::Iterator it(m_relay->GetPlayerManager()); !it.Finished(); ++it)
+    {
+        Player& player = it.GetPlayer();
+        if(player.GetLives() == 0 || player.IsLevelCompleted())
+            continue;
+
+        // Tile under the center of the player, players waiting to respawn are off the map
+        unsigned int row = (player.GetY() + player.GetSizeH()/2) / m_tile_size;
+        unsigned int column = (player.GetX() + player.GetSizeW()/2) / m_tile_size;
+        if(row < map->GetHeight() && column < map->GetWidth())
+            m_goals.push_back(row*map->GetWidth() + column);
+    }
+    std::sort(m_goals.begin(), m_goals.end());
+    m_goals.erase(std::unique(m_goals.begin(), m_goals.end()), m_goals.end());
+
+    m_field.Update(*map, m_goals);
 }
 
-void EnemyManager::MakeEnemyThree(unsigned int x, unsigned int y)
+void EnemyManager::SaveState(StateBuffer& state) const
 {
-    Enemy* e = new EnemyThree(m_texture, m_tile_size,x, y);
-    AddEnemy(e);
+    state.Write(m_made);
+    for(auto batch = m_batches.begin(); batch != m_batches.end(); ++batch)
+    {
+        batch->SaveState(state);
+    }
 }
 
-void EnemyManager::Draw(SDL_Renderer* renderer) const
+void EnemyManager::LoadState(StateBuffer& state)
 {
-    for(auto i = m_enemies.begin(); i != m_enemies.end(); ++i)
+    state.Read(m_made);
+    for(auto batch = m_batches.begin(); batch != m_batches.end(); ++batch)
     {
-        (*i)->Draw(renderer);
+        batch->LoadState(state);
     }
+    RebuildGrid();
+    // Walls may have come back, which Repair() can not take into account
+    m_field.Reset();
 }
 
-void EnemyManager::Update()
+void EnemyManager::TakeSnapshot(WorldSnapshot& snapshot) const
 {
-    for(auto i = m_enemies.begin(); i != m_enemies.end(); ++i)
+    for(auto batch = m_batches.begin(); batch != m_batches.end(); ++batch)
     {
-        (*i)->Update(m_relay);
+        for(unsigned int i = 0; i < batch->GetSize(); ++i)
+            snapshot.enemies.push_back({(uint16_t)batch->GetX(i), (uint16_t)batch->GetY(i), (uint8_t)batch->GetKind(), 0});
     }
 }
@@ -1,25 +1,17 @@
 #include "Manager/ExplosionManager.h"
+#include "Constants/PoolConstants.h"
+#include "Constants/PlayerConstants.h"
+#include <algorithm>
 
-ExplosionManager::ExplosionManager(SDL_Texture* texture, unsigned int tile_size)
-    : DisplayElement(texture), m_tile_size(tile_size)
+ExplosionManager::ExplosionManager(SDL_Texture* texture, unsigned int tile_size, Relay* relay)
+    : DisplayElement(texture), m_explosions(POOL_EXPLOSION_CAPACITY), m_tile_size(tile_size),
+      m_system_timer(relay->GetSystemTimer()),
+      m_grid(tile_size, 0)
 {
 }
 
 ExplosionManager::~ExplosionManager()
 {
-    for(auto i = m_explosions.begin(); i != m_explosions.end(); ++i)
-    {
-        delete (*i);
-        #ifdef DEBUG_OUTPUT
-        std::cout << "Explosion deleted" << std::endl;
-        #endif // DEBUG_OUTPUT
-    }
-
-}
-
-void ExplosionManager::AddExplosion(Explosion *explosion)
-{
-    m_explosions.push_back(explosion);
 }
 
 void ExplosionManager::MakeExplosion(unsigned int duration,
@@ -27,30 +19,89 @@ void ExplosionManager::MakeExplosion(unsigned int duration,
                                      unsigned int y_center,
                                      double intensity)
 {
-    Explosion* e = new Explosion(duration,x_center,y_center,intensity,m_tile_size,m_texture);
-    AddExplosion(e);
+    Explosion* explosion = m_explosions.Make(duration,x_center,y_center,intensity,m_tile_size,m_texture,m_system_timer);
+    if(explosion != nullptr)
+        m_grid.Insert(explosion, explosion->GetX(), explosion->GetY());
+}
+
+void ExplosionManager::MakeExplosions(unsigned int duration, const std::vector<BlastArea>& blasts)
+{
+    for(auto blast = blasts.begin(); blast != blasts.end(); ++blast)
+    {
+        MakeExplosion(duration,blast->x,blast->y,blast->intensity);
+    }
 }
 
 void ExplosionManager::Update()
 {
-    for(auto i = m_explosions.begin(); i != m_explosions.end();)
+    // Removing an explosion moves the last one into its place
+    for(unsigned int i = 0; i < m_explosions.GetSize();)
     {
-        (*i)->Update();
-        if(!((*i)->IsExploding())) // if not exploding then delete object
+        Explosion* explosion = m_explosions[i];
+        explosion->Update();
+        if(!(explosion->IsExploding())) // if not exploding then delete object
         {
-            delete (*i);
-            i = m_explosions.erase(i);
+            m_grid.Remove(explosion, explosion->GetX(), explosion->GetY());
+            m_explosions.Destroy(explosion);
         }
         else
             ++i;
     }
 }
 
-void ExplosionManager::Draw(SDL_Renderer* renderer) const
+void ExplosionManager::Draw(RenderSnapshot& snapshot) const
 {
+    if(snapshot.HasView())
+    {
+        // The largest explosions reach this far from their centers
+        int reach = m_tile_size * PLAYER_MAX_BOMB_INTENSITY / 2 + 1;
+        const SDL_Rect& area = snapshot.GetArea();
+        m_grid.Query(area.x - reach, area.y - reach, area.w + 2*reach, area.h + 2*reach, [&](Explosion* explosion)
+        {
+            explosion->Draw(snapshot);
+        });
+        return;
+    }
     for(auto i = m_explosions.begin(); i != m_explosions.end(); ++i)
     {
-        (*i)->Draw(renderer);
+        (*i)->Draw(snapshot);
     }
 
 }
+
+void ExplosionManager::SaveState(StateBuffer& state) const
+{
+    state.Write(m_explosions.GetSize());
+    for(auto i = m_explosions.begin(); i != m_explosions.end(); ++i)
+    {
+        (*i)->SaveState(state);
+    }
+}
+
+void ExplosionManager::LoadState(StateBuffer& state)
+{
+    m_explosions.Clear();
+    m_grid.Clear();
+
+    unsigned int count = 0;
+    state.Read(count);
+    for(unsigned int i = 0; i < count && !state.Failed(); ++i)
+    {
+        Explosion* explosion = m_explosions.Make(0,0,0,0.0,m_tile_size,m_texture,m_system_timer);
+        if(explosion == nullptr)
+            break;
+        explosion->LoadState(state);
+        m_grid.Insert(explosion, explosion->GetX(), explosion->GetY());
+    }
+}
+
+void ExplosionManager::TakeSnapshot(WorldSnapshot& snapshot) const
+{
+    for(auto i = m_explosions.begin(); i != m_explosions.end(); ++i)
+    {
+        uint32_t tile = (*i)->GetY() / snapshot.tile_size * snapshot.width + (*i)->GetX() / snapshot.tile_size;
+        double eighths = (*i)->GetIntensity() * 8;
+        snapshot.explosions.push_back({tile, (uint8_t)(eighths < 255 ? eighths : 255)});
+    }
+    std::sort(snapshot.explosions.begin(), snapshot.explosions.end());
+}
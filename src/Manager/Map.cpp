@@ -1,12 +1,11 @@
 #include "Manager/Map.h"
-#include <stdlib.h>     /* srand, rand */
-#include <time.h>       /* time */
+#include <stdlib.h>     /* exit */
 #include <fstream>      /* fstream open close */
-#include "Constants/TextureMapObjectConstants.h"
+#include "Constants/TextureAtlas.h"
 #include "Constants/PickUpConstants.h"
+#include "Constants/SimulationConstants.h"
 #include "Entity/PickUp.h"
 #include "Manager/PickUpManager.h"
-#include "Entity/DestructibleWall.h"
 
 //#define DEBUG_OUTPUT_MAP
 
@@ -17,11 +16,15 @@
 Map::Map(std::string path_to_file,
          SDL_Texture* texture,
          unsigned int tile_size,
-         Relay* relay)
+         Relay* relay,
+         const Random& random)
     : DisplayElement(texture),
       m_tile_size(tile_size),
+      m_collision(0, 0, tile_size),
       m_relay(relay),
-      m_wall_count(0)
+      m_wall_count(0),
+      m_redraw_revision(1),
+      m_pickup_random(random.Derive(RANDOM_STREAM_PICKUPS))
 {
     std::fstream fs;
     fs.open (path_to_file, std::fstream::in);
@@ -36,11 +39,10 @@ Map::Map(std::string path_to_file,
 
     fs >> m_height >> m_width;
 
-    m_layout.resize(m_height);
-    for (unsigned i=0; i<m_height; ++i)
-        m_layout[i].resize(m_width);
+    m_layout.resize(m_height*m_width);
+    m_collision = CollisionMask(m_height, m_width, m_tile_size);
 
-    srand(time(nullptr));
+    Random looks = random.Derive(RANDOM_STREAM_MAP_TILES);
     for (unsigned i=0; i<m_height; ++i)
         for (unsigned j=0; j<m_width; ++j)
         {
@@ -51,20 +53,22 @@ Map::Map(std::string path_to_file,
             {
             case 0:
                 //tile = MapObject::EMPTY;
-                m_layout[i][j] = new MapObject(MapObject::EMPTY, m_texture, rand() % TEXTURE_MAP_EMPTY_KIND_COUNT);
+                m_layout[i*m_width + j] = MapObject(MapObject::EMPTY, looks.Below(ATLAS_MAP_EMPTY_DIRECTIONS));
+                m_collision.SetWalkable(i, j, true);
                 break;
             case 1:
                 //tile = MapObject::DESTRUCTIBLE_WALL;
-                m_layout[i][j] = new DestructibleWall(m_texture, rand() % TEXTURE_MAP_DESTRUCTIBLE_KIND_COUNT);
+                m_layout[i*m_width + j] = MapObject(MapObject::DESTRUCTIBLE_WALL, looks.Below(ATLAS_MAP_DESTRUCTIBLE_DIRECTIONS));
                 ++m_wall_count;
                 break;
             case 2:
                 //tile = MapObject::INDESTRUCTIBLE_WALL;
-                m_layout[i][j] = new MapObject(MapObject::INDESTRUCTIBLE_WALL, m_texture, rand() % TEXTURE_MAP_INDESTRUCTIBLE_KIND_COUNT);
+                m_layout[i*m_width + j] = MapObject(MapObject::INDESTRUCTIBLE_WALL, looks.Below(ATLAS_MAP_INDESTRUCTIBLE_DIRECTIONS));
                 break;
             default:
                 //tile = MapObject::EMPTY;
-                m_layout[i][j] = new MapObject(MapObject::EMPTY, m_texture);
+                m_layout[i*m_width + j] = MapObject(MapObject::EMPTY);
+                m_collision.SetWalkable(i, j, true);
                 break;
             }
         }
@@ -72,60 +76,50 @@ Map::Map(std::string path_to_file,
     std::cout << "WALL COUNT: " << m_wall_count << std::endl;
     #endif // DEBUG_OUTPUT_MAP
     fs.close();
-    srand(time(NULL));
+    m_opened.reserve(m_wall_count);
+    // A wall changes its look once per level of integrity, the last one being destroyed
+    m_changed.reserve(m_wall_count * ATLAS_MAP_DESTRUCTIBLE_PHASES);
 }
 
-Map::~Map()
+static bool SameSource(const SDL_Rect& a, const SDL_Rect& b)
 {
-    for (unsigned i = 0; i < m_height; ++i)
-    {
-        for (unsigned j = 0; j < m_width; ++j)
-        {
-            delete m_layout[i][j];
-        }
-    }
+    return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
 }
 
-bool Map::Walkable(unsigned int i,unsigned int j) const
+Map::~Map()
 {
-    if (m_layout[i][j]->GetId() == MapObject::EMPTY)
-        return true;
-    else
-        return false;
 }
 
-
-void Map::Draw(SDL_Renderer* renderer) const
+void Map::Draw(RenderSnapshot& snapshot) const
 {
-    SDL_Rect DestR;
-    int tile_size = m_tile_size;
-
-    DestR.x = 0;
-    DestR.y = 0;
-    DestR.w = tile_size;
-    DestR.h = tile_size;
+    unsigned long revision = GetLayerRevision();
+    unsigned long base = snapshot.GetLayerBase();
+    snapshot.SetLayer(m_texture, m_width, m_height, m_tile_size, revision);
 
-    for (unsigned i = 0; i < m_height; ++i)
+    if (base < m_redraw_revision || base > revision)
     {
-        for (unsigned j = 0; j < m_width; ++j)
-        {
-            DestR.y = tile_size*i;
-            DestR.x = tile_size*j;
-            m_layout[i][j]->Draw(renderer, &DestR);
-        }
+        for (unsigned int index = 0; index < m_layout.size(); ++index)
+            snapshot.ChangeTile(index, m_layout[index].GetSource());
+        return;
     }
+    // A tile changed twice is added twice, both times with its look of now
+    for (unsigned long k = base - m_redraw_revision; k < m_changed.size(); ++k)
+        snapshot.ChangeTile(m_changed[k], m_layout[m_changed[k]].GetSource());
 }
 
 void Map::DestroyWall(unsigned int i, unsigned int j, unsigned int damage)
 {
-    if (m_layout[i][j]->GetId() == MapObject::DESTRUCTIBLE_WALL)
+    MapObject& wall = m_layout[i*m_width + j];
+    if (wall.GetId() == MapObject::DESTRUCTIBLE_WALL)
     {
-        DestructibleWall* wall = (DestructibleWall*)m_layout[i][j];
-        wall->DecreaseIntegrity(damage);
-        if (wall->IsDestroyed())
+        SDL_Rect look = wall.GetSource();
+        wall.DecreaseIntegrity(damage);
+        if (wall.IsDestroyed())
         {
-            delete m_layout[i][j];
-            m_layout[i][j] = new MapObject(MapObject::EMPTY, m_texture);
+            wall = MapObject(MapObject::EMPTY);
+            LogChange(i*m_width + j);
+            m_collision.SetWalkable(i, j, true);
+            m_opened.push_back(i*m_width + j);
             --m_wall_count;
             #ifdef DEBUG_OUTPUT_MAP
             std::cout << "MapObject at X:" << j << " Y:" << i << " is replaced with EMPTY. Wall count:" << m_wall_count << std::endl;
@@ -135,6 +129,8 @@ void Map::DestroyWall(unsigned int i, unsigned int j, unsigned int damage)
             else
                 TryPlacePickUp(i,j);
         }
+        else if (!SameSource(look, wall.GetSource()))
+            LogChange(i*m_width + j);
     }
     #ifdef DEBUG_OUTPUT_MAP
     else
@@ -144,11 +140,6 @@ void Map::DestroyWall(unsigned int i, unsigned int j, unsigned int damage)
     #endif // DEBUG_OUTPUT_MAP
 }
 
-MapObject::Tile Map::GetTileType(unsigned int i, unsigned int j) const
-{
-    return m_layout[i][j]->GetId();
-}
-
 void Map::PlaceExit(unsigned int i, unsigned int j)
 {
     unsigned int x = j*m_tile_size+m_tile_size/2;
@@ -166,8 +157,8 @@ void Map::TryPlacePickUp(unsigned int i, unsigned int j)
     #ifdef DEBUG_OUTPUT_MAP
     std::cout << "Map::TryPlacePickUp at: (i,j)=(" << i << "," << j << ") (x,y)=(" << x << "," << y << ")" << std::endl;
     #endif // DEBUG_OUTPUT_MAP
-    unsigned int chance = rand() % 100;
-    unsigned int type = rand() % NUMBER_OF_PICKUPS;
+    unsigned int chance = m_pickup_random.Below(100);
+    unsigned int type = m_pickup_random.Below(NUMBER_OF_PICKUPS);
     #ifdef DEBUG_OUTPUT_MAP
     std::cout << "Chance: " << chance << ", Type:" << type << std::endl;
     #endif // DEBUG_OUTPUT_MAP
@@ -210,3 +201,44 @@ void Map::TryPlacePickUp(unsigned int i, unsigned int j)
     }
 
 }
+
+void Map::LogChange(unsigned int index)
+{
+    if (m_changed.size() == m_changed.capacity())
+    {
+        m_redraw_revision = GetLayerRevision() + 1;
+        m_changed.clear();
+        return;
+    }
+    m_changed.push_back(index);
+}
+
+void Map::SaveState(StateBuffer& state) const
+{
+    state.WriteVector(m_layout);
+    m_collision.SaveState(state);
+    state.Write(m_wall_count);
+    state.WriteVector(m_opened);
+    state.Write(m_pickup_random);
+}
+
+void Map::LoadState(StateBuffer& state)
+{
+    m_loaded.swap(m_layout);
+    state.ReadVector(m_layout);
+    for (unsigned int index = 0; index < m_layout.size() && index < m_loaded.size(); ++index)
+        if (!SameSource(m_layout[index].GetSource(), m_loaded[index].GetSource()))
+            LogChange(index);
+    m_collision.LoadState(state);
+    state.Read(m_wall_count);
+    state.ReadVector(m_opened);
+    state.Read(m_pickup_random);
+}
+
+void Map::TakeSnapshot(WorldSnapshot& snapshot) const
+{
+    snapshot.width = m_width;
+    snapshot.height = m_height;
+    snapshot.tile_size = m_tile_size;
+    snapshot.opened.assign(m_opened.begin(), m_opened.end());
+}
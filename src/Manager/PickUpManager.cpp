@@ -1,4 +1,6 @@
 #include "Manager/PickUpManager.h"
+#include "Constants/PickUpConstants.h"
+#include <algorithm>
 
 //#define DEBUG_OUTPUT_PICKUP_MANAGER
 
@@ -6,30 +8,34 @@
 #include <iostream>
 #endif // DEBUG_OUTPUT_PICKUP_MANAGER
 
+// About one bucket per tile, there is at most one pickup per tile
+static unsigned int GridBuckets(unsigned int capacity)
+{
+    unsigned int buckets = PICKUP_GRID_BUCKETS_MIN;
+    while(buckets < capacity && buckets < PICKUP_GRID_BUCKETS_MAX)
+        buckets *= 2;
+    return buckets;
+}
+
 PickUpManager::PickUpManager(SDL_Texture* texture,
                              unsigned int tile_size,
+                             unsigned int capacity,
                              Relay* relay)
     : DisplayElement(texture),
+      m_pickups(capacity),
       m_tile_size(tile_size),
       m_draw_size(tile_size*3/4),
-      m_relay(relay)
+      m_relay(relay),
+      m_grid(tile_size, 0, GridBuckets(capacity), 4 + capacity / GridBuckets(capacity)),
+      m_touch_mask(Contact::MaskWords(PICKUP_TOUCH_CANDIDATES))
 {
+    m_candidates.reserve(PICKUP_TOUCH_CANDIDATES);
+    m_candidate_x.reserve(PICKUP_TOUCH_CANDIDATES);
+    m_candidate_y.reserve(PICKUP_TOUCH_CANDIDATES);
 }
 
 PickUpManager::~PickUpManager()
 {
-    for(auto i = m_pickups.begin(); i != m_pickups.end(); ++i)
-    {
-        delete (*i);
-        #ifdef DEBUG_OUTPUT_PICKUP_MANAGER
-        std::cout << "PickUp deleted" << std::endl;
-        #endif // DEBUG_OUTPUT_PICKUP_MANAGER
-    }
-}
-
-void PickUpManager::AddPickUp(PickUp* pickup)
-{
-    m_pickups.push_back(pickup);
 }
 
 void PickUpManager::MakePickUp(PickUp::PickUpType type, int x, int y, int value)
@@ -37,29 +43,46 @@ void PickUpManager::MakePickUp(PickUp::PickUpType type, int x, int y, int value)
     #ifdef DEBUG_OUTPUT_PICKUP_MANAGER
     std::cout << "Making pickup with value" << value << std::endl;
     #endif // DEBUG_OUTPUT_PICKUP_MANAGER
-    PickUp* pickup = new PickUp(m_texture,type,value,x,y,m_draw_size);
-    AddPickUp(pickup);
+    PickUp* pickup = m_pickups.Make(m_texture,type,value,x,y,m_draw_size);
+    if(pickup != nullptr)
+        m_grid.Insert(pickup, pickup->GetX(), pickup->GetY());
 }
 
 void PickUpManager::Update()
 {
-    for(auto i = m_pickups.begin(); i != m_pickups.end();)
+    // Removing a pickup moves the last one into its place
+    for(unsigned int i = 0; i < m_pickups.GetSize();)
     {
-        if((*i)->IsUsed())
+        PickUp* pickup = m_pickups[i];
+        if(pickup->IsUsed())
         {
-            delete (*i);
-            i = m_pickups.erase(i);
+            m_grid.Remove(pickup, pickup->GetX(), pickup->GetY());
+            m_pickups.Destroy(pickup);
+            #ifdef DEBUG_OUTPUT_PICKUP_MANAGER
+            std::cout << "PickUp deleted" << std::endl;
+            #endif // DEBUG_OUTPUT_PICKUP_MANAGER
         }
         else
             ++i;
     }
 }
 
-void PickUpManager::Draw(SDL_Renderer* renderer) const
+void PickUpManager::Draw(RenderSnapshot& snapshot) const
 {
+    // Pickups are smaller than the margin around the view, so their centers
+    // are enough to find the ones in it
+    if(snapshot.HasView())
+    {
+        const SDL_Rect& area = snapshot.GetArea();
+        m_grid.Query(area.x, area.y, area.w, area.h, [&](PickUp* pickup)
+        {
+            pickup->Draw(snapshot);
+        });
+        return;
+    }
     for(auto i = m_pickups.begin(); i != m_pickups.end(); ++i)
     {
-        (*i)->Draw(renderer);
+        (*i)->Draw(snapshot);
     }
 }
 
@@ -90,25 +113,61 @@ PickUpManager::Iterator& PickUpManager::Iterator::operator++()
     return *this;
 }
 
-std::list<PickUp*>::iterator PickUpManager::Iterator::Begin() const
+ObjectPool<PickUp>::const_iterator PickUpManager::Iterator::Begin() const
 {
     return m_pickups_pointer->begin();
 }
 
-std::list<PickUp*>::iterator PickUpManager::Iterator::End() const
+ObjectPool<PickUp>::const_iterator PickUpManager::Iterator::End() const
 {
     return m_pickups_pointer->end();
 }
 
-std::list<PickUp*>::iterator PickUpManager::Iterator::Current() const
+ObjectPool<PickUp>::const_iterator PickUpManager::Iterator::Current() const
 {
      return it;
 }
 
-std::list<PickUp*>::iterator PickUpManager::Iterator::Next()
+ObjectPool<PickUp>::const_iterator PickUpManager::Iterator::Next()
 {
     if (it == End())
         return it;
     else
         return ++it;
 }
+
+void PickUpManager::SaveState(StateBuffer& state) const
+{
+    state.Write(m_pickups.GetSize());
+    for(auto i = m_pickups.begin(); i != m_pickups.end(); ++i)
+    {
+        (*i)->SaveState(state);
+    }
+}
+
+void PickUpManager::LoadState(StateBuffer& state)
+{
+    m_pickups.Clear();
+    m_grid.Clear();
+
+    unsigned int count = 0;
+    state.Read(count);
+    for(unsigned int i = 0; i < count && !state.Failed(); ++i)
+    {
+        PickUp* pickup = m_pickups.Make(m_texture,PickUp::EXIT,0,0,0,m_draw_size);
+        if(pickup == nullptr)
+            break;
+        pickup->LoadState(state);
+        m_grid.Insert(pickup, pickup->GetX(), pickup->GetY());
+    }
+}
+
+void PickUpManager::TakeSnapshot(WorldSnapshot& snapshot) const
+{
+    for(auto i = m_pickups.begin(); i != m_pickups.end(); ++i)
+    {
+        uint32_t tile = (*i)->GetY() / snapshot.tile_size * snapshot.width + (*i)->GetX() / snapshot.tile_size;
+        snapshot.pickups.push_back({tile, (uint8_t)(*i)->GetType()});
+    }
+    std::sort(snapshot.pickups.begin(), snapshot.pickups.end());
+}
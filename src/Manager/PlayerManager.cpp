@@ -1,13 +1,15 @@
 #include "Manager/PlayerManager.h"
 #include "Destroyer/Destroyer.h"
-#include "Constants/TextureScoreConstants.h"
+#include "Constants/TextureAtlas.h"
 #include "Constants/ResourcesConstants.h"
 #include <fstream>
 #include <cstdlib>
 
 PlayerManager::PlayerManager(std::string path_to_file, SDL_Texture* texture, unsigned int tile_size,
                               Relay *relay, unsigned int numb_of_players_to_load)
-    : DisplayElement(texture)
+    : DisplayElement(texture),
+      m_timer(relay->GetSystemTimer()),
+      m_grid(tile_size, tile_size)
 {
     m_numb_of_players_to_load = numb_of_players_to_load;
     m_tile_size = tile_size;
@@ -42,6 +44,7 @@ PlayerManager::PlayerManager(std::string path_to_file, SDL_Texture* texture, uns
     }
 
     fs.close();
+    RebuildGrid();
 
     std::string path_music = RESOURCES_BASE_PATH + RESOURCES_KILL_LOAD;
     m_kill_sound = Mix_LoadWAV(path_music.c_str());
@@ -62,11 +65,15 @@ void PlayerManager::MakePlayer(unsigned int player_id, unsigned int x, unsigned
     m_players.push_back(player);
 }
 
-void PlayerManager::KillPlayer(unsigned int x, unsigned int y, double intensity)
+void PlayerManager::KillPlayer(const std::vector<BlastArea>& blasts)
 {
-    for(auto i = m_players.begin(); i != m_players.end(); ++i)
+    for(auto blast = blasts.begin(); blast != blasts.end(); ++blast)
     {
-        Destroyer::DestroyPlayer(*i, x, y, m_tile_size, intensity);
+        int reach = m_tile_size * blast->intensity / 2;
+        m_grid.Query((int)blast->x - reach, (int)blast->y - reach, 2*reach, 2*reach, [&](Player* player)
+        {
+            Destroyer::DestroyPlayer(player, blast->x, blast->y, m_tile_size, blast->intensity);
+        });
     }
 }
 
@@ -75,34 +82,28 @@ void PlayerManager::AddPlayer(Player *player)
     m_players.push_back(player);
 }
 
-void PlayerManager::DrawScore(SDL_Renderer* renderer, unsigned int player_id, unsigned int lives) const
+void PlayerManager::DrawScore(RenderSnapshot& snapshot, unsigned int player_id, unsigned int lives) const
 {
-    SDL_Rect SrcR;
+    const SDL_Rect& SrcR = AtlasFrame(ATLAS_LIVES, 0, lives < ATLAS_LIVES_PHASES ? lives : ATLAS_LIVES_PHASES - 1);
     SDL_Rect DestR;
 
-    SrcR.y = TEXTURE_NUMB_Y;
-    SrcR.w = TEXTURE_NUMB_SOURCE_W;
-    SrcR.h = TEXTURE_NUMB_SOURCE_H;
-
-    SrcR.x = lives*TEXTURE_NUMB_SOURCE_W + TEXTURE_NUMB_X;
-
     DestR.x = 0 + player_id*2*m_tile_size;
     DestR.y = 0;
     DestR.w = m_tile_size;
     DestR.h = m_tile_size;
 
-    SDL_RenderCopy(renderer, m_texture, &SrcR, &DestR);
+    snapshot.Overlay(m_texture, SrcR, DestR);
 
 }
 
-void PlayerManager::Draw(SDL_Renderer* renderer) const
+void PlayerManager::Draw(RenderSnapshot& snapshot) const
 {
     for(auto i = m_players.begin(); i != m_players.end(); ++i)
     {
-        DrawScore(renderer, (*i)->GetID(), (*i)->GetLives());
+        DrawScore(snapshot, (*i)->GetID(), (*i)->GetLives());
 
         if( ((*i)->GetLives() != 0) && !((*i)->IsLevelCompleted()) )
-            (*i)->Draw(renderer);
+            (*i)->Draw(snapshot);
     }
 }
 
@@ -132,6 +133,16 @@ void PlayerManager::Update()
         if( ((*i)->GetLives() != 0) && !((*i)->IsLevelCompleted()) )
             (*i)->Update();
     }
+    RebuildGrid();
+}
+
+void PlayerManager::RebuildGrid()
+{
+    m_grid.Clear();
+    for(auto i = m_players.begin(); i != m_players.end(); ++i)
+    {
+        m_grid.Insert(*i, (*i)->GetX(), (*i)->GetY());
+    }
 }
 
 Player* PlayerManager::GetPlayerById(int id)
@@ -217,3 +228,33 @@ std::vector<Player*>::iterator PlayerManager::Iterator::Next()
     else
         return ++it;
 }
+
+void PlayerManager::SaveState(StateBuffer& state) const
+{
+    m_timer.SaveState(state);
+    for(auto i = m_players.begin(); i != m_players.end(); ++i)
+    {
+        (*i)->SaveState(state);
+    }
+}
+
+void PlayerManager::LoadState(StateBuffer& state)
+{
+    m_timer.LoadState(state);
+    for(auto i = m_players.begin(); i != m_players.end(); ++i)
+    {
+        (*i)->LoadState(state);
+    }
+    RebuildGrid();
+}
+
+void PlayerManager::TakeSnapshot(WorldSnapshot& snapshot) const
+{
+    for(auto i = m_players.begin(); i != m_players.end(); ++i)
+    {
+        // Lives up to 15, whether alive and direction fit in one byte
+        unsigned int lives = (*i)->GetLives() < 15 ? (*i)->GetLives() : 15;
+        uint8_t extra = lives | (*i)->IsAlive() << 4 | ((*i)->GetDirection() & 3) << 5;
+        snapshot.players.push_back({(uint16_t)(*i)->GetX(), (uint16_t)(*i)->GetY(), (uint8_t)(*i)->GetID(), extra});
+    }
+}
@@ -0,0 +1,35 @@
+#include "Network/NetworkOptions.h"
+#include <cstring>
+#include <cstdlib>
+
+bool NetworkOptions::ParseArgument(int argc, char* argv[], int& i)
+{
+    if (i + 1 >= argc)
+        return false;
+
+    if (!strcmp(argv[i], "--net-port"))
+        local_port = (unsigned short)atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--net-peer"))
+    {
+        std::string peer = argv[++i];
+        std::size_t colon = peer.rfind(':');
+        if (colon == std::string::npos)
+            peer_port = (unsigned short)atoi(peer.c_str());
+        else
+        {
+            peer_host = peer.substr(0, colon);
+            peer_port = (unsigned short)atoi(peer.c_str() + colon + 1);
+        }
+    }
+    else if (!strcmp(argv[i], "--net-player"))
+        local_player = atoi(argv[++i]) == 0 ? 0 : 1;
+    else if (!strcmp(argv[i], "--latency"))
+        latency = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--jitter"))
+        jitter = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--loss"))
+        loss = atoi(argv[++i]);
+    else
+        return false;
+    return true;
+}
@@ -0,0 +1,295 @@
+#include "Network/RollbackSession.h"
+#include "System/SystemTimer.h"
+
+static const uint32_t PACKET_MAGIC = 0x504E4D42; // "BMNP"
+static const unsigned int PLAYER_BUTTONS = 5;
+
+RollbackSession::RollbackSession(World* world,
+                                 ScriptedInput* world_input,
+                                 unsigned int local_player,
+                                 unsigned int level,
+                                 UdpSocket* socket)
+    : m_world(world),
+      m_world_input(world_input),
+      m_local_player(local_player),
+      m_level(level),
+      m_socket(socket),
+      m_connected(false),
+      m_step(0),
+      m_local_last((long)NETWORK_INPUT_DELAY - 1),
+      m_remote_confirmed((long)NETWORK_INPUT_DELAY - 1),
+      m_remote_acked((long)NETWORK_INPUT_DELAY - 1),
+      m_remote_step(0),
+      m_remote_ahead(0),
+      m_rollback_from(-1),
+      m_wait(0),
+      m_next_sync(NETWORK_SYNC_INTERVAL),
+      m_states(NETWORK_HISTORY, StateBuffer(1 << 16)),
+      m_packet(NETWORK_PACKET_SIZE),
+      m_received(NETWORK_PACKET_SIZE),
+      m_checksum_next(NETWORK_CHECKSUM_INTERVAL),
+      m_remote_checksum_step(-1),
+      m_remote_checksum(0),
+      m_compared_step(-1),
+      m_rollbacks(0),
+      m_rolled_back_steps(0),
+      m_longest_rollback(0),
+      m_skipped_steps(0),
+      m_compared_checksums(0),
+      m_desyncs(0)
+{
+    m_world->GetInputKeys(m_keys);
+    for (unsigned int i = 0; i < NETWORK_HISTORY; ++i)
+    {
+        m_local[i] = 0;
+        m_remote[i] = 0;
+        m_used[i] = 0;
+    }
+    for (unsigned int i = 0; i < NETWORK_CHECKSUMS; ++i)
+    {
+        m_checksum_steps[i] = -1;
+        m_checksums[i] = 0;
+    }
+}
+
+uint8_t RollbackSession::ReadButtons(KeyboardInput* input) const
+{
+    uint8_t buttons = 0;
+    for (unsigned int i = 0; i < PLAYER_BUTTONS && i < m_keys.size(); ++i)
+        if (input->IsKeyOn(m_keys[i]))
+            buttons |= 1 << i;
+    return buttons;
+}
+
+bool RollbackSession::Advance(uint8_t buttons)
+{
+    Receive();
+    if (m_rollback_from >= 0)
+        Rollback();
+
+    // Waits while the peer's buttons are too late to predict or the peer
+    // runs behind, which it sees as its own buttons being late
+    if (m_connected && m_wait == 0 && m_step >= m_next_sync)
+    {
+        m_wait = StepsAhead();
+        m_next_sync = m_step + NETWORK_SYNC_INTERVAL;
+    }
+    if (!m_connected ||
+        m_step - m_remote_confirmed > (long)NETWORK_MAX_ROLLBACK ||
+        m_step + (long)NETWORK_INPUT_DELAY - m_remote_acked >= (long)NETWORK_HISTORY ||
+        m_wait > 0)
+    {
+        SystemTimer* system_timer = m_world->GetSystemTimer();
+        system_timer->SetSteps(system_timer->GetSteps() - 1);
+        if (m_connected)
+            ++m_skipped_steps;
+        if (m_wait > 0)
+            --m_wait;
+        Send();
+        return false;
+    }
+
+    m_local_last = m_step + NETWORK_INPUT_DELAY;
+    m_local[m_local_last % NETWORK_HISTORY] = buttons;
+    Simulate(m_step);
+    ++m_step;
+    MakeChecksums();
+    Send();
+    return true;
+}
+
+void RollbackSession::Poll()
+{
+    Receive();
+    if (m_rollback_from >= 0)
+        Rollback();
+    MakeChecksums();
+    Send();
+}
+
+void RollbackSession::Finish()
+{
+    for (unsigned int i = 0; i < NETWORK_FINISH_PACKETS; ++i)
+        Send();
+}
+
+void RollbackSession::Receive()
+{
+    int size;
+    while ((size = m_socket->Receive(m_received.data(), m_received.size())) > 0)
+    {
+        m_packet.Assign(m_received.data(), size);
+        uint32_t magic, level;
+        uint64_t seed;
+        uint8_t player;
+        int32_t step, ahead, ack, checksum_step, first;
+        uint32_t checksum;
+        uint16_t count;
+        m_packet.Read(magic);
+        m_packet.Read(level);
+        m_packet.Read(seed);
+        m_packet.Read(player);
+        m_packet.Read(step);
+        m_packet.Read(ahead);
+        m_packet.Read(ack);
+        m_packet.Read(checksum_step);
+        m_packet.Read(checksum);
+        m_packet.Read(first);
+        m_packet.Read(count);
+        if (m_packet.Failed() || magic != PACKET_MAGIC || level != m_level ||
+            seed != m_world->GetSeed() || player == m_local_player)
+            continue;
+
+        m_connected = true;
+        if (step >= m_remote_step)
+        {
+            m_remote_step = step;
+            m_remote_ahead = ahead;
+        }
+        if (ack > m_remote_acked)
+            m_remote_acked = ack;
+
+        // Buttons are taken in order only, so a gap waits for a later packet
+        for (long s = first; s < (long)first + count; ++s)
+        {
+            uint8_t buttons;
+            m_packet.Read(buttons);
+            if (m_packet.Failed() || s >= m_step + (long)(NETWORK_HISTORY - NETWORK_MAX_ROLLBACK) - 1)
+                break;
+            if (s != m_remote_confirmed + 1)
+                continue;
+
+            m_remote[s % NETWORK_HISTORY] = buttons;
+            m_remote_confirmed = s;
+            if (s < m_step && buttons != m_used[s % NETWORK_HISTORY] &&
+                (m_rollback_from < 0 || s < m_rollback_from))
+                m_rollback_from = s;
+        }
+
+        if (checksum_step >= 0)
+            CompareChecksum(checksum_step, checksum);
+    }
+}
+
+void RollbackSession::Send()
+{
+    long last_checksum = m_checksum_next - NETWORK_CHECKSUM_INTERVAL;
+    unsigned int last_index = (last_checksum / NETWORK_CHECKSUM_INTERVAL) % NETWORK_CHECKSUMS;
+    bool has_checksum = last_checksum > 0 && m_checksum_steps[last_index] == last_checksum;
+
+    long first = m_remote_acked + 1;
+    if (first < m_local_last + 1 - (long)NETWORK_MAX_INPUTS)
+        first = m_local_last + 1 - NETWORK_MAX_INPUTS;
+    if (first < 0)
+        first = 0;
+    uint16_t count = m_local_last >= first ? m_local_last - first + 1 : 0;
+
+    m_packet.Clear();
+    m_packet.Write(PACKET_MAGIC);
+    m_packet.Write((uint32_t)m_level);
+    m_packet.Write((uint64_t)m_world->GetSeed());
+    m_packet.Write((uint8_t)m_local_player);
+    m_packet.Write((int32_t)m_step);
+    m_packet.Write((int32_t)(m_step - m_remote_step));
+    m_packet.Write((int32_t)m_remote_confirmed);
+    m_packet.Write((int32_t)(has_checksum ? last_checksum : -1));
+    m_packet.Write(has_checksum ? m_checksums[last_index] : (uint32_t)0);
+    m_packet.Write((int32_t)first);
+    m_packet.Write(count);
+    for (long s = first; s < first + count; ++s)
+        m_packet.Write(m_local[s % NETWORK_HISTORY]);
+    m_socket->Send(m_packet.GetData(), m_packet.GetSize());
+}
+
+void RollbackSession::Rollback()
+{
+    SystemTimer* system_timer = m_world->GetSystemTimer();
+    unsigned long now = system_timer->GetSteps();
+    long from = m_rollback_from;
+    m_rollback_from = -1;
+
+    m_world->LoadState(m_states[from % NETWORK_HISTORY]);
+    for (long s = from; s < m_step; ++s)
+    {
+        if (s > from)
+            system_timer->SetSteps(system_timer->GetSteps() + 1);
+        Simulate(s);
+    }
+    system_timer->SetSteps(now);
+
+    ++m_rollbacks;
+    m_rolled_back_steps += m_step - from;
+    if ((unsigned int)(m_step - from) > m_longest_rollback)
+        m_longest_rollback = m_step - from;
+}
+
+void RollbackSession::Simulate(long step)
+{
+    m_world->SaveState(m_states[step % NETWORK_HISTORY]);
+
+    // The peer's buttons not known yet are predicted to stay as they were
+    uint8_t remote = 0;
+    if (step <= m_remote_confirmed)
+        remote = m_remote[step % NETWORK_HISTORY];
+    else if (m_remote_confirmed >= 0)
+        remote = m_remote[m_remote_confirmed % NETWORK_HISTORY];
+    m_used[step % NETWORK_HISTORY] = remote;
+
+    // Releases go first, as pressing a direction releases the others
+    uint8_t local = m_local[step % NETWORK_HISTORY];
+    for (unsigned int pass = 0; pass < 2; ++pass)
+    {
+        for (unsigned int i = 0; i < m_keys.size(); ++i)
+        {
+            uint8_t buttons = i / PLAYER_BUTTONS == m_local_player ? local : remote;
+            bool on = buttons >> (i % PLAYER_BUTTONS) & 1;
+            if (pass == 0 && !on && m_world_input->IsKeyOn(m_keys[i]))
+                m_world_input->TurnKeyOff(m_keys[i]);
+            else if (pass == 1 && on && !m_world_input->IsKeyOn(m_keys[i]))
+                m_world_input->TurnKeyOn(m_keys[i]);
+        }
+    }
+
+    m_world->Update();
+}
+
+long RollbackSession::StepsAhead() const
+{
+    // Both sides see the other behind by the one way latency, so half the
+    // difference of the two views is how far this side is really ahead
+    long ahead = ((m_step - m_remote_step) - m_remote_ahead) / 2;
+    return ahead > 1 ? ahead / 2 : 0;
+}
+
+void RollbackSession::MakeChecksums()
+{
+    while (m_checksum_next <= m_remote_confirmed + 1 && m_checksum_next < m_step)
+    {
+        unsigned int index = (m_checksum_next / NETWORK_CHECKSUM_INTERVAL) % NETWORK_CHECKSUMS;
+        m_checksum_steps[index] = m_checksum_next;
+        m_checksums[index] = m_states[m_checksum_next % NETWORK_HISTORY].Checksum();
+        if (m_remote_checksum_step == m_checksum_next)
+            CompareChecksum(m_remote_checksum_step, m_remote_checksum);
+        m_checksum_next += NETWORK_CHECKSUM_INTERVAL;
+    }
+}
+
+void RollbackSession::CompareChecksum(long step, uint32_t checksum)
+{
+    if (step <= m_compared_step)
+        return;
+
+    unsigned int index = (step / NETWORK_CHECKSUM_INTERVAL) % NETWORK_CHECKSUMS;
+    if (m_checksum_steps[index] == step)
+    {
+        m_compared_step = step;
+        ++m_compared_checksums;
+        if (m_checksums[index] != checksum)
+            ++m_desyncs;
+    }
+    else
+    {
+        m_remote_checksum_step = step;
+        m_remote_checksum = checksum;
+    }
+}
@@ -0,0 +1,257 @@
+#include "Network/SnapshotDelta.h"
+#include <algorithm>
+
+static const unsigned int KIND_BITS = 4;
+static const unsigned int EXTRA_BITS = 8;
+static const unsigned int NEAR_BITS = 4; // signed pixels moved since the base
+static const int NEAR = 1 << (NEAR_BITS - 1);
+
+/** \brief Number of bits a tile and a pixel position take on the map */
+struct Sizes
+{
+    unsigned int tile;
+    unsigned int x;
+    unsigned int y;
+
+    explicit Sizes(const WorldSnapshot& snapshot)
+        : tile(BitsFor(snapshot.width * snapshot.height)),
+          x(BitsFor(snapshot.width * snapshot.tile_size)),
+          y(BitsFor(snapshot.height * snapshot.tile_size))
+    {
+    }
+};
+
+static void WriteMovers(const std::vector<WorldSnapshot::Mover>* base,
+                        const std::vector<WorldSnapshot::Mover>& movers,
+                        const Sizes& sizes, BitWriter& out)
+{
+    out.WriteVarying(movers.size());
+    for (unsigned int i = 0; i < movers.size(); ++i)
+    {
+        const WorldSnapshot::Mover& mover = movers[i];
+        if (base != nullptr && i < base->size())
+        {
+            const WorldSnapshot::Mover& old = (*base)[i];
+            if (mover == old)
+            {
+                out.Write(0, 1);
+                continue;
+            }
+            out.Write(1, 1);
+
+            int dx = (int)mover.x - old.x;
+            int dy = (int)mover.y - old.y;
+            bool near = mover.kind == old.kind && dx >= -NEAR && dx < NEAR && dy >= -NEAR && dy < NEAR;
+            out.Write(near, 1);
+            if (near)
+            {
+                out.Write(dx + NEAR, NEAR_BITS);
+                out.Write(dy + NEAR, NEAR_BITS);
+                out.Write(mover.extra != old.extra, 1);
+                if (mover.extra != old.extra)
+                    out.Write(mover.extra, EXTRA_BITS);
+                continue;
+            }
+        }
+        out.Write(mover.x, sizes.x);
+        out.Write(mover.y, sizes.y);
+        out.Write(mover.kind, KIND_BITS);
+        out.Write(mover.extra, EXTRA_BITS);
+    }
+}
+
+static bool ReadMovers(const std::vector<WorldSnapshot::Mover>* base,
+                       std::vector<WorldSnapshot::Mover>& movers,
+                       const Sizes& sizes, BitReader& in)
+{
+    // Every entry takes at least one bit, more means broken bits
+    uint32_t count = in.ReadVarying();
+    if (in.Failed() || count > in.GetRemaining())
+        return false;
+    movers.resize(count);
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        WorldSnapshot::Mover& mover = movers[i];
+        if (base != nullptr && i < base->size())
+        {
+            const WorldSnapshot::Mover& old = (*base)[i];
+            mover = old;
+            if (!in.Read(1))
+                continue;
+            if (in.Read(1))
+            {
+                mover.x = old.x + (int)in.Read(NEAR_BITS) - NEAR;
+                mover.y = old.y + (int)in.Read(NEAR_BITS) - NEAR;
+                if (in.Read(1))
+                    mover.extra = in.Read(EXTRA_BITS);
+                continue;
+            }
+        }
+        mover.x = in.Read(sizes.x);
+        mover.y = in.Read(sizes.y);
+        mover.kind = in.Read(KIND_BITS);
+        mover.extra = in.Read(EXTRA_BITS);
+    }
+    return !in.Failed();
+}
+
+// Both lists are sorted, so one walk over them finds the entries of the
+// base which are gone and the new ones
+template <typename Removed, typename Added>
+static void Compare(const std::vector<WorldSnapshot::Marker>& old,
+                    const std::vector<WorldSnapshot::Marker>& markers,
+                    Removed removed, Added added)
+{
+    unsigned int i = 0, j = 0;
+    while (i < old.size() || j < markers.size())
+    {
+        if (i < old.size() && j < markers.size() && old[i] == markers[j])
+        {
+            ++i;
+            ++j;
+        }
+        else if (j == markers.size() || (i < old.size() && old[i] < markers[j]))
+            removed(i++);
+        else
+            added(j++);
+    }
+}
+
+static void WriteMarkers(const std::vector<WorldSnapshot::Marker>* base,
+                         const std::vector<WorldSnapshot::Marker>& markers,
+                         const Sizes& sizes, BitWriter& out)
+{
+    static const std::vector<WorldSnapshot::Marker> none;
+    const std::vector<WorldSnapshot::Marker>& old = base != nullptr ? *base : none;
+    unsigned int index_bits = BitsFor(old.size());
+
+    uint32_t removed = 0, added = 0;
+    Compare(old, markers, [&](unsigned int) { ++removed; }, [&](unsigned int) { ++added; });
+    out.WriteVarying(removed);
+    Compare(old, markers, [&](unsigned int i) { out.Write(i, index_bits); }, [](unsigned int) {});
+    out.WriteVarying(added);
+    Compare(old, markers, [](unsigned int) {}, [&](unsigned int j)
+    {
+        out.Write(markers[j].tile, sizes.tile);
+        out.Write(markers[j].kind, EXTRA_BITS);
+    });
+}
+
+static bool ReadMarkers(const std::vector<WorldSnapshot::Marker>* base,
+                        std::vector<WorldSnapshot::Marker>& markers,
+                        const Sizes& sizes, BitReader& in)
+{
+    markers.clear();
+    unsigned int old_size = base != nullptr ? base->size() : 0;
+    unsigned int index_bits = BitsFor(old_size);
+
+    // Removed entries come in the order of the base, the others are kept
+    uint32_t removed = in.ReadVarying();
+    if (in.Failed() || removed > old_size)
+        return false;
+    unsigned int next = 0;
+    for (uint32_t k = 0; k < removed; ++k)
+    {
+        uint32_t index = in.Read(index_bits);
+        if (in.Failed() || index < next || index >= old_size)
+            return false;
+        markers.insert(markers.end(), base->begin() + next, base->begin() + index);
+        next = index + 1;
+    }
+    if (base != nullptr)
+        markers.insert(markers.end(), base->begin() + next, base->end());
+
+    uint32_t added = in.ReadVarying();
+    if (in.Failed() || added > in.GetRemaining() / (sizes.tile + EXTRA_BITS))
+        return false;
+    for (uint32_t k = 0; k < added; ++k)
+    {
+        uint32_t tile = in.Read(sizes.tile);
+        uint8_t kind = in.Read(EXTRA_BITS);
+        markers.push_back({tile, kind});
+    }
+    std::sort(markers.begin(), markers.end());
+    return !in.Failed();
+}
+
+bool SnapshotDelta::Fits(const WorldSnapshot& base, const WorldSnapshot& snapshot)
+{
+    return base.seed == snapshot.seed && base.width == snapshot.width &&
+           base.height == snapshot.height && base.tile_size == snapshot.tile_size &&
+           base.step <= snapshot.step && base.opened.size() <= snapshot.opened.size() &&
+           std::equal(base.opened.begin(), base.opened.end(), snapshot.opened.begin());
+}
+
+bool SnapshotDelta::Write(const WorldSnapshot* base, const WorldSnapshot& snapshot, BitWriter& out)
+{
+    if (base != nullptr && !Fits(*base, snapshot))
+        base = nullptr;
+
+    out.Write(base != nullptr, 1);
+    if (base != nullptr)
+        out.WriteVarying(snapshot.step - base->step);
+    else
+    {
+        out.Write(snapshot.seed & 0xFFFFFFFF, 32);
+        out.Write(snapshot.seed >> 32, 32);
+        out.Write(snapshot.step, 32);
+        out.Write(snapshot.width, 16);
+        out.Write(snapshot.height, 16);
+        out.Write(snapshot.tile_size, 16);
+    }
+
+    Sizes sizes(snapshot);
+    unsigned int first = base != nullptr ? base->opened.size() : 0;
+    out.WriteVarying(snapshot.opened.size() - first);
+    for (unsigned int i = first; i < snapshot.opened.size(); ++i)
+        out.Write(snapshot.opened[i], sizes.tile);
+
+    WriteMovers(base != nullptr ? &base->players : nullptr, snapshot.players, sizes, out);
+    WriteMovers(base != nullptr ? &base->enemies : nullptr, snapshot.enemies, sizes, out);
+    WriteMarkers(base != nullptr ? &base->bombs : nullptr, snapshot.bombs, sizes, out);
+    WriteMarkers(base != nullptr ? &base->explosions : nullptr, snapshot.explosions, sizes, out);
+    WriteMarkers(base != nullptr ? &base->pickups : nullptr, snapshot.pickups, sizes, out);
+    return base != nullptr;
+}
+
+bool SnapshotDelta::Read(const WorldSnapshot* base, BitReader& in, WorldSnapshot& snapshot)
+{
+    bool has_base = in.Read(1);
+    if (!has_base)
+        base = nullptr;
+    else if (base == nullptr)
+        return false;
+
+    if (base != nullptr)
+    {
+        snapshot.seed = base->seed;
+        snapshot.step = base->step + in.ReadVarying();
+        snapshot.width = base->width;
+        snapshot.height = base->height;
+        snapshot.tile_size = base->tile_size;
+        snapshot.opened.assign(base->opened.begin(), base->opened.end());
+    }
+    else
+    {
+        snapshot.seed = in.Read(32);
+        snapshot.seed |= (uint64_t)in.Read(32) << 32;
+        snapshot.step = in.Read(32);
+        snapshot.width = in.Read(16);
+        snapshot.height = in.Read(16);
+        snapshot.tile_size = in.Read(16);
+        snapshot.opened.clear();
+    }
+
+    Sizes sizes(snapshot);
+    uint32_t opened = in.ReadVarying();
+    if (in.Failed() || opened > (uint32_t)snapshot.width * snapshot.height)
+        return false;
+    for (uint32_t i = 0; i < opened; ++i)
+        snapshot.opened.push_back(in.Read(sizes.tile));
+
+    return ReadMovers(base != nullptr ? &base->players : nullptr, snapshot.players, sizes, in) &&
+           ReadMovers(base != nullptr ? &base->enemies : nullptr, snapshot.enemies, sizes, in) &&
+           ReadMarkers(base != nullptr ? &base->bombs : nullptr, snapshot.bombs, sizes, in) &&
+           ReadMarkers(base != nullptr ? &base->explosions : nullptr, snapshot.explosions, sizes, in) &&
+           ReadMarkers(base != nullptr ? &base->pickups : nullptr, snapshot.pickups, sizes, in);
+}
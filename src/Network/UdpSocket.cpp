@@ -0,0 +1,161 @@
+#include "Network/UdpSocket.h"
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstring>
+
+static uint64_t Milliseconds()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+UdpSocket::UdpSocket()
+    : m_socket(-1),
+      m_peer({0, 0}),
+      m_has_peer(false),
+      m_delay(0),
+      m_jitter(0),
+      m_loss(0),
+      m_random()
+{
+}
+
+UdpSocket::~UdpSocket()
+{
+    if (m_socket >= 0)
+        close(m_socket);
+}
+
+bool UdpSocket::Open(unsigned short local_port, const std::string& peer_host, unsigned short peer_port)
+{
+    struct in_addr peer;
+    if (inet_pton(AF_INET, peer_host.c_str(), &peer) != 1 || !Open(local_port))
+        return false;
+    m_peer.host = peer.s_addr;
+    m_peer.port = htons(peer_port);
+    m_has_peer = true;
+    return true;
+}
+
+bool UdpSocket::Open(unsigned short local_port)
+{
+    m_socket = socket(AF_INET, SOCK_DGRAM, 0);
+    if (m_socket < 0)
+        return false;
+
+    struct sockaddr_in local;
+    memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port = htons(local_port);
+    if (bind(m_socket, (struct sockaddr*)&local, sizeof(local)) < 0 ||
+        fcntl(m_socket, F_SETFL, fcntl(m_socket, F_GETFL, 0) | O_NONBLOCK) < 0)
+    {
+        close(m_socket);
+        m_socket = -1;
+        return false;
+    }
+    return true;
+}
+
+void UdpSocket::SetLatency(unsigned int delay, unsigned int jitter, unsigned int loss, uint64_t seed)
+{
+    m_delay = delay;
+    m_jitter = jitter;
+    m_loss = loss;
+    m_random = Random(seed);
+    m_held.assign(delay > 0 || jitter > 0 ? NETWORK_SHIM_PACKETS : 0, Held());
+}
+
+void UdpSocket::Send(const uint8_t* data, std::size_t size)
+{
+    SendTo(m_peer, data, size);
+}
+
+void UdpSocket::SendTo(const Address& to, const uint8_t* data, std::size_t size)
+{
+    if (size == 0 || size > NETWORK_PACKET_SIZE)
+        return;
+    if (m_loss > 0 && m_random.Below(100) < m_loss)
+        return;
+    if (m_held.empty())
+    {
+        SendNow(to, data, size);
+        return;
+    }
+
+    // A full shim sends the packet late rather than losing it
+    for (auto held = m_held.begin(); held != m_held.end(); ++held)
+    {
+        if (held->size == 0)
+        {
+            held->due = Milliseconds() + m_delay + (m_jitter > 0 ? m_random.Below(m_jitter + 1) : 0);
+            held->to = to;
+            held->size = size;
+            memcpy(held->data, data, size);
+            Flush();
+            return;
+        }
+    }
+    SendNow(to, data, size);
+}
+
+int UdpSocket::Receive(uint8_t* data, std::size_t capacity)
+{
+    Address from;
+    return ReceiveFrom(from, data, capacity);
+}
+
+int UdpSocket::ReceiveFrom(Address& from, uint8_t* data, std::size_t capacity)
+{
+    Flush();
+    if (m_socket < 0)
+        return -1;
+
+    while (true)
+    {
+        struct sockaddr_in sender;
+        socklen_t sender_size = sizeof(sender);
+        ssize_t size = recvfrom(m_socket, data, capacity, 0, (struct sockaddr*)&sender, &sender_size);
+        if (size < 0)
+            return -1;
+        from.host = sender.sin_addr.s_addr;
+        from.port = sender.sin_port;
+        if (!m_has_peer || from == m_peer)
+            return (int)size;
+    }
+}
+
+void UdpSocket::Flush()
+{
+    if (m_held.empty())
+        return;
+
+    uint64_t now = Milliseconds();
+    for (auto held = m_held.begin(); held != m_held.end(); ++held)
+    {
+        if (held->size > 0 && held->due <= now)
+        {
+            SendNow(held->to, held->data, held->size);
+            held->size = 0;
+        }
+    }
+}
+
+void UdpSocket::SendNow(const Address& to, const uint8_t* data, std::size_t size)
+{
+    if (m_socket < 0)
+        return;
+
+    struct sockaddr_in peer;
+    memset(&peer, 0, sizeof(peer));
+    peer.sin_family = AF_INET;
+    peer.sin_addr.s_addr = to.host;
+    peer.sin_port = to.port;
+    sendto(m_socket, data, size, 0, (struct sockaddr*)&peer, sizeof(peer));
+}
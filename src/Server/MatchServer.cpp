@@ -0,0 +1,359 @@
+#include "Server/MatchServer.h"
+#include "Network/SnapshotDelta.h"
+#include "Entity/Player.h"
+#include "Manager/PlayerManager.h"
+#include "Constants/WindowConstants.h"
+#include <algorithm>
+
+static const unsigned int PLAYER_BUTTONS = 5;
+
+MatchServer::MatchServer(unsigned int matches, unsigned int level, uint64_t seed,
+                         ThreadPool* pool, UdpSocket* socket)
+    : m_level(level),
+      m_next_seed(seed),
+      m_pool(pool),
+      m_socket(socket),
+      m_packet(NETWORK_PACKET_SIZE),
+      m_received(NETWORK_PACKET_SIZE),
+      m_view_header(SERVER_VIEW_HEADER),
+      m_step(0),
+      m_running(0),
+      m_match_steps(0),
+      m_restarts(0),
+      m_received_packets(0),
+      m_sent_packets(0),
+      m_sent_views(0),
+      m_view_bytes(0),
+      m_dropped_views(0)
+{
+    m_view_packet.reserve(NETWORK_PACKET_SIZE);
+    m_matches.reserve(matches);
+    for (unsigned int i = 0; i < matches; ++i)
+    {
+        m_matches.push_back(new Match());
+        Start(*m_matches.back());
+    }
+    if (!m_matches.empty())
+        m_matches.front()->world->GetInputKeys(m_keys);
+}
+
+MatchServer::~MatchServer()
+{
+    for (auto match = m_matches.begin(); match != m_matches.end(); ++match)
+    {
+        delete (*match)->world;
+        delete *match;
+    }
+}
+
+void MatchServer::Step()
+{
+    if (m_socket != nullptr)
+    {
+        Receive();
+        for (auto match = m_matches.begin(); match != m_matches.end(); ++match)
+        {
+            (*match)->running = false;
+            for (unsigned int player = 0; player < SERVER_MATCH_PLAYERS; ++player)
+            {
+                if ((*match)->joined[player] && m_step - (*match)->heard[player] > SERVER_CLIENT_TIMEOUT)
+                {
+                    (*match)->joined[player] = false;
+                    (*match)->buttons[player] = 0;
+                }
+                if ((*match)->joined[player])
+                    (*match)->running = true;
+            }
+
+            std::vector<Spectator>& spectators = (*match)->spectators;
+            for (unsigned int i = 0; i < spectators.size(); )
+            {
+                if (m_step - spectators[i].heard > SERVER_CLIENT_TIMEOUT)
+                {
+                    spectators[i] = spectators.back();
+                    spectators.pop_back();
+                }
+                else
+                    ++i;
+            }
+            if (!spectators.empty())
+                (*match)->running = true;
+        }
+    }
+
+    // Matches share nothing, so each runs on whichever thread takes it
+    m_pool->Run(m_matches.size(), [this](unsigned int i)
+    {
+        Match& match = *m_matches[i];
+        match.packed = 0;
+        if (!match.running)
+            return;
+        Simulate(match);
+        if (!match.spectators.empty() && match.timer.GetSteps() % SERVER_STATE_INTERVAL == 0)
+            Pack(match);
+    });
+    if (m_socket != nullptr)
+        SendViews();
+
+    // Making a World reads the level files, which is left to this thread
+    m_running = 0;
+    for (auto match = m_matches.begin(); match != m_matches.end(); ++match)
+    {
+        if (!(*match)->running)
+            continue;
+        ++m_running;
+        if ((*match)->world->PlayersDead() || (*match)->world->LevelCompleted())
+        {
+            Start(**match);
+            ++m_restarts;
+        }
+    }
+    m_match_steps += m_running;
+
+    ++m_step;
+    if (m_socket != nullptr && m_step % SERVER_STATE_INTERVAL == 0)
+        Send();
+}
+
+void MatchServer::SetButtons(unsigned int match, unsigned int player, uint8_t buttons)
+{
+    if (match < m_matches.size() && player < SERVER_MATCH_PLAYERS)
+        m_matches[match]->buttons[player] = buttons;
+}
+
+unsigned int MatchServer::GetSpectators() const
+{
+    unsigned int spectators = 0;
+    for (auto match = m_matches.begin(); match != m_matches.end(); ++match)
+        spectators += (*match)->spectators.size();
+    return spectators;
+}
+
+unsigned int MatchServer::GetClients() const
+{
+    unsigned int clients = 0;
+    for (auto match = m_matches.begin(); match != m_matches.end(); ++match)
+        for (unsigned int player = 0; player < SERVER_MATCH_PLAYERS; ++player)
+            if ((*match)->joined[player])
+                ++clients;
+    return clients;
+}
+
+void MatchServer::Start(Match& match)
+{
+    delete match.world;
+    for (auto key = m_keys.begin(); key != m_keys.end(); ++key)
+        if (match.input.IsKeyOn(*key))
+            match.input.TurnKeyOff(*key);
+    match.timer.SetSteps(0);
+    match.seed = m_next_seed++;
+    match.world = new World(nullptr, MAP_TILE_SIZE, SERVER_MATCH_PLAYERS, m_level,
+                            &match.input, match.seed, &match.timer);
+    match.running = m_socket == nullptr;
+}
+
+void MatchServer::Simulate(Match& match)
+{
+    match.timer.Step();
+
+    // Releases go first, as pressing a direction releases the others
+    for (unsigned int pass = 0; pass < 2; ++pass)
+    {
+        for (unsigned int i = 0; i < m_keys.size(); ++i)
+        {
+            bool on = match.buttons[i / PLAYER_BUTTONS] >> (i % PLAYER_BUTTONS) & 1;
+            if (pass == 0 && !on && match.input.IsKeyOn(m_keys[i]))
+                match.input.TurnKeyOff(m_keys[i]);
+            else if (pass == 1 && on && !match.input.IsKeyOn(m_keys[i]))
+                match.input.TurnKeyOn(m_keys[i]);
+        }
+    }
+
+    match.world->Update();
+}
+
+void MatchServer::Receive()
+{
+    UdpSocket::Address from;
+    int size;
+    while ((size = m_socket->ReceiveFrom(from, m_received.data(), m_received.size())) > 0)
+    {
+        m_packet.Assign(m_received.data(), size);
+        uint32_t magic;
+        uint16_t match_number;
+        uint8_t player, buttons;
+        m_packet.Read(magic);
+        m_packet.Read(match_number);
+        if (magic == SERVER_WATCH_MAGIC)
+        {
+            uint64_t seed;
+            uint32_t step;
+            m_packet.Read(seed);
+            m_packet.Read(step);
+            if (!m_packet.Failed() && match_number < m_matches.size())
+            {
+                Watch(*m_matches[match_number], from, seed, step);
+                ++m_received_packets;
+            }
+            continue;
+        }
+        m_packet.Read(player);
+        m_packet.Read(buttons);
+        if (m_packet.Failed() || magic != SERVER_CLIENT_MAGIC ||
+            match_number >= m_matches.size() || player >= SERVER_MATCH_PLAYERS)
+            continue;
+
+        // A taken seat stays with its client until it goes quiet
+        Match& match = *m_matches[match_number];
+        if (match.joined[player] && !(match.clients[player] == from))
+            continue;
+        match.joined[player] = true;
+        match.clients[player] = from;
+        match.heard[player] = m_step;
+        match.buttons[player] = buttons;
+        ++m_received_packets;
+    }
+}
+
+void MatchServer::Send()
+{
+    for (unsigned int i = 0; i < m_matches.size(); ++i)
+    {
+        Match& match = *m_matches[i];
+        if (!match.running)
+            continue;
+
+        PlayerManager* player_manager = match.world->GetRelay()->GetPlayerManager();
+        m_packet.Clear();
+        m_packet.Write(SERVER_STATE_MAGIC);
+        m_packet.Write((uint16_t)i);
+        m_packet.Write((uint64_t)match.seed);
+        m_packet.Write((uint32_t)match.timer.GetSteps());
+        m_packet.Write((uint8_t)player_manager->GetPlayersNumber());
+        for (unsigned int player = 0; player < player_manager->GetPlayersNumber(); ++player)
+        {
+            Player* p = player_manager->GetPlayerById(player);
+            m_packet.Write((uint16_t)p->GetX());
+            m_packet.Write((uint16_t)p->GetY());
+            m_packet.Write((uint8_t)p->GetLives());
+            m_packet.Write((uint8_t)p->IsAlive());
+        }
+
+        for (unsigned int player = 0; player < SERVER_MATCH_PLAYERS; ++player)
+        {
+            if (!match.joined[player])
+                continue;
+            m_socket->SendTo(match.clients[player], m_packet.GetData(), m_packet.GetSize());
+            ++m_sent_packets;
+        }
+    }
+}
+
+void MatchServer::Watch(Match& match, const UdpSocket::Address& from, uint64_t seed, uint32_t step)
+{
+    Spectator* spectator = nullptr;
+    for (auto i = match.spectators.begin(); i != match.spectators.end(); ++i)
+        if (i->address == from)
+            spectator = &*i;
+
+    if (spectator == nullptr)
+    {
+        if (match.spectators.size() >= SERVER_MAX_SPECTATORS)
+            return;
+        // Room for every spectator is made with the first one
+        if (match.snapshots.empty())
+        {
+            match.spectators.reserve(SERVER_MAX_SPECTATORS);
+            match.snapshots.resize(SERVER_SNAPSHOTS);
+            match.views.resize(SERVER_SNAPSHOTS + 1);
+        }
+        match.spectators.push_back({from, 0, SERVER_NO_BASE, m_step, 0});
+        spectator = &match.spectators.back();
+    }
+
+    spectator->heard = m_step;
+    if (step != SERVER_NO_BASE && (seed != spectator->acked_seed ||
+                                   spectator->acked_step == SERVER_NO_BASE || step > spectator->acked_step))
+    {
+        spectator->acked_seed = seed;
+        spectator->acked_step = step;
+    }
+}
+
+void MatchServer::Pack(Match& match)
+{
+    uint32_t step = match.timer.GetSteps();
+    WorldSnapshot& snapshot = match.snapshots[step / SERVER_STATE_INTERVAL % SERVER_SNAPSHOTS];
+    match.world->TakeSnapshot(snapshot);
+
+    for (auto spectator = match.spectators.begin(); spectator != match.spectators.end(); ++spectator)
+    {
+        // The base must still be kept and be of the same match
+        const WorldSnapshot* base = nullptr;
+        uint32_t base_step = SERVER_NO_BASE;
+        if (spectator->acked_step != SERVER_NO_BASE)
+        {
+            const WorldSnapshot& acked = match.snapshots[spectator->acked_step / SERVER_STATE_INTERVAL % SERVER_SNAPSHOTS];
+            if (&acked != &snapshot && acked.step == spectator->acked_step && acked.seed == spectator->acked_seed)
+            {
+                base = &acked;
+                base_step = spectator->acked_step;
+            }
+        }
+
+        unsigned int view = 0;
+        while (view < match.packed && match.views[view].base_step != base_step)
+            ++view;
+        if (view == match.packed)
+        {
+            View& packed = match.views[match.packed++];
+            packed.base_step = base_step;
+            packed.step = step;
+            packed.bits.Clear();
+            SnapshotDelta::Write(base, snapshot, packed.bits);
+        }
+        spectator->view = view;
+    }
+}
+
+void MatchServer::SendViews()
+{
+    for (unsigned int number = 0; number < m_matches.size(); ++number)
+    {
+        Match& match = *m_matches[number];
+        if (match.packed == 0)
+            continue;
+        for (auto spectator = match.spectators.begin(); spectator != match.spectators.end(); ++spectator)
+        {
+            const View& view = match.views[spectator->view];
+            unsigned int parts = (view.bits.GetSize() + SERVER_VIEW_PART_SIZE - 1) / SERVER_VIEW_PART_SIZE;
+            if (parts > SERVER_VIEW_PARTS)
+            {
+                ++m_dropped_views;
+                continue;
+            }
+            for (unsigned int part = 0; part < parts; ++part)
+                SendPart(spectator->address, number, view, part, parts);
+            ++m_sent_views;
+        }
+    }
+}
+
+void MatchServer::SendPart(const UdpSocket::Address& to, unsigned int number, const View& view,
+                           unsigned int part, unsigned int parts)
+{
+    m_view_header.Clear();
+    m_view_header.Write(SERVER_VIEW_MAGIC, 32);
+    m_view_header.Write(number, 16);
+    m_view_header.Write(view.base_step, 32);
+    m_view_header.Write(view.step, 32);
+    m_view_header.Write(part, 8);
+    m_view_header.Write(parts, 8);
+
+    const uint8_t* data = view.bits.GetData() + part * SERVER_VIEW_PART_SIZE;
+    std::size_t size = std::min<std::size_t>(view.bits.GetSize() - part * SERVER_VIEW_PART_SIZE, SERVER_VIEW_PART_SIZE);
+    m_view_packet.assign(m_view_header.GetData(), m_view_header.GetData() + m_view_header.GetSize());
+    m_view_packet.insert(m_view_packet.end(), data, data + size);
+    m_socket->SendTo(to, m_view_packet.data(), m_view_packet.size());
+    m_view_bytes += m_view_packet.size();
+}
@@ -0,0 +1,184 @@
+#include "Simulation/InputRecording.h"
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+InputRecording::InputRecording()
+    : m_level(0),
+      m_players(0),
+      m_seed(0),
+      m_steps(0),
+      m_play_run(0),
+      m_play_start(0),
+      m_play_step(0)
+{
+}
+
+InputRecording::InputRecording(unsigned int level, unsigned int players, uint64_t seed,
+                               const std::vector<SDL_Keycode>& keys)
+    : m_level(level),
+      m_players(players),
+      m_seed(seed),
+      m_keys(keys),
+      m_steps(0),
+      m_play_run(0),
+      m_play_start(0),
+      m_play_step(0)
+{
+    if (m_keys.size() > 32)
+        m_keys.resize(32);
+    m_runs.reserve(1024);
+    m_checks.reserve(1024);
+}
+
+bool InputRecording::Load(const std::string& path_to_file)
+{
+    std::fstream fs;
+    fs.open(path_to_file, std::fstream::in);
+
+    if (!fs.is_open())
+        return false;
+
+    m_keys.clear();
+    m_runs.clear();
+    m_checks.clear();
+    m_steps = 0;
+    m_play_run = 0;
+    m_play_start = 0;
+    m_play_step = 0;
+
+    unsigned long steps = 0;
+    std::string line;
+    while (std::getline(fs, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::stringstream convert(line);
+        std::string name;
+        convert >> name;
+        if (name == "level")
+            convert >> m_level;
+        else if (name == "players")
+            convert >> m_players;
+        else if (name == "seed")
+            convert >> m_seed;
+        else if (name == "steps")
+            convert >> steps;
+        else if (name == "keys")
+        {
+            SDL_Keycode key;
+            while (m_keys.size() < 32 && convert >> key)
+                m_keys.push_back(key);
+        }
+        else if (name == "check")
+        {
+            Check check;
+            if (!(convert >> check.steps >> check.checksum))
+                return false;
+            if (!m_checks.empty() && check.steps <= m_checks.back().steps)
+                return false;
+            m_checks.push_back(check);
+        }
+        else
+        {
+            std::stringstream run_convert(line);
+            Run run;
+            if (!(run_convert >> run.length >> run.bits))
+                return false;
+            m_runs.push_back(run);
+            m_steps += run.length;
+        }
+    }
+
+    fs.close();
+    return m_level != 0 && m_players != 0 && m_steps == steps;
+}
+
+bool InputRecording::Save(const std::string& path_to_file) const
+{
+    std::fstream fs;
+    fs.open(path_to_file, std::fstream::out | std::fstream::trunc);
+
+    if (!fs.is_open())
+        return false;
+
+    fs << "# bomberman input recording\n";
+    fs << "level " << m_level << "\n";
+    fs << "players " << m_players << "\n";
+    fs << "seed " << m_seed << "\n";
+    fs << "steps " << m_steps << "\n";
+    fs << "keys";
+    for (auto key = m_keys.begin(); key != m_keys.end(); ++key)
+        fs << " " << *key;
+    fs << "\n";
+    for (auto run = m_runs.begin(); run != m_runs.end(); ++run)
+        fs << run->length << " " << run->bits << "\n";
+    for (auto check = m_checks.begin(); check != m_checks.end(); ++check)
+        fs << "check " << check->steps << " " << check->checksum << "\n";
+
+    fs.close();
+    return !fs.fail();
+}
+
+void InputRecording::Record(KeyboardInput* input)
+{
+    uint32_t bits = 0;
+    for (unsigned int i = 0; i < m_keys.size(); ++i)
+        if (input->IsKeyOn(m_keys[i]))
+            bits |= (uint32_t)1 << i;
+
+    if (!m_runs.empty() && m_runs.back().bits == bits)
+        ++m_runs.back().length;
+    else
+        m_runs.push_back({1, bits});
+    ++m_steps;
+}
+
+void InputRecording::Play(unsigned long step, KeyboardInput* input)
+{
+    if (step < m_play_step)
+    {
+        m_play_run = 0;
+        m_play_start = 0;
+    }
+    m_play_step = step;
+
+    while (m_play_run < m_runs.size() && m_play_start + m_runs[m_play_run].length <= step)
+    {
+        m_play_start += m_runs[m_play_run].length;
+        ++m_play_run;
+    }
+
+    SetButtons(m_play_run < m_runs.size() ? m_runs[m_play_run].bits : 0, input);
+}
+
+void InputRecording::AddChecksum(unsigned long steps, uint32_t checksum)
+{
+    if (!m_checks.empty() && m_checks.back().steps == steps)
+        m_checks.back() = {steps, checksum};
+    else
+        m_checks.push_back({steps, checksum});
+}
+
+bool InputRecording::GetChecksum(unsigned long steps, uint32_t& checksum) const
+{
+    auto check = std::lower_bound(m_checks.begin(), m_checks.end(), steps,
+                                  [](const Check& c, unsigned long s) { return c.steps < s; });
+    if (check == m_checks.end() || check->steps != steps)
+        return false;
+    checksum = check->checksum;
+    return true;
+}
+
+void InputRecording::SetButtons(uint32_t bits, KeyboardInput* input) const
+{
+    // Releases go first, pressing a direction releases the other directions
+    // which the recording never holds together anyway
+    for (unsigned int i = 0; i < m_keys.size(); ++i)
+        if (!(bits >> i & 1) && input->IsKeyOn(m_keys[i]))
+            input->TurnKeyOff(m_keys[i]);
+    for (unsigned int i = 0; i < m_keys.size(); ++i)
+        if ((bits >> i & 1) && !input->IsKeyOn(m_keys[i]))
+            input->TurnKeyOn(m_keys[i]);
+}
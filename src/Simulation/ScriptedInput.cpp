@@ -0,0 +1,68 @@
+#include "Simulation/ScriptedInput.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+
+ScriptedInput::ScriptedInput()
+    : KeyboardInput(),
+      m_next_event(0)
+{
+}
+
+ScriptedInput::ScriptedInput(std::string path_to_file)
+    : KeyboardInput(),
+      m_next_event(0)
+{
+    std::fstream fs;
+    fs.open(path_to_file, std::fstream::in);
+
+    if (!fs.is_open())
+    {
+        exit(EXIT_FAILURE);
+    }
+
+    std::string line;
+    while (std::getline(fs, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::stringstream convert(line);
+        unsigned long step;
+        SDL_Keycode key;
+        std::string action;
+        if (convert >> step >> key >> action)
+        {
+            AddEvent(step, key, action == "press");
+        }
+    }
+
+    fs.close();
+}
+
+void ScriptedInput::AddEvent(unsigned long step, SDL_Keycode key, bool pressed)
+{
+    Event event = {step, key, pressed};
+    auto position = std::upper_bound(m_events.begin() + m_next_event, m_events.end(), event,
+                                     [](const Event& a, const Event& b) { return a.step < b.step; });
+    m_events.insert(position, event);
+}
+
+void ScriptedInput::Apply(unsigned long step)
+{
+    while (m_next_event < m_events.size() && m_events[m_next_event].step <= step)
+    {
+        const Event& event = m_events[m_next_event];
+        if (event.pressed)
+            TurnKeyOn(event.key);
+        else
+            TurnKeyOff(event.key);
+        ++m_next_event;
+    }
+}
+
+bool ScriptedInput::Finished() const
+{
+    return m_next_event >= m_events.size();
+}
@@ -0,0 +1,187 @@
+#include "Simulation/World.h"
+
+#include "Manager/Map.h"
+#include "Manager/BombManager.h"
+#include "Manager/ExplosionManager.h"
+#include "Manager/PlayerManager.h"
+#include "Manager/EnemyManager.h"
+#include "Manager/PickUpManager.h"
+
+#include "System/SystemTimer.h"
+
+#include "Constants/ResourcesConstants.h"
+
+#include <string>
+#include <sstream>
+
+static const uint32_t STATE_TAG = 0x42534D57; // "WMSB", marks the start of a saved World
+
+World::World(SDL_Texture* texture,
+             unsigned int tile_size,
+             unsigned int players_number,
+             unsigned int current_level,
+             KeyboardInput* keyboard_input,
+             uint64_t seed,
+             SystemTimer* system_timer)
+    : m_random(seed)
+{
+    m_display_elements.reserve(6);
+    m_relay = new Relay();
+    m_relay->SetKeyboardInput(keyboard_input);
+    if (system_timer != nullptr)
+        m_relay->SetSystemTimer(system_timer);
+
+    std::string level_num;
+    std::stringstream convert;
+    convert << current_level;
+    level_num = convert.str();
+
+    std::string path_level = RESOURCES_LEVELS_PATH + RESOURCES_LEVEL_MAP + level_num + RESOURCES_LEVEL_MAP_EXT;
+    std::string path_player = RESOURCES_LEVELS_PATH + RESOURCES_LEVEL_PLAYER + level_num + RESOURCES_LEVEL_PLAYER_EXT;
+    std::string path_enemy = RESOURCES_LEVELS_PATH + RESOURCES_LEVEL_ENEMY + level_num + RESOURCES_LEVEL_ENEMY_EXT;
+
+    Map* level = new Map(path_level, texture, tile_size, m_relay, m_random);
+    m_relay->SetMap(level);
+    ExplosionManager* explosion_manager = new ExplosionManager(texture, tile_size, m_relay);
+    BombManager* bomb_manager = new BombManager(texture, tile_size, m_relay);
+    PlayerManager* player_manager = new PlayerManager(path_player, texture, tile_size, m_relay, players_number);
+    if (players_number>1)
+        player_manager->GetPlayerById(1)->SetKeycodes(SDLK_w, SDLK_s, SDLK_a, SDLK_d, SDLK_g);
+    EnemyManager* enemy_manager = new EnemyManager(path_enemy, texture, tile_size, m_relay, m_random);
+    PickUpManager* pickup_manager = new PickUpManager(texture,tile_size,level->GetHeight()*level->GetWidth(),m_relay);
+
+    m_relay->SetExplosionManager(explosion_manager);
+    m_relay->SetBombManager(bomb_manager);
+    m_relay->SetPlayerManager(player_manager);
+    m_relay->SetEnemyManager(enemy_manager);
+    m_relay->SetPickUpManager(pickup_manager);
+
+    AddDisplayElement(level);
+    AddDisplayElement(pickup_manager);
+    AddDisplayElement(bomb_manager);
+    AddDisplayElement(player_manager);
+    AddDisplayElement(enemy_manager);
+    AddDisplayElement(explosion_manager);
+}
+
+World::~World()
+{
+    for (auto i = m_display_elements.begin(); i != m_display_elements.end(); ++i)
+    {
+        delete (*i);
+    }
+    m_display_elements.clear();
+    delete m_relay;
+}
+
+void World::AddDisplayElement(DisplayElement* display_element)
+{
+    m_display_elements.push_back(display_element);
+}
+
+void World::Update()
+{
+    for (auto i = m_display_elements.begin(); i != m_display_elements.end(); ++i)
+    {
+        (*i)->Update();
+    }
+}
+
+void World::Draw(RenderSnapshot& snapshot) const
+{
+    for (auto i = m_display_elements.cbegin(); i != m_display_elements.cend(); ++i)
+    {
+        (*i)->Draw(snapshot);
+    }
+}
+
+bool World::PlayersDead() const
+{
+    return m_relay->PlayersDead();
+}
+
+bool World::LevelCompleted() const
+{
+    return m_relay->LevelCompleted();
+}
+
+Relay* World::GetRelay() const
+{
+    return m_relay;
+}
+
+void World::GetInputKeys(std::vector<SDL_Keycode>& keys) const
+{
+    for (PlayerManager::Iterator it(m_relay->GetPlayerManager()); !it.Finished(); ++it)
+    {
+        SDL_Keycode up, down, left, right, bomb_button;
+        it.GetPlayer().GetKeycodes(up, down, left, right, bomb_button);
+        keys.push_back(up);
+        keys.push_back(down);
+        keys.push_back(left);
+        keys.push_back(right);
+        keys.push_back(bomb_button);
+    }
+}
+
+void World::SaveState(StateBuffer& state) const
+{
+    const Map* map = m_relay->GetMap();
+    state.Clear();
+    state.Write(STATE_TAG);
+    state.Write(map->GetHeight());
+    state.Write(map->GetWidth());
+    state.Write(m_relay->GetPlayerManager()->GetPlayersNumber());
+    state.Write(m_relay->GetSystemTimer()->GetSteps());
+
+    // The Map goes first, bombs work out their reach over it when loaded
+    map->SaveState(state);
+    m_relay->GetPickUpManager()->SaveState(state);
+    m_relay->GetBombManager()->SaveState(state);
+    m_relay->GetPlayerManager()->SaveState(state);
+    m_relay->GetEnemyManager()->SaveState(state);
+    m_relay->GetExplosionManager()->SaveState(state);
+}
+
+bool World::LoadState(StateBuffer& state)
+{
+    Map* map = m_relay->GetMap();
+    uint32_t tag = 0;
+    unsigned int height = 0;
+    unsigned int width = 0;
+    unsigned int players = 0;
+    unsigned long steps = 0;
+    state.Rewind();
+    state.Read(tag);
+    state.Read(height);
+    state.Read(width);
+    state.Read(players);
+    state.Read(steps);
+    if (state.Failed() || tag != STATE_TAG || height != map->GetHeight() || width != map->GetWidth() ||
+        players != m_relay->GetPlayerManager()->GetPlayersNumber())
+        return false;
+
+    m_relay->GetSystemTimer()->SetSteps(steps);
+    map->LoadState(state);
+    m_relay->GetPickUpManager()->LoadState(state);
+    m_relay->GetBombManager()->LoadState(state);
+    m_relay->GetPlayerManager()->LoadState(state);
+    m_relay->GetEnemyManager()->LoadState(state);
+    m_relay->GetExplosionManager()->LoadState(state);
+    return !state.Failed();
+}
+
+void World::TakeSnapshot(WorldSnapshot& snapshot) const
+{
+    snapshot.Clear();
+    snapshot.seed = GetSeed();
+    snapshot.step = m_relay->GetSystemTimer()->GetSteps();
+
+    // The Map goes first, the others find their tiles from its size
+    m_relay->GetMap()->TakeSnapshot(snapshot);
+    m_relay->GetPlayerManager()->TakeSnapshot(snapshot);
+    m_relay->GetEnemyManager()->TakeSnapshot(snapshot);
+    m_relay->GetBombManager()->TakeSnapshot(snapshot);
+    m_relay->GetExplosionManager()->TakeSnapshot(snapshot);
+    m_relay->GetPickUpManager()->TakeSnapshot(snapshot);
+}
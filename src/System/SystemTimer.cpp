@@ -1,11 +1,10 @@
 #include "System/SystemTimer.h"
-#include <SDL2/SDL.h>
+#include "Constants/SimulationConstants.h"
 
 SystemTimer* SystemTimer::s_instance;
 
 SystemTimer::SystemTimer()
-    : m_past_ticks(SDL_GetTicks()),
-      m_paused_ticks(m_past_ticks),
+    : m_ticks(0),
       m_paused(false)
 {
 }
@@ -18,40 +17,25 @@ SystemTimer* SystemTimer::Instance()
     return s_instance;
 }
 
-void SystemTimer::ResetTimer()
-{
-    m_past_ticks = SDL_GetTicks();
-}
-
-void SystemTimer::DecreaseTimer(unsigned long interval)
+unsigned long SystemTimer::GetTimeElapsed() const
 {
-    m_past_ticks += interval;
+    return m_ticks * SIMULATION_STEP_LENGTH;
 }
 
-unsigned long SystemTimer::GetTimeElapsed() const
+void SystemTimer::Step()
 {
-    if (m_paused)
-        return m_paused_ticks - m_past_ticks;
-    else
-        return SDL_GetTicks() - m_past_ticks;
+    if (!m_paused)
+        ++m_ticks;
 }
 
 void SystemTimer::Pause()
 {
-    if (!m_paused)
-    {
-        m_paused_ticks = SDL_GetTicks();
-        m_paused = true;
-    }
+    m_paused = true;
 }
 
 void SystemTimer::Unpause()
 {
-    if (m_paused)
-    {
-        m_past_ticks = SDL_GetTicks() - (m_paused_ticks - m_past_ticks);
-        m_paused = false;
-    }
+    m_paused = false;
 }
 
 bool SystemTimer::IsPaused() const
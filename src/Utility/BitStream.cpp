@@ -0,0 +1,73 @@
+#include "Utility/BitStream.h"
+
+static const unsigned int VARYING_GROUP = 4;
+
+BitWriter::BitWriter(std::size_t capacity)
+    : m_bits(0)
+{
+    m_data.reserve(capacity);
+}
+
+void BitWriter::Clear()
+{
+    m_data.clear();
+    m_bits = 0;
+}
+
+void BitWriter::Write(uint32_t value, unsigned int bits)
+{
+    for (unsigned int i = 0; i < bits; ++i, ++m_bits)
+    {
+        if (m_bits % 8 == 0)
+            m_data.push_back(0);
+        if (value >> i & 1)
+            m_data.back() |= 1 << (m_bits % 8);
+    }
+}
+
+void BitWriter::WriteVarying(uint32_t value)
+{
+    do
+    {
+        Write(value & ((1 << VARYING_GROUP) - 1), VARYING_GROUP);
+        value >>= VARYING_GROUP;
+        Write(value != 0, 1);
+    }
+    while (value != 0);
+}
+
+BitReader::BitReader(const uint8_t* data, std::size_t size)
+    : m_data(data),
+      m_size(size),
+      m_bit(0),
+      m_failed(false)
+{
+}
+
+uint32_t BitReader::Read(unsigned int bits)
+{
+    if (bits > m_size * 8 - m_bit)
+    {
+        m_bit = m_size * 8;
+        m_failed = true;
+        return 0;
+    }
+
+    uint32_t value = 0;
+    for (unsigned int i = 0; i < bits; ++i, ++m_bit)
+        if (m_data[m_bit / 8] >> (m_bit % 8) & 1)
+            value |= (uint32_t)1 << i;
+    return value;
+}
+
+uint32_t BitReader::ReadVarying()
+{
+    uint32_t value = 0;
+    for (unsigned int shift = 0; shift < 32 && !m_failed; shift += VARYING_GROUP)
+    {
+        value |= Read(VARYING_GROUP) << shift;
+        if (!Read(1))
+            break;
+    }
+    return value;
+}
@@ -0,0 +1,69 @@
+#include "Utility/CollisionMask.h"
+
+CollisionMask::CollisionMask(unsigned int height, unsigned int width, unsigned int tile_size)
+    : m_height(height),
+      m_width(width),
+      m_tile_size(tile_size),
+      m_stride((width + 2 + 63) / 64),
+      m_bits((height + 2) * m_stride, 0)
+{
+}
+
+void CollisionMask::SetWalkable(unsigned int i, unsigned int j, bool walkable)
+{
+    if (i >= m_height || j >= m_width)
+        return;
+
+    unsigned int bit = j + 1;
+    uint64_t& word = m_bits[(i + 1)*m_stride + (bit >> 6)];
+    uint64_t mask = uint64_t(1) << (bit & 63);
+    if (walkable)
+        word |= mask;
+    else
+        word &= ~mask;
+}
+
+bool CollisionMask::CanMove(int x, int y, unsigned int w, unsigned int h, int dx, int dy) const
+{
+    unsigned int first_row = Row(Tile(y + dy));
+    unsigned int last_row = Row(Tile(y + dy + (int)h));
+    unsigned int first_bit = Column(Tile(x + dx));
+    unsigned int last_bit = Column(Tile(x + dx + (int)w));
+
+    unsigned int first_word = first_bit >> 6;
+    unsigned int last_word = last_bit >> 6;
+    uint64_t first_mask = ~uint64_t(0) << (first_bit & 63);
+    uint64_t last_mask = ~uint64_t(0) >> (63 - (last_bit & 63));
+
+    for (unsigned int row = first_row; row <= last_row; ++row)
+    {
+        const uint64_t* words = &m_bits[row*m_stride];
+        if (first_word == last_word)
+        {
+            uint64_t mask = first_mask & last_mask;
+            if ((words[first_word] & mask) != mask)
+                return false;
+        }
+        else
+        {
+            if ((words[first_word] & first_mask) != first_mask)
+                return false;
+            for (unsigned int k = first_word + 1; k < last_word; ++k)
+                if (words[k] != ~uint64_t(0))
+                    return false;
+            if ((words[last_word] & last_mask) != last_mask)
+                return false;
+        }
+    }
+    return true;
+}
+
+void CollisionMask::SaveState(StateBuffer& state) const
+{
+    state.WriteVector(m_bits);
+}
+
+void CollisionMask::LoadState(StateBuffer& state)
+{
+    state.ReadVector(m_bits);
+}
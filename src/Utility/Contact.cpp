@@ -0,0 +1,306 @@
+#include "Utility/Contact.h"
+
+#if !defined(CONTACT_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#define CONTACT_SSE2
+#include <emmintrin.h>
+#elif !defined(CONTACT_NO_SIMD) && defined(__aarch64__)
+#define CONTACT_NEON
+#include <arm_neon.h>
+#endif
+
+// Tests objects from first to n, the bits of their words must already be zero
+static bool CornersFrom(const Contact::Box& box, const unsigned int* x, const unsigned int* y,
+                        unsigned int w, unsigned int h, unsigned int first, unsigned int n, uint32_t* mask)
+{
+    uint32_t any = 0;
+    for (unsigned int i = first; i < n; ++i)
+    {
+        unsigned int left = x[i];
+        unsigned int top = y[i];
+        unsigned int right = left + w;
+        unsigned int bottom = top + h;
+        uint32_t left_in = box.left >= left && box.left <= right;
+        uint32_t right_in = box.right >= left && box.right <= right;
+        uint32_t top_in = box.top >= top && box.top <= bottom;
+        uint32_t bottom_in = box.bottom >= top && box.bottom <= bottom;
+        uint32_t hit = (left_in | right_in) & (top_in | bottom_in);
+        mask[i >> 5] |= hit << (i & 31);
+        any |= hit;
+    }
+    return any;
+}
+
+static bool PointsFrom(const Contact::Box& box, const unsigned int* x, const unsigned int* y,
+                       unsigned int first, unsigned int n, uint32_t* mask)
+{
+    uint32_t any = 0;
+    for (unsigned int i = first; i < n; ++i)
+    {
+        uint32_t hit = (x[i] >= box.left) & (x[i] <= box.right) & (y[i] >= box.top) & (y[i] <= box.bottom);
+        mask[i >> 5] |= hit << (i & 31);
+        any |= hit;
+    }
+    return any;
+}
+
+static void ClearMask(unsigned int n, uint32_t* mask)
+{
+    for (unsigned int i = 0; i < Contact::MaskWords(n); ++i)
+        mask[i] = 0;
+}
+
+// Adds the hits of four objects from first on, first does not have to be a
+// multiple of four so the bits can spill into the next word
+static inline void AddHits(uint32_t hits, unsigned int first, uint32_t* mask)
+{
+    uint64_t bits = (uint64_t)hits << (first & 31);
+    mask[first >> 5] |= (uint32_t)bits;
+    if (bits >> 32)
+        mask[(first >> 5) + 1] |= (uint32_t)(bits >> 32);
+}
+
+bool Contact::CornersScalar(const Box& box, const unsigned int* x, const unsigned int* y,
+                            unsigned int w, unsigned int h, unsigned int n, uint32_t* mask)
+{
+    ClearMask(n, mask);
+    return CornersFrom(box, x, y, w, h, 0, n, mask);
+}
+
+bool Contact::PointsScalar(const Box& box, const unsigned int* x, const unsigned int* y,
+                           unsigned int n, uint32_t* mask)
+{
+    ClearMask(n, mask);
+    return PointsFrom(box, x, y, 0, n, mask);
+}
+
+#if defined(CONTACT_SSE2)
+
+// SSE2 only compares signed numbers, flipping the top bit makes that unsigned
+static inline __m128i Flip(__m128i v)
+{
+    return _mm_xor_si128(v, _mm_set1_epi32((int)0x80000000u));
+}
+
+static inline __m128i Load(const unsigned int* p)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+bool Contact::Corners(const Box& box, const unsigned int* x, const unsigned int* y,
+                      unsigned int w, unsigned int h, unsigned int n, uint32_t* mask)
+{
+    ClearMask(n, mask);
+
+    const __m128i left = Flip(_mm_set1_epi32(box.left));
+    const __m128i right = Flip(_mm_set1_epi32(box.right));
+    const __m128i top = Flip(_mm_set1_epi32(box.top));
+    const __m128i bottom = Flip(_mm_set1_epi32(box.bottom));
+    const __m128i width = _mm_set1_epi32(w);
+    const __m128i height = _mm_set1_epi32(h);
+
+    auto test = [&](unsigned int first) -> uint32_t
+    {
+        __m128i x0 = Load(x + first);
+        __m128i y0 = Load(y + first);
+        __m128i x1 = Flip(_mm_add_epi32(x0, width));
+        __m128i y1 = Flip(_mm_add_epi32(y0, height));
+        x0 = Flip(x0);
+        y0 = Flip(y0);
+
+        // A corner misses when it is left of or right of the object
+        __m128i left_out = _mm_or_si128(_mm_cmpgt_epi32(x0, left), _mm_cmpgt_epi32(left, x1));
+        __m128i right_out = _mm_or_si128(_mm_cmpgt_epi32(x0, right), _mm_cmpgt_epi32(right, x1));
+        __m128i top_out = _mm_or_si128(_mm_cmpgt_epi32(y0, top), _mm_cmpgt_epi32(top, y1));
+        __m128i bottom_out = _mm_or_si128(_mm_cmpgt_epi32(y0, bottom), _mm_cmpgt_epi32(bottom, y1));
+        __m128i miss = _mm_or_si128(_mm_and_si128(left_out, right_out), _mm_and_si128(top_out, bottom_out));
+
+        return ~(uint32_t)_mm_movemask_ps(_mm_castsi128_ps(miss)) & 0xF;
+    };
+
+    uint32_t any = 0;
+    unsigned int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        uint32_t hits = test(i);
+        mask[i >> 5] |= hits << (i & 31);
+        any |= hits;
+    }
+    if (i == n)
+        return any;
+    if (n < 4)
+        return CornersFrom(box, x, y, w, h, i, n, mask);
+
+    // The last objects are tested by a group ending at n, objects tested twice
+    // just set their bits again
+    uint32_t hits = test(n - 4);
+    AddHits(hits, n - 4, mask);
+    return any | hits;
+}
+
+bool Contact::Points(const Box& box, const unsigned int* x, const unsigned int* y,
+                     unsigned int n, uint32_t* mask)
+{
+    ClearMask(n, mask);
+
+    const __m128i left = Flip(_mm_set1_epi32(box.left));
+    const __m128i right = Flip(_mm_set1_epi32(box.right));
+    const __m128i top = Flip(_mm_set1_epi32(box.top));
+    const __m128i bottom = Flip(_mm_set1_epi32(box.bottom));
+
+    auto test = [&](unsigned int first) -> uint32_t
+    {
+        __m128i px = Flip(Load(x + first));
+        __m128i py = Flip(Load(y + first));
+        __m128i miss = _mm_or_si128(_mm_or_si128(_mm_cmpgt_epi32(left, px), _mm_cmpgt_epi32(px, right)),
+                                    _mm_or_si128(_mm_cmpgt_epi32(top, py), _mm_cmpgt_epi32(py, bottom)));
+
+        return ~(uint32_t)_mm_movemask_ps(_mm_castsi128_ps(miss)) & 0xF;
+    };
+
+    uint32_t any = 0;
+    unsigned int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        uint32_t hits = test(i);
+        mask[i >> 5] |= hits << (i & 31);
+        any |= hits;
+    }
+    if (i == n)
+        return any;
+    if (n < 4)
+        return PointsFrom(box, x, y, i, n, mask);
+
+    // The last objects are tested by a group ending at n, objects tested twice
+    // just set their bits again
+    uint32_t hits = test(n - 4);
+    AddHits(hits, n - 4, mask);
+    return any | hits;
+}
+
+const char* Contact::GetPath()
+{
+    return "SSE2";
+}
+
+#elif defined(CONTACT_NEON)
+
+// Lane i of a compare result becomes bit i
+static inline uint32_t Bits(uint32x4_t hit)
+{
+    static const uint32_t weights[4] = {1, 2, 4, 8};
+    return vaddvq_u32(vandq_u32(hit, vld1q_u32(weights)));
+}
+
+bool Contact::Corners(const Box& box, const unsigned int* x, const unsigned int* y,
+                      unsigned int w, unsigned int h, unsigned int n, uint32_t* mask)
+{
+    ClearMask(n, mask);
+
+    const uint32x4_t left = vdupq_n_u32(box.left);
+    const uint32x4_t right = vdupq_n_u32(box.right);
+    const uint32x4_t top = vdupq_n_u32(box.top);
+    const uint32x4_t bottom = vdupq_n_u32(box.bottom);
+    const uint32x4_t width = vdupq_n_u32(w);
+    const uint32x4_t height = vdupq_n_u32(h);
+
+    auto test = [&](unsigned int first) -> uint32_t
+    {
+        uint32x4_t x0 = vld1q_u32(x + first);
+        uint32x4_t y0 = vld1q_u32(y + first);
+        uint32x4_t x1 = vaddq_u32(x0, width);
+        uint32x4_t y1 = vaddq_u32(y0, height);
+
+        uint32x4_t left_in = vandq_u32(vcgeq_u32(left, x0), vcleq_u32(left, x1));
+        uint32x4_t right_in = vandq_u32(vcgeq_u32(right, x0), vcleq_u32(right, x1));
+        uint32x4_t top_in = vandq_u32(vcgeq_u32(top, y0), vcleq_u32(top, y1));
+        uint32x4_t bottom_in = vandq_u32(vcgeq_u32(bottom, y0), vcleq_u32(bottom, y1));
+        uint32x4_t hit = vandq_u32(vorrq_u32(left_in, right_in), vorrq_u32(top_in, bottom_in));
+
+        return Bits(hit);
+    };
+
+    uint32_t any = 0;
+    unsigned int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        uint32_t hits = test(i);
+        mask[i >> 5] |= hits << (i & 31);
+        any |= hits;
+    }
+    if (i == n)
+        return any;
+    if (n < 4)
+        return CornersFrom(box, x, y, w, h, i, n, mask);
+
+    // The last objects are tested by a group ending at n, objects tested twice
+    // just set their bits again
+    uint32_t hits = test(n - 4);
+    AddHits(hits, n - 4, mask);
+    return any | hits;
+}
+
+bool Contact::Points(const Box& box, const unsigned int* x, const unsigned int* y,
+                     unsigned int n, uint32_t* mask)
+{
+    ClearMask(n, mask);
+
+    const uint32x4_t left = vdupq_n_u32(box.left);
+    const uint32x4_t right = vdupq_n_u32(box.right);
+    const uint32x4_t top = vdupq_n_u32(box.top);
+    const uint32x4_t bottom = vdupq_n_u32(box.bottom);
+
+    auto test = [&](unsigned int first) -> uint32_t
+    {
+        uint32x4_t px = vld1q_u32(x + first);
+        uint32x4_t py = vld1q_u32(y + first);
+        uint32x4_t hit = vandq_u32(vandq_u32(vcgeq_u32(px, left), vcleq_u32(px, right)),
+                                   vandq_u32(vcgeq_u32(py, top), vcleq_u32(py, bottom)));
+
+        return Bits(hit);
+    };
+
+    uint32_t any = 0;
+    unsigned int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        uint32_t hits = test(i);
+        mask[i >> 5] |= hits << (i & 31);
+        any |= hits;
+    }
+    if (i == n)
+        return any;
+    if (n < 4)
+        return PointsFrom(box, x, y, i, n, mask);
+
+    // The last objects are tested by a group ending at n, objects tested twice
+    // just set their bits again
+    uint32_t hits = test(n - 4);
+    AddHits(hits, n - 4, mask);
+    return any | hits;
+}
+
+const char* Contact::GetPath()
+{
+    return "NEON";
+}
+
+#else
+
+bool Contact::Corners(const Box& box, const unsigned int* x, const unsigned int* y,
+                      unsigned int w, unsigned int h, unsigned int n, uint32_t* mask)
+{
+    return CornersScalar(box, x, y, w, h, n, mask);
+}
+
+bool Contact::Points(const Box& box, const unsigned int* x, const unsigned int* y,
+                     unsigned int n, uint32_t* mask)
+{
+    return PointsScalar(box, x, y, n, mask);
+}
+
+const char* Contact::GetPath()
+{
+    return "scalar";
+}
+
+#endif
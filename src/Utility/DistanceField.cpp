@@ -0,0 +1,134 @@
+#include "Utility/DistanceField.h"
+#include "Manager/Map.h"
+#include <algorithm>
+
+// Neighbours in the order of DistanceField::Step, and the step leading back
+static const int s_di[4] = {0, 0, -1, 1};
+static const int s_dj[4] = {-1, 1, 0, 0};
+static const uint8_t s_back[4] = {DistanceField::RIGHT, DistanceField::LEFT, DistanceField::DOWN, DistanceField::UP};
+
+DistanceField::DistanceField(unsigned int height, unsigned int width)
+    : m_height(height),
+      m_width(width),
+      m_distance(height * width, UNREACHABLE),
+      m_step(height * width, NONE),
+      m_queue(height * width + 1),
+      m_queued(height * width, 0),
+      m_map_revision(0),
+      m_searched(false)
+{
+    m_goals.reserve(8);
+}
+
+bool DistanceField::Update(const Map& map, const std::vector<unsigned int>& goals)
+{
+    if (!m_searched || m_goals != goals)
+    {
+        Search(map, goals);
+        return true;
+    }
+
+    if (m_map_revision == map.GetRevision())
+        return false;
+
+    Repair(map);
+    m_map_revision = map.GetRevision();
+    return true;
+}
+
+void DistanceField::Search(const Map& map, const std::vector<unsigned int>& goals)
+{
+    m_goals = goals;
+    m_map_revision = map.GetRevision();
+    m_searched = true;
+
+    std::fill(m_distance.begin(), m_distance.end(), UNREACHABLE);
+    std::fill(m_step.begin(), m_step.end(), (uint8_t)NONE);
+    m_head = 0;
+    m_tail = 0;
+
+    for (auto goal = m_goals.begin(); goal != m_goals.end(); ++goal)
+    {
+        if (*goal < m_distance.size() && m_distance[*goal] == UNREACHABLE)
+        {
+            m_distance[*goal] = 0;
+            Push(*goal);
+        }
+    }
+
+    Relax(map);
+}
+
+void DistanceField::Repair(const Map& map)
+{
+    m_head = 0;
+    m_tail = 0;
+
+    // An opened tile is one step further than its closest neighbour
+    const std::vector<unsigned int>& opened = map.GetOpenedTiles();
+    for (unsigned long k = m_map_revision; k < opened.size(); ++k)
+    {
+        unsigned int tile = opened[k];
+        int i = tile / m_width;
+        int j = tile % m_width;
+        for (unsigned int d = 0; d < 4; ++d)
+        {
+            int ni = i + s_di[d];
+            int nj = j + s_dj[d];
+            if (!map.Walkable(ni, nj))
+                continue;
+
+            uint16_t distance = m_distance[ni*m_width + nj];
+            if (distance != UNREACHABLE && distance + 1 < m_distance[tile])
+            {
+                m_distance[tile] = distance + 1;
+                m_step[tile] = d;
+            }
+        }
+        if (m_distance[tile] != UNREACHABLE && !m_queued[tile])
+            Push(tile);
+    }
+
+    Relax(map);
+}
+
+void DistanceField::Relax(const Map& map)
+{
+    // A tile can be queued again after it is shortened once more, so the
+    // queue wraps around; it never holds a tile twice at the same time and
+    // has one slot more than there are tiles
+    unsigned int size = m_queue.size();
+    while (m_head != m_tail)
+    {
+        unsigned int tile = m_queue[m_head];
+        m_head = m_head + 1 == size ? 0 : m_head + 1;
+        m_queued[tile] = 0;
+
+        int i = tile / m_width;
+        int j = tile % m_width;
+        uint16_t distance = m_distance[tile] + 1;
+        for (unsigned int d = 0; d < 4; ++d)
+        {
+            int ni = i + s_di[d];
+            int nj = j + s_dj[d];
+            if (!map.Walkable(ni, nj))
+                continue;
+
+            unsigned int next = ni*m_width + nj;
+            if (m_distance[next] <= distance)
+                continue;
+
+            m_distance[next] = distance;
+            m_step[next] = s_back[d];
+            if (!m_queued[next])
+                Push(next);
+        }
+    }
+}
+
+void DistanceField::Push(unsigned int tile)
+{
+    m_queue[m_tail] = tile;
+    m_tail = m_tail + 1 == m_queue.size() ? 0 : m_tail + 1;
+    m_queued[tile] = 1;
+}
@@ -0,0 +1,25 @@
+#include "Utility/Random.h"
+
+// Spreads the bits of close numbers (seeds 1, 2, 3...) over the whole word
+static uint64_t Mix(uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+Random::Random(uint64_t seed, uint64_t stream)
+    : m_seed(seed),
+      m_state(0),
+      m_increment((stream << 1) | 1)
+{
+    Next();
+    m_state += Mix(seed);
+    Next();
+}
+
+Random Random::Derive(uint64_t id) const
+{
+    return Random(Mix(m_seed ^ Mix(id)), id);
+}
@@ -2,6 +2,8 @@
 //#include "Manager/ExplosionManager.h"
 //#include "Manager/BombManager.h"
 #include "Manager/PlayerManager.h"
+#include "System/KeyboardInput.h"
+#include "System/SystemTimer.h"
 //#include "Manager/EnemyManager.h"
 //#include "Manager/Map.h"
 //#include "Manager/PickUpManager.h"
@@ -12,7 +14,10 @@ Relay::Relay()
       m_player_manager(nullptr),
       m_enemy_manager(nullptr),
       m_map(nullptr),
-      m_pickup_manager(nullptr)
+      m_pickup_manager(nullptr),
+      m_keyboard_input(KeyboardInput::Instance()),
+      m_system_timer(SystemTimer::Instance()),
+      m_thread_pool(nullptr)
 {
 }
 
@@ -27,7 +32,10 @@ Relay::Relay(ExplosionManager *explosion_manager,
       m_player_manager(player_manager),
       m_enemy_manager(enemy_manager),
       m_map(map_level),
-      m_pickup_manager(pickup_manager)
+      m_pickup_manager(pickup_manager),
+      m_keyboard_input(KeyboardInput::Instance()),
+      m_system_timer(SystemTimer::Instance()),
+      m_thread_pool(nullptr)
 {
 }
 
@@ -91,6 +99,36 @@ void Relay::SetPickUpManager(PickUpManager* val)
     m_pickup_manager = val;
 }
 
+KeyboardInput* Relay::GetKeyboardInput() const
+{
+    return m_keyboard_input;
+}
+
+void Relay::SetKeyboardInput(KeyboardInput* val)
+{
+    m_keyboard_input = val;
+}
+
+SystemTimer* Relay::GetSystemTimer() const
+{
+    return m_system_timer;
+}
+
+void Relay::SetSystemTimer(SystemTimer* val)
+{
+    m_system_timer = val;
+}
+
+ThreadPool* Relay::GetThreadPool() const
+{
+    return m_thread_pool;
+}
+
+void Relay::SetThreadPool(ThreadPool* val)
+{
+    m_thread_pool = val;
+}
+
 bool Relay::PlayersDead() const
 {
     return m_player_manager->AreAllDead();
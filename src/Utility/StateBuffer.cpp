@@ -0,0 +1,64 @@
+#include "Utility/StateBuffer.h"
+#include <cstring>
+
+StateBuffer::StateBuffer(std::size_t capacity)
+    : m_read(0),
+      m_failed(false)
+{
+    m_data.reserve(capacity);
+}
+
+void StateBuffer::Clear()
+{
+    m_data.clear();
+    m_read = 0;
+    m_failed = false;
+}
+
+void StateBuffer::Rewind()
+{
+    m_read = 0;
+    m_failed = false;
+}
+
+void StateBuffer::Assign(const uint8_t* data, std::size_t size)
+{
+    m_data.assign(data, data + size);
+    Rewind();
+}
+
+void StateBuffer::WriteBytes(const void* data, std::size_t size)
+{
+    if (size == 0)
+        return;
+    std::size_t end = m_data.size();
+    m_data.resize(end + size);
+    memcpy(m_data.data() + end, data, size);
+}
+
+void StateBuffer::ReadBytes(void* data, std::size_t size)
+{
+    if (size == 0)
+        return;
+    if (size > m_data.size() - m_read)
+    {
+        memset(data, 0, size);
+        m_read = m_data.size();
+        m_failed = true;
+        return;
+    }
+    memcpy(data, m_data.data() + m_read, size);
+    m_read += size;
+}
+
+uint32_t StateBuffer::Checksum() const
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (auto byte = m_data.begin(); byte != m_data.end(); ++byte)
+    {
+        hash ^= *byte;
+        hash *= 16777619u;
+    }
+    return hash;
+}
@@ -0,0 +1,83 @@
+#include "Utility/ThreadPool.h"
+
+ThreadPool::ThreadPool(unsigned int threads)
+    : m_job(nullptr),
+      m_count(0),
+      m_next(0),
+      m_busy(0),
+      m_generation(0),
+      m_stop(false)
+{
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+    if (threads == 0)
+        threads = 1;
+    m_workers.reserve(threads - 1);
+    for (unsigned int i = 1; i < threads; ++i)
+        m_workers.emplace_back(&ThreadPool::Work, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_start.notify_all();
+    for (auto worker = m_workers.begin(); worker != m_workers.end(); ++worker)
+        worker->join();
+}
+
+void ThreadPool::Run(unsigned int count, const std::function<void(unsigned int)>& job)
+{
+    if (m_workers.empty() || count <= 1)
+    {
+        for (unsigned int i = 0; i < count; ++i)
+            job(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = &job;
+        m_count = count;
+        m_next = 0;
+        m_busy = m_workers.size();
+        ++m_generation;
+    }
+    m_start.notify_all();
+
+    Take();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this]() { return m_busy == 0; });
+    m_job = nullptr;
+}
+
+void ThreadPool::Work()
+{
+    unsigned long generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_start.wait(lock, [&]() { return m_stop || m_generation != generation; });
+            if (m_stop)
+                return;
+            generation = m_generation;
+        }
+
+        Take();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_busy == 0)
+            m_done.notify_one();
+    }
+}
+
+void ThreadPool::Take()
+{
+    unsigned int i;
+    while ((i = m_next.fetch_add(1)) < m_count)
+        (*m_job)(i);
+}
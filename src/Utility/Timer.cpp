@@ -58,3 +58,17 @@ bool Timer::IsPaused() const
 {
     return m_paused;
 }
+
+void Timer::SaveState(StateBuffer& state) const
+{
+    state.Write(m_past_ticks);
+    state.Write(m_paused_ticks);
+    state.Write(m_paused);
+}
+
+void Timer::LoadState(StateBuffer& state)
+{
+    state.Read(m_past_ticks);
+    state.Read(m_paused_ticks);
+    state.Read(m_paused);
+}
@@ -13,6 +13,10 @@
 #include "includes.h"
 #include "System/KeyboardInput.h"
 #include "Display/DisplayManager.h"
+#include "Simulation/InputRecording.h"
+#include "Network/NetworkOptions.h"
+#include "Network/UdpSocket.h"
+#include <string>
 
 /** \class game
  *  \brief Class which represents the game
@@ -28,8 +32,12 @@ class game
          *  \brief Constructor for game
          *
          *  Makes an instance of the game
+         *  \param replay_path path to an InputRecording to replay instead of
+         *         starting from the menus, empty for a normal game
+         *  \param network game against a peer to play instead of starting
+         *         from the menus, if it is enabled
          */
-        game();
+        game(std::string replay_path = "", const NetworkOptions& network = NetworkOptions());
         /** \brief Calls for initialization and enters the main loop of the game
          *
          *  First method to call. Initializes the game objects and then enters
@@ -52,7 +60,9 @@ class game
          * Loads .bmp files that represents and makes textures. Also loads .txt
          * files and loads up level data. Then it initializes main objects of
          * the game, such as map, player, enemies, manager classes that keep t
-         * track of the game and so on.
+         * track of the game and so on. When replaying, the recording is loaded
+         * and its level is shown instead of the menus until it ends. Same for
+         * the level of a game against a peer, after opening the socket.
          * \return false if there was an error initializing, otherwise true
          *
          */
@@ -69,9 +79,13 @@ class game
         /** \brief Calls update methods on object that need to be updated
          *         periodically
          *
-         * Calls update method individually for each of the game object that
-         * needs to be updated whether they need to act according to user input
-         * or by some timer.
+         * Moves the game time one fixed step forward and calls update method
+         * individually for each of the game object that needs to be updated
+         * whether they need to act according to user input or by some timer.
+         * Called as many times per frame as there are whole steps of wall
+         * time that have passed. The World of a level is stepped on a thread
+         * of its own instead, which runs recordings
+         * SIMULATION_MAX_STEPS_PER_FRAME times as fast, see GameDisplay.
          * \return void
          *
          */
@@ -108,5 +122,10 @@ class game
         unsigned int        window_width;
         unsigned int        window_height;
 
+        std::string         replay_path;
+        InputRecording*     replay; /**< nullptr unless replaying */
+        NetworkOptions      network;
+        UdpSocket*          udp_socket; /**< nullptr unless playing against a peer */
+
 };
 #endif // GAME_H_INCLUDED
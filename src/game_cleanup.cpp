@@ -1,5 +1,9 @@
 #include "game.h"
 
+#ifdef __SWITCH__
+#include <switch.h>
+#endif // __SWITCH__
+
 void game::Cleanup()
 {
     for (int i = 0; i < 2; i++) 
@@ -8,6 +12,12 @@ void game::Cleanup()
         SDL_JoystickClose(joys);
     }
     delete display_manager;
+    delete replay;
+    delete udp_socket;
+    #ifdef __SWITCH__
+    if (network.Enabled())
+        socketExit();
+    #endif // __SWITCH__
     Mix_CloseAudio();
     SDL_DestroyTexture(texture);
     SDL_DestroyRenderer(renderer);
@@ -1,6 +1,7 @@
 #include "game.h"
 #include "SDL2/SDL_image.h"
 #include "Display/DisplayManager.h"
+#include "Display/GameDisplay.h"
 #include "Constants/ResourcesConstants.h"
 
 #ifdef DEBUG_OUTPUT_GAME
@@ -38,7 +39,36 @@ bool game::LoadContent()
 
     /* Game objects initializing - Begin */
 
-    display_manager = new DisplayManager(texture,renderer,&Running,window_width,window_height);
+    // A replay or a game against a peer goes straight to its level and ends
+    // the program with it
+    Display* first = nullptr;
+    if (!replay_path.empty())
+    {
+        replay = new InputRecording();
+        if (!replay->Load(replay_path))
+        {
+            #ifdef DEBUG_OUTPUT_GAME
+            std::cout << "Failed to load recording: " << replay_path << std::endl;
+            #endif // DEBUG_OUTPUT_GAME
+            return false;
+        }
+        first = new GameDisplay(texture,renderer,window_width,window_height,replay);
+    }
+    else if (network.Enabled())
+    {
+        udp_socket = new UdpSocket();
+        if (!udp_socket->Open(network.local_port, network.peer_host, network.peer_port))
+        {
+            #ifdef DEBUG_OUTPUT_GAME
+            std::cout << "Failed to open network port: " << network.local_port << std::endl;
+            #endif // DEBUG_OUTPUT_GAME
+            return false;
+        }
+        udp_socket->SetLatency(network.latency, network.jitter, network.loss, network.seed * 2 + network.local_player);
+        first = new GameDisplay(texture,renderer,window_width,window_height,network,udp_socket);
+    }
+
+    display_manager = new DisplayManager(texture,renderer,&Running,window_width,window_height,first);
 
     /* Game objects initializing - End */
 
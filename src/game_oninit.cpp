@@ -1,5 +1,9 @@
 #include "game.h"
 
+#ifdef __SWITCH__
+#include <switch.h>
+#endif // __SWITCH__
+
 //#define DEBUG_OUTPUT_GAME
 
 #ifdef DEBUG_OUTPUT_GAME
@@ -40,6 +44,11 @@ bool game::OnInit()
 		SDL_Quit();
 		return 1;
 	}
+    #ifdef __SWITCH__
+    if (network.Enabled() && R_FAILED(socketInitializeDefault()))
+        return false;
+    #endif // __SWITCH__
+
     /* SDL Window */
     if((window = SDL_CreateWindow("Bombermaniac!",50,50, window_width, window_height, SDL_WINDOW_SHOWN)) == NULL)
     {
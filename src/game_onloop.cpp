@@ -1,6 +1,8 @@
 #include "game.h"
+#include "System/SystemTimer.h"
 
 void game::OnLoop()
 {
+    SystemTimer::Instance()->Step();
     display_manager->Update();
 }
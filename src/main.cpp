@@ -1,7 +1,13 @@
 #include "game.h"
 #include "Constants/WindowConstants.h"
+#include "Constants/SimulationConstants.h"
+#include "System/FreeTimer.h"
+#include "System/SystemTimer.h"
 
-game::game()
+#include <cstring>
+#include <cstdlib>
+
+game::game(std::string replay_path, const NetworkOptions& network)
     : Running(true),
       window(nullptr),
       renderer(nullptr),
@@ -10,7 +16,11 @@ game::game()
       texture(nullptr),
       display_manager(nullptr),
       window_width(WINDOW_WIDTH),
-      window_height(WINDOW_HEIGHT)
+      window_height(WINDOW_HEIGHT),
+      replay_path(replay_path),
+      replay(nullptr),
+      network(network),
+      udp_socket(nullptr)
 {
 }
 
@@ -26,6 +36,9 @@ int game::OnExecute()
         return -1;
     }
 
+    FreeTimer frame_timer;
+    unsigned long accumulator = 0;
+
     while(Running)
     {
         while(SDL_PollEvent(&Event))
@@ -33,7 +46,20 @@ int game::OnExecute()
             OnEvent(&Event);
         }
 
-        OnLoop();
+        // game time moves in fixed steps, frames only decide how many of them;
+        // a level is stepped on its own thread, see GameDisplay
+        unsigned long frame_time = frame_timer.GetTimeElapsed();
+        frame_timer.DecreaseTimer(frame_time);
+        accumulator += frame_time;
+        if (accumulator > SIMULATION_STEP_LENGTH * SIMULATION_MAX_STEPS_PER_FRAME)
+            accumulator = SIMULATION_STEP_LENGTH * SIMULATION_MAX_STEPS_PER_FRAME;
+
+        while(accumulator >= SIMULATION_STEP_LENGTH)
+        {
+            OnLoop();
+            accumulator -= SIMULATION_STEP_LENGTH;
+        }
+
         OnRender();
     }
 
@@ -44,6 +70,20 @@ int game::OnExecute()
 
 int main(int argc, char* argv[])
 {
+    std::string replay_path;
+    NetworkOptions network;
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--replay"))
+            replay_path = argv[++i];
+        else if (!strcmp(argv[i], "--level"))
+            network.level = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--seed"))
+            network.seed = strtoull(argv[++i], nullptr, 10);
+        else
+            network.ParseArgument(argc, argv, i);
+    }
+
     for (int i = 0; i < 2; i++) {
         if (SDL_JoystickOpen(i) == NULL) 
         {
@@ -55,7 +95,7 @@ int main(int argc, char* argv[])
         }
     } 
     
-    game theGame;
+    game theGame(replay_path, network);
 
     return theGame.OnExecute();
 }
@@ -0,0 +1,254 @@
+/**
+ *  \file AtlasGenerator.cpp
+ *
+ *  Host tool which turns the sprite manifest resources/atlas.txt into the
+ *  constexpr tables of include/Constants/TextureAtlas.h.
+ *
+ *      atlas-generator resources/atlas.txt include/Constants/TextureAtlas.h
+ *
+ *  The header is only written when its content changes, so the game is not
+ *  built again for nothing.
+ */
+
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct Frame
+{
+    int x, y, w, h;
+};
+
+struct Sprite
+{
+    std::string name;
+    unsigned int directions = 0;
+    unsigned int phases = 0;
+    std::vector<Frame> frames; /**< directions * phases frames, direction after direction */
+};
+
+static bool Fail(const char* path, unsigned int line, const char* message)
+{
+    std::fprintf(stderr, "%s:%u: %s\n", path, line, message);
+    return false;
+}
+
+static std::string Upper(const std::string& name)
+{
+    std::string upper = name;
+    for (char& c : upper)
+        c = std::toupper((unsigned char)c);
+    return upper;
+}
+
+static bool ValidName(const std::string& name)
+{
+    if (name.empty() || std::isdigit((unsigned char)name[0]))
+        return false;
+    for (char c : name)
+        if (!std::isalnum((unsigned char)c) && c != '_')
+            return false;
+    return true;
+}
+
+// One line gives the frames of one direction of a sprite
+static bool ReadLine(const char* path, unsigned int number, const std::string& line, std::vector<Sprite>& sprites)
+{
+    std::istringstream in(line);
+    std::string name;
+    int x, y, w, h, step_x, step_y;
+    int phases;
+    if (!(in >> name >> x >> y >> w >> h >> phases >> step_x >> step_y))
+        return Fail(path, number, "expected: name x y w h phases step_x step_y [wrap wrap_x wrap_y]");
+    int wrap = 0, wrap_x = 0, wrap_y = 0;
+    if (in >> wrap && !(in >> wrap_x >> wrap_y))
+        return Fail(path, number, "wrap needs wrap_x and wrap_y");
+    std::string rest;
+    if (in >> rest)
+        return Fail(path, number, "too many values");
+
+    if (!ValidName(name))
+        return Fail(path, number, "sprite names are letters, digits and _");
+    if (w <= 0 || h <= 0 || phases <= 0 || phases > 255 || wrap < 0)
+        return Fail(path, number, "size and phases must be positive");
+
+    if (sprites.empty() || sprites.back().name != name)
+    {
+        for (const Sprite& sprite : sprites)
+            if (sprite.name == name)
+                return Fail(path, number, "lines of a sprite must follow each other");
+        sprites.push_back(Sprite());
+        sprites.back().name = name;
+        sprites.back().phases = phases;
+    }
+
+    Sprite& sprite = sprites.back();
+    if (sprite.phases != (unsigned int)phases)
+        return Fail(path, number, "all directions of a sprite need the same number of phases");
+    if (sprite.directions == 255)
+        return Fail(path, number, "too many directions");
+    sprite.directions++;
+
+    for (int phase = 0; phase < phases; ++phase)
+    {
+        int line_number = wrap ? phase / wrap : 0;
+        int in_line = wrap ? phase % wrap : phase;
+        Frame frame;
+        frame.x = x + in_line * step_x + line_number * wrap_x;
+        frame.y = y + in_line * step_y + line_number * wrap_y;
+        frame.w = w;
+        frame.h = h;
+        if (frame.x < 0 || frame.y < 0)
+            return Fail(path, number, "a phase lies outside of the texture");
+        sprite.frames.push_back(frame);
+    }
+    return true;
+}
+
+static bool ReadManifest(const char* path, std::vector<Sprite>& sprites)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::fprintf(stderr, "Cannot read %s\n", path);
+        return false;
+    }
+
+    std::string line;
+    unsigned int number = 0;
+    while (std::getline(file, line))
+    {
+        ++number;
+        std::string::size_type comment = line.find('#');
+        if (comment != std::string::npos)
+            line.erase(comment);
+        if (line.find_first_not_of(" \t\r") == std::string::npos)
+            continue;
+        if (!ReadLine(path, number, line, sprites))
+            return false;
+    }
+
+    if (sprites.empty())
+    {
+        std::fprintf(stderr, "%s: no sprites\n", path);
+        return false;
+    }
+    return true;
+}
+
+static std::string Header(const char* manifest, const std::vector<Sprite>& sprites)
+{
+    std::ostringstream out;
+    out << "#ifndef TEXTUREATLAS_H_INCLUDED\n"
+           "#define TEXTUREATLAS_H_INCLUDED\n"
+           "\n"
+           "/* Generated by tools/AtlasGenerator.cpp from " << manifest << ",\n"
+           "   edit the manifest and run make -f Makefile.headless atlas */\n"
+           "\n"
+           "#include <SDL2/SDL.h>\n"
+           "\n"
+           "/* Sprites of the game texture */\n"
+           "enum AtlasSprite : unsigned char\n"
+           "{\n";
+    for (unsigned int i = 0; i < sprites.size(); ++i)
+        out << "    ATLAS_" << Upper(sprites[i].name) << " = " << i << ",\n";
+    out << "    ATLAS_SPRITE_COUNT = " << sprites.size() << "\n"
+           "};\n"
+           "\n";
+
+    for (const Sprite& sprite : sprites)
+    {
+        out << "static const unsigned int ATLAS_" << Upper(sprite.name) << "_DIRECTIONS = " << sprite.directions << ";\n"
+            << "static const unsigned int ATLAS_" << Upper(sprite.name) << "_PHASES = " << sprite.phases << ";\n";
+    }
+
+    out << "\n"
+           "/* Where the frames of a sprite start in ATLAS_FRAMES */\n"
+           "struct AtlasSpriteInfo\n"
+           "{\n"
+           "    unsigned short first;\n"
+           "    unsigned char directions;\n"
+           "    unsigned char phases;\n"
+           "};\n"
+           "\n"
+           "static constexpr AtlasSpriteInfo ATLAS_SPRITES[ATLAS_SPRITE_COUNT] =\n"
+           "{\n";
+    unsigned int first = 0;
+    for (const Sprite& sprite : sprites)
+    {
+        out << "    {" << first << ", " << sprite.directions << ", " << sprite.phases << "}, // "
+            << sprite.name << "\n";
+        first += sprite.frames.size();
+    }
+    out << "};\n"
+           "\n"
+           "/* Source rectangles of all frames, phases of a direction follow each other */\n"
+           "static constexpr SDL_Rect ATLAS_FRAMES[" << first << "] =\n"
+           "{\n";
+    for (const Sprite& sprite : sprites)
+    {
+        out << "    // " << sprite.name << "\n";
+        for (unsigned int d = 0; d < sprite.directions; ++d)
+        {
+            out << "   ";
+            for (unsigned int p = 0; p < sprite.phases; ++p)
+            {
+                const Frame& frame = sprite.frames[d*sprite.phases + p];
+                if (p && p % 6 == 0)
+                    out << "\n   ";
+                out << " {" << frame.x << ", " << frame.y << ", " << frame.w << ", " << frame.h << "},";
+            }
+            out << "\n";
+        }
+    }
+    out << "};\n"
+           "\n"
+           "/**\n"
+           " *  \\brief Gives the source rectangle of a frame of a sprite.\n"
+           " *\n"
+           " *  \\param sprite sprite from the manifest\n"
+           " *  \\param direction direction of the sprite, below its _DIRECTIONS\n"
+           " *  \\param phase animation phase, below its _PHASES\n"
+           " *  \\return the rectangle in the game texture\n"
+           " */\n"
+           "static constexpr const SDL_Rect& AtlasFrame(AtlasSprite sprite, unsigned int direction, unsigned int phase)\n"
+           "{\n"
+           "    return ATLAS_FRAMES[ATLAS_SPRITES[sprite].first + direction*ATLAS_SPRITES[sprite].phases + phase];\n"
+           "}\n"
+           "\n"
+           "#endif // TEXTUREATLAS_H_INCLUDED\n";
+    return out.str();
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        std::fprintf(stderr, "usage: %s MANIFEST HEADER\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<Sprite> sprites;
+    if (!ReadManifest(argv[1], sprites))
+        return 1;
+    std::string header = Header(argv[1], sprites);
+
+    std::ifstream old(argv[2], std::ios::binary);
+    std::ostringstream old_header;
+    old_header << old.rdbuf();
+    if (old && old_header.str() == header)
+        return 0;
+
+    std::ofstream file(argv[2], std::ios::binary);
+    file << header;
+    if (!file)
+    {
+        std::fprintf(stderr, "Cannot write %s\n", argv[2]);
+        return 1;
+    }
+    std::printf("%s: %u sprites\n", argv[2], (unsigned int)sprites.size());
+    return 0;
+}